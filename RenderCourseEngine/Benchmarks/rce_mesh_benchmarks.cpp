@@ -0,0 +1,73 @@
+#include "Benchmark.hpp"
+
+#include "rce_mesh.h"
+
+#include <algorithm>
+#include <stdio.h>
+#include <thread>
+#include <vector>
+
+using namespace RCE::Mesh;
+using SBL::Benchmark::DoNotOptimize;
+using SBL::Benchmark::Measure;
+using SBL::Benchmark::ReportSpeedup;
+
+// The 8 to 512 segment sphere chain main.cpp builds at startup. ns per vertex is also ms per million vertices.
+SBL_BENCHMARK(MeshLodChain) {
+	std::vector<MeshData> lods;
+	GenerateLodChain(Primitive::Sphere, 8, 512, &lods, 1);
+	size_t vertexCount = 0;
+	for (const MeshData& lod : lods) {
+		vertexCount += lod.vertices.size();
+	}
+
+	const unsigned hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+	printf("  %zu levels, %zu vertices, %u hardware threads\n", lods.size(), vertexCount, hardwareThreads);
+
+	const SBL::Benchmark::Result serial = Measure("GenerateLodChain, 1 thread", vertexCount, [&] {
+		GenerateLodChain(Primitive::Sphere, 8, 512, &lods, 1);
+		DoNotOptimize(lods);
+	});
+	// Thread counts past the hardware count are still run, they show the cost of oversubscription
+	for (int threads : { 2, 4, 8 }) {
+		char name[64];
+		snprintf(name, sizeof(name), "GenerateLodChain, %d threads", threads);
+		ReportSpeedup(serial, Measure(name, vertexCount, [&] {
+			GenerateLodChain(Primitive::Sphere, 8, 512, &lods, threads);
+			DoNotOptimize(lods);
+		}));
+	}
+}
+
+// Packing the 512 segment sphere, the one-at-a-time functions against the four-wide batches
+SBL_BENCHMARK(MeshVertexPacking) {
+	using namespace RCE::VertexFormat;
+
+	std::vector<MeshData> lods;
+	GenerateLodChain(Primitive::Sphere, 512, 512, &lods, 1);
+	const std::vector<Vertex>& vertices = lods.back().vertices;
+	std::vector<PackedVertex> packed(vertices.size());
+	std::vector<Vertex> decoded(vertices.size());
+
+	const SBL::Benchmark::Result encode = Measure("EncodeVertex", vertices.size(), [&] {
+		for (size_t i = 0; i < vertices.size(); i++) {
+			packed[i] = EncodeVertex(vertices[i]);
+		}
+		DoNotOptimize(packed);
+	});
+	ReportSpeedup(encode, Measure("EncodeVertices", vertices.size(), [&] {
+		EncodeVertices(vertices.data(), vertices.size(), packed.data());
+		DoNotOptimize(packed);
+	}));
+
+	const SBL::Benchmark::Result decode = Measure("DecodeVertex", vertices.size(), [&] {
+		for (size_t i = 0; i < packed.size(); i++) {
+			decoded[i] = DecodeVertex(packed[i]);
+		}
+		DoNotOptimize(decoded);
+	});
+	ReportSpeedup(decode, Measure("DecodeVertices", vertices.size(), [&] {
+		DecodeVertices(packed.data(), packed.size(), decoded.data());
+		DoNotOptimize(decoded);
+	}));
+}
@@ -0,0 +1,127 @@
+#include "Benchmark.hpp"
+
+#include "rce_block_compress.h"
+#include "rce_mip.h"
+#include "stb/stb_image.h"
+
+#include <algorithm>
+#include <stdio.h>
+#include <thread>
+#include <vector>
+
+using namespace RCE;
+using SBL::Benchmark::DoNotOptimize;
+using SBL::Benchmark::Measure;
+using SBL::Benchmark::ReportSpeedup;
+
+namespace {
+	struct Image {
+		int width = 0;
+		int height = 0;
+		std::vector<uint8_t> rgba;
+	};
+
+	// One of the textures main.cpp loads, decoded to RGBA8. Falls back to a generated image when the assets are missing
+	// so the benchmark still runs.
+	Image LoadAsset(const char* name) {
+		Image image;
+		char path[512];
+		snprintf(path, sizeof(path), "%s/%s", RCE_ASSET_DIR, name);
+		int channels;
+		if (uint8_t* data = stbi_load(path, &image.width, &image.height, &channels, 4)) {
+			image.rgba.assign(data, data + (size_t)image.width * image.height * 4);
+			stbi_image_free(data);
+			return image;
+		}
+
+		printf("  %s not found, using a generated 1024x512 image\n", path);
+		image.width = 1024;
+		image.height = 512;
+		image.rgba.resize((size_t)image.width * image.height * 4);
+		uint32_t state = 2463534242u;
+		for (size_t i = 0; i < image.rgba.size(); i++) {
+			state ^= state << 13;
+			state ^= state >> 17;
+			state ^= state << 5;
+			image.rgba[i] = (uint8_t)(((i / 4 % image.width) + (state & 63)) & 255);
+		}
+		return image;
+	}
+}
+
+// The per-texture mip timing main.cpp used to print while loading. ns per pixel is per top level pixel.
+SBL_BENCHMARK(TextureMips) {
+	const Image image = LoadAsset("earthmap1k.jpg");
+	const size_t pixelCount = (size_t)image.width * image.height;
+	printf("  %dx%d, %d levels\n", image.width, image.height, Mip::MipLevelCount(image.width, image.height));
+
+	Mip::MipChain mips;
+	const Mip::Settings boxLinear = { Mip::Filter::Box, Mip::ColorSpace::Linear, true, false };
+	const SBL::Benchmark::Result box = Measure("GenerateMips, box, linear", pixelCount, [&] {
+		Mip::GenerateMips(image.rgba.data(), image.width, image.height, boxLinear, &mips);
+		DoNotOptimize(mips);
+	});
+
+	// The settings main.cpp cooks with: Kaiser in both color spaces, wrapping horizontally
+	const Mip::Settings kaiserLinear = { Mip::Filter::Kaiser, Mip::ColorSpace::Linear, true, false };
+	ReportSpeedup(box, Measure("GenerateMips, Kaiser, linear", pixelCount, [&] {
+		Mip::GenerateMips(image.rgba.data(), image.width, image.height, kaiserLinear, &mips);
+		DoNotOptimize(mips);
+	}));
+	const Mip::Settings kaiserSrgb = { Mip::Filter::Kaiser, Mip::ColorSpace::SRGB, true, false };
+	ReportSpeedup(box, Measure("GenerateMips, Kaiser, sRGB", pixelCount, [&] {
+		Mip::GenerateMips(image.rgba.data(), image.width, image.height, kaiserSrgb, &mips);
+		DoNotOptimize(mips);
+	}));
+}
+
+// The per-texture compression timing main.cpp used to print while cooking, for every format on the mip chain of the
+// texture that role is used for. ns per pixel counts every level.
+SBL_BENCHMARK(TextureBlockCompress) {
+	struct FormatCase {
+		const char* asset;
+		BlockCompress::BlockFormat format;
+	};
+	const FormatCase cases[] = {
+		{ "earthmap1k.jpg", BlockCompress::BlockFormat::BC1 },
+		{ "earthmap1k.jpg", BlockCompress::BlockFormat::BC7 },
+		{ "earthcloudmaptrans.jpg", BlockCompress::BlockFormat::BC3 },
+		{ "earthbump1k.jpg", BlockCompress::BlockFormat::BC4 },
+		{ "earthbump1k.jpg", BlockCompress::BlockFormat::BC5 },
+	};
+	const int hardwareThreads = (int)std::max(1u, std::thread::hardware_concurrency());
+	printf("  %d hardware threads\n", hardwareThreads);
+
+	for (const FormatCase& formatCase : cases) {
+		const Image image = LoadAsset(formatCase.asset);
+		const Mip::Settings settings = { Mip::Filter::Kaiser, Mip::ColorSpace::Linear, true, false };
+		Mip::MipChain mips;
+		Mip::GenerateMips(image.rgba.data(), image.width, image.height, settings, &mips);
+		const size_t pixelCount = mips.pixels.size() / 4;
+
+		BlockCompress::CompressedMips blocks;
+		BlockCompress::CompressMips(mips, formatCase.format, &blocks, 1);
+		std::vector<uint8_t> decoded((size_t)image.width * image.height * 4);
+		BlockCompress::DecompressImage(blocks.blocks.data(), image.width, image.height, formatCase.format, decoded.data());
+		printf("  %s %s: PSNR %.2f dB, %zu KB -> %zu KB\n", formatCase.asset, BlockCompress::FormatName(formatCase.format),
+			BlockCompress::PeakSignalToNoise(mips.pixels.data(), decoded.data(), (size_t)image.width * image.height,
+				BlockCompress::ChannelCount(formatCase.format)), mips.pixels.size() / 1024, blocks.blocks.size() / 1024);
+
+		// Results keep the name pointer, so each kernel gets its own buffer
+		char serialName[64];
+		char threadedName[64];
+		snprintf(serialName, sizeof(serialName), "CompressMips, %s, 1 thread", BlockCompress::FormatName(formatCase.format));
+		const SBL::Benchmark::Result serial = Measure(serialName, pixelCount, [&] {
+			BlockCompress::CompressMips(mips, formatCase.format, &blocks, 1);
+			DoNotOptimize(blocks);
+		});
+		if (hardwareThreads > 1) {
+			snprintf(threadedName, sizeof(threadedName), "CompressMips, %s, %d threads",
+				BlockCompress::FormatName(formatCase.format), hardwareThreads);
+			ReportSpeedup(serial, Measure(threadedName, pixelCount, [&] {
+				BlockCompress::CompressMips(mips, formatCase.format, &blocks, hardwareThreads);
+				DoNotOptimize(blocks);
+			}));
+		}
+	}
+}
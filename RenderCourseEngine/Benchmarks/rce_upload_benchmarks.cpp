@@ -0,0 +1,143 @@
+#include "Benchmark.hpp"
+
+#include "rce_upload_copy.h"
+#include "rce_upload_ring.h"
+
+#include <algorithm>
+#include <stdio.h>
+#include <thread>
+#include <vector>
+
+using namespace RCE;
+using SBL::Benchmark::DoNotOptimize;
+using SBL::Benchmark::Measure;
+using SBL::Benchmark::ReportSpeedup;
+
+namespace {
+	// D3D12_TEXTURE_DATA_PITCH_ALIGNMENT and D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT
+	constexpr uint64_t PITCH_ALIGNMENT = 256;
+	constexpr uint64_t PLACEMENT_ALIGNMENT = 512;
+
+	uint64_t AlignUp(uint64_t value, uint64_t alignment) {
+		return (value + alignment - 1) / alignment * alignment;
+	}
+
+	// A tightly packed mip chain and the copies into its GetCopyableFootprints layout. blockPixels is 4 for block
+	// compressed formats, blockBytes the bytes per block or pixel.
+	struct UploadCase {
+		std::vector<uint8_t> source;
+		std::vector<Upload::SubresourceCopy> copies;
+		uint64_t uploadSize = 0;
+	};
+
+	UploadCase MakeUploadCase(int width, int height, int blockPixels, int blockBytes) {
+		UploadCase upload;
+		std::vector<uint64_t> sourceOffsets;
+		for (int w = width, h = height;; w = std::max(w / 2, 1), h = std::max(h / 2, 1)) {
+			Upload::SubresourceCopy copy = {};
+			copy.rowBytes = (uint64_t)(w + blockPixels - 1) / blockPixels * blockBytes;
+			copy.rowCount = (uint32_t)((h + blockPixels - 1) / blockPixels);
+			copy.depth = 1;
+			copy.sourceRowPitch = copy.rowBytes;
+			copy.sourceSlicePitch = copy.rowBytes * copy.rowCount;
+			copy.destRowPitch = AlignUp(copy.rowBytes, PITCH_ALIGNMENT);
+			copy.destOffset = AlignUp(upload.uploadSize, PLACEMENT_ALIGNMENT);
+			upload.uploadSize = copy.destOffset + copy.destRowPitch * copy.rowCount;
+			sourceOffsets.push_back(upload.source.size());
+			upload.source.resize(upload.source.size() + copy.sourceSlicePitch);
+			upload.copies.push_back(copy);
+			if (w == 1 && h == 1) {
+				break;
+			}
+		}
+		for (size_t i = 0; i < upload.source.size(); i++) {
+			upload.source[i] = (uint8_t)(i * 31 + (i >> 8));
+		}
+		for (size_t i = 0; i < upload.copies.size(); i++) {
+			upload.copies[i].source = upload.source.data() + sourceOffsets[i];
+		}
+		return upload;
+	}
+
+	void MeasureUpload(const char* label, const UploadCase& upload) {
+		std::vector<uint8_t> dest(upload.uploadSize + 64);
+		uint8_t* aligned = dest.data() + ((64 - ((uintptr_t)dest.data() & 63)) & 63);
+		printf("  %s: %zu KB source, %llu KB footprints, %zu subresources\n", label, upload.source.size() / 1024,
+			(unsigned long long)(upload.uploadSize / 1024), upload.copies.size());
+
+		// Results keep the name pointer, so each kernel gets its own buffer
+		char memcpyName[80];
+		char streamingName[80];
+		snprintf(memcpyName, sizeof(memcpyName), "CopySubresources, %s, memcpy", label);
+		snprintf(streamingName, sizeof(streamingName), "CopySubresources, %s, streaming", label);
+		const size_t kilobytes = upload.source.size() / 1024;
+		const SBL::Benchmark::Result memcpyResult = Measure(memcpyName, kilobytes, [&] {
+			Upload::CopySubresources(aligned, upload.copies.data(), upload.copies.size(), false);
+			DoNotOptimize(aligned[0]);
+		});
+		ReportSpeedup(memcpyResult, Measure(streamingName, kilobytes, [&] {
+			Upload::CopySubresources(aligned, upload.copies.data(), upload.copies.size(), true);
+			DoNotOptimize(aligned[0]);
+		}));
+	}
+}
+
+// The per-texture upload copy main.cpp reports with -frames or -measure-overlap, in ns per source KB. The destination
+// is ordinary cached memory here, not a write-combined upload heap, so this understates what streaming stores save on
+// the real staging buffer; it still shows what they cost when the source is cold and the destination is not read back.
+SBL_BENCHMARK(UploadCopy) {
+	// What main.cpp uploads for a 1k earth map: BC7 with row padding, and the same chain uncompressed
+	MeasureUpload("1000x500 BC7", MakeUploadCase(1000, 500, 4, 16));
+	MeasureUpload("1000x500 RGBA8", MakeUploadCase(1000, 500, 1, 4));
+	// Larger than the last level cache
+	MeasureUpload("4096x2048 RGBA8", MakeUploadCase(4096, 2048, 1, 4));
+}
+
+// Allocate, FinishSubmission and Retire on one thread, the way main.cpp stages a texture per submission, and then the
+// same allocations from several threads at once against the one lock. ns per allocation.
+SBL_BENCHMARK(UploadRing) {
+	static constexpr int ALLOCATIONS_PER_THREAD = 16384;
+	static constexpr uint64_t ALLOCATION_SIZE = 256;
+	const unsigned hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+	printf("  %u hardware threads\n", hardwareThreads);
+
+	Upload::UploadRing ring;
+	Upload::InitUploadRing(&ring, 1 << 20);
+	uint64_t fenceValue = 0;
+	Measure("Allocate + FinishSubmission + Retire", ALLOCATIONS_PER_THREAD, [&] {
+		for (int i = 0; i < ALLOCATIONS_PER_THREAD; i++) {
+			DoNotOptimize(Upload::Allocate(&ring, ALLOCATION_SIZE, 256));
+			Upload::FinishSubmission(&ring, ++fenceValue);
+			// The GPU runs a couple of submissions behind
+			Upload::Retire(&ring, fenceValue - std::min<uint64_t>(fenceValue, 2));
+		}
+	});
+
+	// Only offsets are handed out, so the ring can be as large as every allocation of a run needs without any memory
+	// behind it. Thread start up is included, it is small next to the allocations of a run. Below 1x the threads spend
+	// more time on the lock than they gain.
+	auto allocateOnThreads = [&](int threads) {
+		Upload::InitUploadRing(&ring, (uint64_t)threads * ALLOCATIONS_PER_THREAD * ALLOCATION_SIZE);
+		std::vector<std::thread> workers;
+		for (int t = 0; t < threads; t++) {
+			workers.emplace_back([&ring] {
+				for (int i = 0; i < ALLOCATIONS_PER_THREAD; i++) {
+					DoNotOptimize(Upload::Allocate(&ring, ALLOCATION_SIZE, 256));
+				}
+			});
+		}
+		for (std::thread& worker : workers) {
+			worker.join();
+		}
+	};
+	const SBL::Benchmark::Result single = Measure("Allocate, 1 thread", ALLOCATIONS_PER_THREAD, [&] {
+		allocateOnThreads(1);
+	});
+	for (int threads : { 2, 4, 8 }) {
+		char name[64];
+		snprintf(name, sizeof(name), "Allocate, %d threads contending", threads);
+		ReportSpeedup(single, Measure(name, (size_t)threads * ALLOCATIONS_PER_THREAD, [&] {
+			allocateOnThreads(threads);
+		}));
+	}
+}
@@ -6,28 +6,27 @@ namespace SBL
 {
 namespace Math
 {
-inline bool Equals(float32 lhs, float32 rhs)
+constexpr bool Equals(float32 lhs, float32 rhs)
 {
 	return IsZero(rhs - lhs);
 }
 
-inline int32 Abs(int32 value)
+constexpr int32 Abs(int32 value)
 {
 	return value < 0 ? -value : value;
 }
 
-inline float32 Abs(float32 value)
+constexpr float32 Abs(float32 value)
 {
-	using namespace std;
-	return fabsf(value);
+	return value < 0.0f ? -value : value;
 }
 
-inline bool IsZero(float32 value)
+constexpr bool IsZero(float32 value)
 {
 	return Abs(value) < float32_epsilon;
 }
 
-inline float32 MakeZero(float32 value)
+constexpr float32 MakeZero(float32 value)
 {
 	return IsZero(value) ? 0.0f : value;
 }
@@ -49,17 +48,17 @@ inline float32 Frac(float32 val)
 	return Abs(val - Floor(val));
 }
 
-inline float32 Lerp(float32 valA, float32 valB, float32 t)
+constexpr float32 Lerp(float32 valA, float32 valB, float32 t)
 {
 	return valA + ((valB - valA) * t);
 }
 
-inline Radians DegreesToRadians(Degrees degrees)
+constexpr Radians DegreesToRadians(Degrees degrees)
 {
 	return static_cast<Radians>(degrees * DegreesToRadiansValue);
 }
 
-inline Degrees RadiansToDegrees(Radians radians)
+constexpr Degrees RadiansToDegrees(Radians radians)
 {
 	return static_cast<Degrees>(radians * RadiansToDegreesValue);
 }
@@ -90,8 +89,12 @@ inline Radians ArcSin(float32 val)
 
 inline Radians ArcCos(float32 val)
 {
+#ifdef SBL_MATH_FAST_MATH
+	return MakeZero(FastArcCos(val));
+#else
 	using namespace std;
 	return static_cast<Radians>(MakeZero(acos(val)));
+#endif
 }
 
 inline Radians ArcTan(float32 val)
@@ -106,6 +109,83 @@ inline Radians ArcTan(float32 x, float32 y)
 	return static_cast<Radians>(MakeZero(atan2(y, x)));
 }
 
+inline Radians WrapAngle(Radians radians)
+{
+	// 2 PI is split in two parts so the wrap stays exact for the first few
+	// thousand turns.
+	const float32 turns = radians * (0.5f / PI);
+	const float32 wraps = static_cast<float32>(
+		static_cast<int32>(turns + (turns < 0.0f ? -0.5f : 0.5f)));
+	return (radians - wraps * 6.28125f) - wraps * 0.0019353071795864769f;
+}
+
+namespace Detail
+{
+// Odd minimax polynomial for sin, fitted on [-PI / 2, PI / 2].
+inline float32 SinPolynomial(float32 x)
+{
+	const float32 x2 = x * x;
+	return x * (1.0f +
+				x2 * (-0.16666667f +
+					  x2 * (0.0083333310f +
+							x2 * (-0.00019840874f +
+								  x2 * (2.7525562e-6f - x2 * 2.3889859e-8f)))));
+}
+}
+
+inline float32 FastSin(Radians radians)
+{
+	// Fold [-PI, PI] onto [-PI / 2, PI / 2] with sin(x) = sin(+-PI - x).
+	// Written as selects rather than branches: on unsorted angles the
+	// branches mispredict often enough to lose to libm.
+	const float32 x = WrapAngle(radians);
+	const float32 halfTurn = x < 0.0f ? -PI : PI;
+	return Detail::SinPolynomial(Abs(x) > 0.5f * PI ? halfTurn - x : x);
+}
+
+inline float32 FastCos(Radians radians)
+{
+	// cos(x) = sin(PI / 2 - |x|), which already lies in [-PI / 2, PI / 2].
+	return Detail::SinPolynomial(0.5f * PI - Abs(WrapAngle(radians)));
+}
+
+inline Radians FastArcCos(float32 val)
+{
+	// acos(x) ~= sqrt(1 - x) * (a0 + a1 x + a2 x^2 + a3 x^3) for x in [0, 1],
+	// mirrored for negative inputs with acos(-x) = PI - acos(x).
+	const float32 x = Abs(val);
+	const float32 poly =
+		1.5707288f + x * (-0.2121144f + x * (0.0742610f - x * 0.0187293f));
+	const float32 result = std::sqrt(1.0f - x) * poly;
+	return static_cast<Radians>(val < 0.0f ? PI - result : result);
+}
+
+inline float32 FastInverseSqrt(float32 val)
+{
+#if SBL_MATH_SIMD_SSE
+	const __m128 v = _mm_set_ss(val);
+	const __m128 estimate = _mm_rsqrt_ss(v);
+	// estimate * (1.5 - 0.5 * val * estimate^2)
+	const __m128 refined = _mm_mul_ss(
+		estimate,
+		_mm_sub_ss(_mm_set_ss(1.5f),
+				   _mm_mul_ss(_mm_mul_ss(_mm_set_ss(0.5f), v),
+							  _mm_mul_ss(estimate, estimate))));
+	return _mm_cvtss_f32(refined);
+#else
+	// Bit-level initial guess followed by two Newton steps.
+	std::uint32_t bits;
+	std::memcpy(&bits, &val, sizeof(bits));
+	bits = 0x5f375a86u - (bits >> 1);
+	float32 estimate;
+	std::memcpy(&estimate, &bits, sizeof(estimate));
+	const float32 half = 0.5f * val;
+	estimate = estimate * (1.5f - half * estimate * estimate);
+	estimate = estimate * (1.5f - half * estimate * estimate);
+	return estimate;
+#endif
+}
+
 inline float32 Pow(float32 val, float32 exponent)
 {
 	using namespace std;
@@ -118,6 +198,15 @@ inline float32 Exp(float32 val)
 	return expf(val);
 }
 
+constexpr bool IsConstantEvaluated()
+{
+#if defined(__GNUC__) || defined(__clang__) || (defined(_MSC_VER) && _MSC_VER >= 1925)
+	return __builtin_is_constant_evaluated();
+#else
+	return false;
+#endif
+}
+
 constexpr float32 Pow2(float32 val)
 {
 	return val * val;
@@ -18,7 +18,7 @@ struct Matrix22
 	Matrix22(Matrix22&& rhs) = default;
 	Matrix22& operator=(const Matrix22& rhs) = default;
 	Matrix22& operator=(Matrix22&& rhs) = default;
-	inline Matrix22(float32 _00, float32 _01, float32 _10, float32 _11);
+	constexpr Matrix22(float32 _00, float32 _01, float32 _10, float32 _11);
 
 	union {
 		struct
@@ -40,23 +40,23 @@ struct Matrix22
 	static const Matrix22 Identity;
 	static const Matrix22 Zero;
 
-	static inline Matrix22 Translation(const Vector2& translation);
-	static inline Matrix22 Scale(const Vector2& scale);
+	static constexpr Matrix22 Translation(const Vector2& translation);
+	static constexpr Matrix22 Scale(const Vector2& scale);
 	static inline Matrix22 Rotation(Radians rotation);
 };
 
-inline bool operator==(const Matrix22& lhs, const Matrix22& rhs);
-inline bool operator!=(const Matrix22& lhs, const Matrix22& rhs);
+constexpr bool operator==(const Matrix22& lhs, const Matrix22& rhs);
+constexpr bool operator!=(const Matrix22& lhs, const Matrix22& rhs);
 
-inline Matrix22 operator*(const Matrix22& lhs, const Matrix22& rhs);
-inline Vector2 operator*(const Matrix22& lhs, const Vector2& rhs);
-inline Vector2 operator*(const Matrix22& lhs, const Vector2& rhs);
+constexpr Matrix22 operator*(const Matrix22& lhs, const Matrix22& rhs);
+constexpr Vector2 operator*(const Matrix22& lhs, const Vector2& rhs);
+constexpr Vector2 operator*(const Matrix22& lhs, const Vector2& rhs);
 
-inline float32 SignOfElement(const Matrix22& mat, std::size_t column,
-							 std::size_t row);
+constexpr float32 SignOfElement(const Matrix22& mat, std::size_t column,
+								std::size_t row);
 inline float32 CofactorOfElement(const Matrix22& mat, std::size_t column,
 								 std::size_t row);
-inline float32 Determinant(const Matrix22& mat);
+constexpr float32 Determinant(const Matrix22& mat);
 }
 }
 
@@ -6,11 +6,14 @@ namespace SBL
 {
 namespace Math
 {
-inline Matrix22::Matrix22(float32 _00, float32 _01, float32 _10, float32 _11)
+constexpr Matrix22::Matrix22(float32 _00, float32 _01, float32 _10, float32 _11)
 	: m00(_00), m01(_01), m10(_10), m11(_11)
 {
 }
 
+inline constexpr Matrix22 Matrix22::Identity{1.0f, 0.0f, 0.0f, 1.0f};
+inline constexpr Matrix22 Matrix22::Zero{0.0f, 0.0f, 0.0f, 0.0f};
+
 inline Vector2& Matrix22::operator[](std::size_t rowIndex)
 {
 	return rows[rowIndex];
@@ -31,33 +34,34 @@ inline Vector2 Matrix22::Row(std::size_t rowIndex) const
 	return rows[rowIndex];
 }
 
-inline bool operator==(const Matrix22& lhs, const Matrix22& rhs)
+constexpr bool operator==(const Matrix22& lhs, const Matrix22& rhs)
 {
 	return Equals(lhs.m00, rhs.m00) && Equals(lhs.m01, rhs.m01) &&
 		   Equals(lhs.m10, rhs.m10) && Equals(lhs.m11, rhs.m11);
 }
 
-inline bool operator!=(const Matrix22& lhs, const Matrix22& rhs)
+constexpr bool operator!=(const Matrix22& lhs, const Matrix22& rhs)
 {
 	return !(lhs == rhs);
 }
 
-inline Matrix22 operator*(const Matrix22& lhs, const Matrix22& rhs)
+constexpr Matrix22 operator*(const Matrix22& lhs, const Matrix22& rhs)
 {
 	return Matrix22{
-		DotProduct(lhs.Row(0), rhs.Column(0)),
-		DotProduct(lhs.Row(0), rhs.Column(1)),
-		DotProduct(lhs.Row(1), rhs.Column(0)),
-		DotProduct(lhs.Row(1), rhs.Column(1)),
+		lhs.m00 * rhs.m00 + lhs.m01 * rhs.m10,
+		lhs.m00 * rhs.m01 + lhs.m01 * rhs.m11,
+		lhs.m10 * rhs.m00 + lhs.m11 * rhs.m10,
+		lhs.m10 * rhs.m01 + lhs.m11 * rhs.m11,
 	};
 }
 
-inline Vector2 operator*(const Matrix22& lhs, const Vector2& rhs)
+constexpr Vector2 operator*(const Matrix22& lhs, const Vector2& rhs)
 {
-	return Vector2{DotProduct(lhs.Row(0), rhs), DotProduct(lhs.Row(1), rhs)};
+	return Vector2{lhs.m00 * rhs.x + lhs.m01 * rhs.y,
+				   lhs.m10 * rhs.x + lhs.m11 * rhs.y};
 }
 
-inline float32 Determinant(const Matrix22& mat)
+constexpr float32 Determinant(const Matrix22& mat)
 {
 	return (mat.m00 * mat.m11) - (mat.m01 * mat.m10);
 }
@@ -6,14 +6,21 @@ namespace SBL
 {
 namespace Math
 {
-inline Matrix33::Matrix33(float32 _00, float32 _01, float32 _02, float32 _10,
-						  float32 _11, float32 _12, float32 _20, float32 _21,
-						  float32 _22)
+constexpr Matrix33::Matrix33(float32 _00, float32 _01, float32 _02, float32 _10,
+							 float32 _11, float32 _12, float32 _20, float32 _21,
+							 float32 _22)
 	: m00(_00), m01(_01), m02(_02), m10(_10), m11(_11), m12(_12), m20(_20),
 	  m21(_21), m22(_22)
 {
 }
 
+inline constexpr Matrix33 Matrix33::Identity{
+	1.0f, 0.0f, 0.0f,
+	0.0f, 1.0f, 0.0f,
+	0.0f, 0.0f, 1.0f};
+inline constexpr Matrix33 Matrix33::Zero{0.0f, 0.0f, 0.0f, 0.0f, 0.0f,
+										 0.0f, 0.0f, 0.0f, 0.0f};
+
 inline Vector3& Matrix33::operator[](std::size_t columnIndex)
 {
 	return rows[columnIndex];
@@ -35,7 +42,7 @@ inline Vector3 Matrix33::Row(std::size_t rowIndex) const
 	return rows[rowIndex];
 }
 
-Matrix33 Matrix33::Translation(const Vector2& translation)
+constexpr Matrix33 Matrix33::Translation(const Vector2& translation)
 {
 	return Matrix33(
 		1, 0, translation.x,
@@ -44,7 +51,7 @@ Matrix33 Matrix33::Translation(const Vector2& translation)
 	);
 }
 
-Matrix33 Matrix33::Scale(const Vector2& scale)
+constexpr Matrix33 Matrix33::Scale(const Vector2& scale)
 {
 	return Matrix33(
 		scale.x, 0, 0,
@@ -52,7 +59,7 @@ Matrix33 Matrix33::Scale(const Vector2& scale)
 		0, 0, 1);
 }
 
-Matrix33 Matrix33::Rotation(Radians rotation)
+inline Matrix33 Matrix33::Rotation(Radians rotation)
 {
 	// Assuming rotation around z-axis
 	return Matrix33(
@@ -90,7 +97,7 @@ inline Matrix33 Matrix33::Rotation(const Vector3& forward, const Vector3& up)
 	return Rotation(CrossProduct(forward, up), up, forward);
 }
 
-inline bool operator==(const Matrix33& lhs, const Matrix33& rhs)
+constexpr bool operator==(const Matrix33& lhs, const Matrix33& rhs)
 {
 	return Equals(lhs.m00, rhs.m00) && Equals(lhs.m01, rhs.m01) &&
 		   Equals(lhs.m02, rhs.m02) && Equals(lhs.m10, rhs.m10) &&
@@ -99,12 +106,12 @@ inline bool operator==(const Matrix33& lhs, const Matrix33& rhs)
 		   Equals(lhs.m22, rhs.m22);
 }
 
-inline bool operator!=(const Matrix33& lhs, const Matrix33& rhs)
+constexpr bool operator!=(const Matrix33& lhs, const Matrix33& rhs)
 {
 	return !(lhs == rhs);
 }
 
-inline Matrix33 operator+(const Matrix33& lhs, float32 rhs)
+constexpr Matrix33 operator+(const Matrix33& lhs, float32 rhs)
 {
 	return Matrix33{
 		lhs.m00 + rhs, lhs.m01 + rhs, lhs.m02 + rhs,
@@ -113,7 +120,7 @@ inline Matrix33 operator+(const Matrix33& lhs, float32 rhs)
 	};
 }
 
-inline Matrix33 operator-(const Matrix33& lhs, float32 rhs)
+constexpr Matrix33 operator-(const Matrix33& lhs, float32 rhs)
 {
 	return Matrix33{
 		lhs.m00 - rhs, lhs.m01 - rhs, lhs.m02 - rhs,
@@ -122,7 +129,7 @@ inline Matrix33 operator-(const Matrix33& lhs, float32 rhs)
 	};
 }
 
-inline Matrix33 operator*(const Matrix33& lhs, float32 rhs)
+constexpr Matrix33 operator*(const Matrix33& lhs, float32 rhs)
 {
 	return Matrix33{
 		lhs.m00 * rhs, lhs.m01 * rhs, lhs.m02 * rhs,
@@ -131,7 +138,7 @@ inline Matrix33 operator*(const Matrix33& lhs, float32 rhs)
 	};
 }
 
-inline Matrix33 operator/(const Matrix33& lhs, float32 rhs)
+constexpr Matrix33 operator/(const Matrix33& lhs, float32 rhs)
 {
 	return Matrix33{
 		lhs.m00 / rhs, lhs.m01 / rhs, lhs.m02 / rhs,
@@ -140,20 +147,22 @@ inline Matrix33 operator/(const Matrix33& lhs, float32 rhs)
 	};
 }
 
-inline Matrix33 operator*(const Matrix33& lhs, const Matrix33& rhs)
+constexpr Matrix33 operator*(const Matrix33& lhs, const Matrix33& rhs)
 {
-	return Matrix33{DotProduct(lhs.Row(0), rhs.Column(0)),
-					DotProduct(lhs.Row(0), rhs.Column(1)),
-					DotProduct(lhs.Row(0), rhs.Column(2)),
-					DotProduct(lhs.Row(1), rhs.Column(0)),
-					DotProduct(lhs.Row(1), rhs.Column(1)),
-					DotProduct(lhs.Row(1), rhs.Column(2)),
-					DotProduct(lhs.Row(2), rhs.Column(0)),
-					DotProduct(lhs.Row(2), rhs.Column(1)),
-					DotProduct(lhs.Row(2), rhs.Column(2))};
+	return Matrix33{
+		lhs.m00 * rhs.m00 + lhs.m01 * rhs.m10 + lhs.m02 * rhs.m20,
+		lhs.m00 * rhs.m01 + lhs.m01 * rhs.m11 + lhs.m02 * rhs.m21,
+		lhs.m00 * rhs.m02 + lhs.m01 * rhs.m12 + lhs.m02 * rhs.m22,
+		lhs.m10 * rhs.m00 + lhs.m11 * rhs.m10 + lhs.m12 * rhs.m20,
+		lhs.m10 * rhs.m01 + lhs.m11 * rhs.m11 + lhs.m12 * rhs.m21,
+		lhs.m10 * rhs.m02 + lhs.m11 * rhs.m12 + lhs.m12 * rhs.m22,
+		lhs.m20 * rhs.m00 + lhs.m21 * rhs.m10 + lhs.m22 * rhs.m20,
+		lhs.m20 * rhs.m01 + lhs.m21 * rhs.m11 + lhs.m22 * rhs.m21,
+		lhs.m20 * rhs.m02 + lhs.m21 * rhs.m12 + lhs.m22 * rhs.m22,
+	};
 }
 
-inline Vector3 operator*(const Matrix33& lhs, const Vector3& rhs)
+constexpr Vector3 operator*(const Matrix33& lhs, const Vector3& rhs)
 {
 	return Vector3(
 		lhs.m00 * rhs.x + lhs.m01 * rhs.y + lhs.m02 * rhs.z,
@@ -162,7 +171,7 @@ inline Vector3 operator*(const Matrix33& lhs, const Vector3& rhs)
 	);
 }
 
-inline Vector2 operator*(const Matrix33& lhs, const Vector2& rhs)
+constexpr Vector2 operator*(const Matrix33& lhs, const Vector2& rhs)
 {
 	Vector3 homogeneous_rhs = Vector3(
 		rhs.x, 
@@ -175,8 +184,8 @@ inline Vector2 operator*(const Matrix33& lhs, const Vector2& rhs)
 	return result;
 }
 
-inline float32 SignOfElement(const Matrix33& mat, std::size_t column,
-							 std::size_t row)
+constexpr float32 SignOfElement(const Matrix33& mat, std::size_t column,
+								std::size_t row)
 {
 	return ((column + row) % 2) ? -1.0f : 1.0f;
 }
@@ -222,7 +231,7 @@ inline Matrix33 Cofactor(const Matrix33& mat)
 	return result;
 }
 
-inline Matrix33 Transpose(const Matrix33& mat)
+constexpr Matrix33 Transpose(const Matrix33& mat)
 {
 	return Matrix33(
 		mat.m00, mat.m10, mat.m20,
@@ -241,7 +250,7 @@ inline Matrix33 Inverse(const Matrix33& mat)
 	return Adjoint(mat) / Determinant(mat);
 }
 
-inline float32 Determinant(const Matrix33& mat)
+constexpr float32 Determinant(const Matrix33& mat)
 {
 	return ((mat.m00 * ((mat.m11 * mat.m22) - (mat.m12 * mat.m21))) -
 			(mat.m01 * ((mat.m10 * mat.m22) - (mat.m12 * mat.m20))) +
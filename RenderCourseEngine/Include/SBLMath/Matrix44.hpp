@@ -3,6 +3,7 @@
 #include <SBLMath/Common.hpp>
 #include <SBLMath/Matrix33.hpp>
 #include <SBLMath/Quaternion.hpp>
+#include <SBLMath/Simd.hpp>
 #include <SBLMath/Vector2.hpp>
 #include <SBLMath/Vector3.hpp>
 #include <SBLMath/Vector4.hpp>
@@ -22,10 +23,10 @@ struct Matrix44
 	Matrix44(Matrix44&& rhs) = default;
 	Matrix44& operator=(const Matrix44& rhs) = default;
 	Matrix44& operator=(Matrix44&& rhs) = default;
-	inline Matrix44(float32 _00, float32 _01, float32 _02, float32 _03,
-					float32 _10, float32 _11, float32 _12, float32 _13,
-					float32 _20, float32 _21, float32 _22, float32 _23,
-					float32 _30, float32 _31, float32 _32, float32 _33);
+	constexpr Matrix44(float32 _00, float32 _01, float32 _02, float32 _03,
+					   float32 _10, float32 _11, float32 _12, float32 _13,
+					   float32 _20, float32 _21, float32 _22, float32 _23,
+					   float32 _30, float32 _31, float32 _32, float32 _33);
 	union {
 		struct
 		{
@@ -58,17 +59,17 @@ struct Matrix44
 	static const Matrix44 Identity;
 	static const Matrix44 Zero;
 
-	static inline Matrix44 Translation(const Vector3& translation);
-	static inline Matrix44 Scale(const Vector3& scale);
-	static inline Matrix44 Scale(float scale);
+	static constexpr Matrix44 Translation(const Vector3& translation);
+	static constexpr Matrix44 Scale(const Vector3& scale);
+	static constexpr Matrix44 Scale(float scale);
 	static inline Matrix44 Rotation(const Quaternion& rotation);
 	static inline Matrix44 RotationX(float rotation);
 	static inline Matrix44 RotationY(float rotation);
 	static inline Matrix44 RotationZ(float rotation);
-	static inline Matrix44 TranslationScale(const Vector3& translation,
-											const Vector3& scale);
-	static inline Matrix44 TranslationScale(const Vector3& translation,
-											float uniformScale);
+	static constexpr Matrix44 TranslationScale(const Vector3& translation,
+											   const Vector3& scale);
+	static constexpr Matrix44 TranslationScale(const Vector3& translation,
+											   float uniformScale);
 	static inline Matrix44 TranslationRotation(const Vector3& translation,
 											   const Quaternion& rotation);
 	static inline Matrix44 TranslationRotationScale(const Vector3& translation,
@@ -79,28 +80,39 @@ struct Matrix44
 													float scale);
 };
 
-inline bool operator==(const Matrix44& lhs, const Matrix44& rhs);
-inline bool operator!=(const Matrix44& lhs, const Matrix44& rhs);
+constexpr bool operator==(const Matrix44& lhs, const Matrix44& rhs);
+constexpr bool operator!=(const Matrix44& lhs, const Matrix44& rhs);
 
-inline Matrix44 operator+(const Matrix44& lhs, float32 rhs);
-inline Matrix44 operator-(const Matrix44& lhs, float32 rhs);
-inline Matrix44 operator*(const Matrix44& lhs, float32 rhs);
-inline Matrix44 operator/(const Matrix44& lhs, float32 rhs);
+constexpr Matrix44 operator+(const Matrix44& lhs, float32 rhs);
+constexpr Matrix44 operator-(const Matrix44& lhs, float32 rhs);
+constexpr Matrix44 operator*(const Matrix44& lhs, float32 rhs);
+constexpr Matrix44 operator/(const Matrix44& lhs, float32 rhs);
 
-inline Matrix44 operator*(const Matrix44& lhs, const Matrix44& rhs);
-inline Vector4 operator*(const Matrix44& lhs, const Vector4& rhs);
-inline Vector3 operator*(const Matrix44& lhs, const Vector3& rhs);
+constexpr Matrix44 operator*(const Matrix44& lhs, const Matrix44& rhs);
+// Scalar reference implementation of operator*, available whichever SIMD
+// backend is selected. The vectorized paths agree with it within rounding.
+constexpr Matrix44 MultiplyReference(const Matrix44& lhs, const Matrix44& rhs);
+constexpr Vector4 operator*(const Matrix44& lhs, const Vector4& rhs);
+constexpr Vector3 operator*(const Matrix44& lhs, const Vector3& rhs);
 
-inline float32 SignOfElement(const Matrix44& mat, std::size_t column,
-							 std::size_t row);
+constexpr float32 SignOfElement(const Matrix44& mat, std::size_t column,
+								std::size_t row);
 inline float32 CofactorOfElement(const Matrix44& mat, std::size_t column,
 								 std::size_t row);
 inline Matrix44 Cofactor(const Matrix44& mat);
-inline Matrix44 Transpose(const Matrix44& mat);
+constexpr Matrix44 Transpose(const Matrix44& mat);
 inline Matrix44 Adjoint(const Matrix44& mat);
 inline Matrix44 Inverse(const Matrix44& mat);
-inline float32 Determinant(const Matrix44& mat);
-inline Matrix44 InverseScale(const Vector3 vec);
+constexpr float32 Determinant(const Matrix44& mat);
+constexpr Matrix44 InverseScale(const Vector3 vec);
+
+// Affine specializations. They assume the bottom row of every input is
+// (0, 0, 0, 1) and never read it, which skips the projective terms of the
+// general operator* and Inverse.
+constexpr Matrix44 AffineMultiply(const Matrix44& lhs, const Matrix44& rhs);
+constexpr Matrix44 AffineInverse(const Matrix44& mat);
+// Inverse of a rotation + translation matrix (orthonormal upper 3x3).
+constexpr Matrix44 RigidInverse(const Matrix44& mat);
 }
 }
 
@@ -6,16 +6,28 @@ namespace SBL
 {
 namespace Math
 {
-inline Matrix44::Matrix44(float32 _00, float32 _01, float32 _02, float32 _03,
-						  float32 _10, float32 _11, float32 _12, float32 _13,
-						  float32 _20, float32 _21, float32 _22, float32 _23,
-						  float32 _30, float32 _31, float32 _32, float32 _33)
+constexpr Matrix44::Matrix44(float32 _00, float32 _01, float32 _02, float32 _03,
+							 float32 _10, float32 _11, float32 _12, float32 _13,
+							 float32 _20, float32 _21, float32 _22, float32 _23,
+							 float32 _30, float32 _31, float32 _32, float32 _33)
 	: m00(_00), m01(_01), m02(_02), m03(_03), m10(_10), m11(_11), m12(_12),
 	  m13(_13), m20(_20), m21(_21), m22(_22), m23(_23), m30(_30), m31(_31),
 	  m32(_32), m33(_33)
 {
 }
 
+inline constexpr Matrix44 Matrix44::Identity{
+	1.0f, 0.0f, 0.0f, 0.0f,
+	0.0f, 1.0f, 0.0f, 0.0f,
+	0.0f, 0.0f, 1.0f, 0.0f,
+	0.0f, 0.0f, 0.0f, 1.0f};
+
+inline constexpr Matrix44 Matrix44::Zero{
+	0.0f, 0.0f, 0.0f, 0.0f,
+	0.0f, 0.0f, 0.0f, 0.0f,
+	0.0f, 0.0f, 0.0f, 0.0f,
+	0.0f, 0.0f, 0.0f, 0.0f};
+
 inline Vector4& Matrix44::operator[](std::size_t columnIndex)
 {
 	return rows[columnIndex];
@@ -37,7 +49,7 @@ inline Vector4 Matrix44::Row(std::size_t rowIndex) const
 	return rows[rowIndex];
 }
 
-inline Matrix44 Matrix44::Translation(const Vector3& translation)
+constexpr Matrix44 Matrix44::Translation(const Vector3& translation)
 {
 	return Matrix44(
 		1, 0, 0, translation.x,
@@ -46,7 +58,7 @@ inline Matrix44 Matrix44::Translation(const Vector3& translation)
 		0, 0, 0, 1);
 }
 
-inline Matrix44 Matrix44::Scale(const Vector3& scale)
+constexpr Matrix44 Matrix44::Scale(const Vector3& scale)
 {
 	return Matrix44(
 		scale.x, 0, 0, 0,
@@ -55,7 +67,7 @@ inline Matrix44 Matrix44::Scale(const Vector3& scale)
 		0, 0, 0, 1);
 }
 
-inline Matrix44 Matrix44::Scale(float scale)
+constexpr Matrix44 Matrix44::Scale(float scale)
 {
 	return Matrix44(
 		scale, 0, 0, 0,
@@ -110,8 +122,8 @@ inline Matrix44 Matrix44::RotationZ(float r)
 	);
 }
 
-inline Matrix44 Matrix44::TranslationScale(const Vector3& translation,
-										   const Vector3& scale)
+constexpr Matrix44 Matrix44::TranslationScale(const Vector3& translation,
+											  const Vector3& scale)
 {
 	return Matrix44(
 		scale.x, 0, 0, translation.x,
@@ -120,8 +132,8 @@ inline Matrix44 Matrix44::TranslationScale(const Vector3& translation,
 		0, 0, 0, 1);
 }
 
-inline Matrix44 Matrix44::TranslationScale(const Vector3& translation,
-										   float uniformScale)
+constexpr Matrix44 Matrix44::TranslationScale(const Vector3& translation,
+											  float uniformScale)
 {
 	return Matrix44(
 		uniformScale, 0, 0, translation.x,
@@ -150,21 +162,24 @@ inline Matrix44 Matrix44::TranslationRotationScale(const Vector3& translation,
 	return  Translation(translation) * Rotation(rotation) * Scale(scale);
 }
 
-inline bool operator==(const Matrix44& lhs, const Matrix44& rhs)
+constexpr bool operator==(const Matrix44& lhs, const Matrix44& rhs)
 {
 	return Equals(lhs.m00, rhs.m00) && Equals(lhs.m01, rhs.m01) &&
-		   Equals(lhs.m02, rhs.m02) && Equals(lhs.m10, rhs.m10) &&
-		   Equals(lhs.m11, rhs.m11) && Equals(lhs.m12, rhs.m12) &&
+		   Equals(lhs.m02, rhs.m02) && Equals(lhs.m03, rhs.m03) &&
+		   Equals(lhs.m10, rhs.m10) && Equals(lhs.m11, rhs.m11) &&
+		   Equals(lhs.m12, rhs.m12) && Equals(lhs.m13, rhs.m13) &&
 		   Equals(lhs.m20, rhs.m20) && Equals(lhs.m21, rhs.m21) &&
-		   Equals(lhs.m22, rhs.m22);
+		   Equals(lhs.m22, rhs.m22) && Equals(lhs.m23, rhs.m23) &&
+		   Equals(lhs.m30, rhs.m30) && Equals(lhs.m31, rhs.m31) &&
+		   Equals(lhs.m32, rhs.m32) && Equals(lhs.m33, rhs.m33);
 }
 
-inline bool operator!=(const Matrix44& lhs, const Matrix44& rhs)
+constexpr bool operator!=(const Matrix44& lhs, const Matrix44& rhs)
 {
 	return !(lhs == rhs);
 }
 
-inline Matrix44 operator+(const Matrix44& lhs, float32 rhs)
+constexpr Matrix44 operator+(const Matrix44& lhs, float32 rhs)
 {
 	return Matrix44{lhs.m00 + rhs, lhs.m01 + rhs, lhs.m02 + rhs, lhs.m03 + rhs,
 					lhs.m10 + rhs, lhs.m11 + rhs, lhs.m12 + rhs, lhs.m13 + rhs,
@@ -172,7 +187,7 @@ inline Matrix44 operator+(const Matrix44& lhs, float32 rhs)
 					lhs.m30 + rhs, lhs.m31 + rhs, lhs.m32 + rhs, lhs.m33 + rhs};
 }
 
-inline Matrix44 operator-(const Matrix44& lhs, float32 rhs)
+constexpr Matrix44 operator-(const Matrix44& lhs, float32 rhs)
 {
 	return Matrix44{lhs.m00 - rhs, lhs.m01 - rhs, lhs.m02 - rhs, lhs.m03 - rhs,
 					lhs.m10 - rhs, lhs.m11 - rhs, lhs.m12 - rhs, lhs.m13 - rhs,
@@ -180,7 +195,7 @@ inline Matrix44 operator-(const Matrix44& lhs, float32 rhs)
 					lhs.m30 - rhs, lhs.m31 - rhs, lhs.m32 - rhs, lhs.m33 - rhs};
 }
 
-inline Matrix44 operator*(const Matrix44& lhs, float32 rhs)
+constexpr Matrix44 operator*(const Matrix44& lhs, float32 rhs)
 {
 	return Matrix44{lhs.m00 * rhs, lhs.m01 * rhs, lhs.m02 * rhs, lhs.m03 * rhs,
 					lhs.m10 * rhs, lhs.m11 * rhs, lhs.m12 * rhs, lhs.m13 * rhs,
@@ -188,7 +203,7 @@ inline Matrix44 operator*(const Matrix44& lhs, float32 rhs)
 					lhs.m30 * rhs, lhs.m31 * rhs, lhs.m32 * rhs, lhs.m33 * rhs};
 }
 
-inline Matrix44 operator/(const Matrix44& lhs, float32 rhs)
+constexpr Matrix44 operator/(const Matrix44& lhs, float32 rhs)
 {
 	return Matrix44{lhs.m00 / rhs, lhs.m01 / rhs, lhs.m02 / rhs, lhs.m03 / rhs,
 					lhs.m10 / rhs, lhs.m11 / rhs, lhs.m12 / rhs, lhs.m13 / rhs,
@@ -196,35 +211,133 @@ inline Matrix44 operator/(const Matrix44& lhs, float32 rhs)
 					lhs.m30 / rhs, lhs.m31 / rhs, lhs.m32 / rhs, lhs.m33 / rhs};
 }
 
-inline Matrix44 operator*(const Matrix44& lhs, const Matrix44& rhs)
+#if SBL_MATH_SIMD_SSE
+namespace Simd
+{
+inline Matrix44 Multiply(const Matrix44& lhs, const Matrix44& rhs)
 {
+#if SBL_MATH_SIMD_AVX
+	// Two result rows per 256-bit register; each rhs row is broadcast into
+	// both 128-bit lanes and scaled by the matching lhs element of each row.
+	Matrix44 res;
+	__m256 rhsRows[4];
+	for (std::size_t k = 0; k < 4; ++k)
+	{
+		rhsRows[k] = _mm256_broadcast_ps(
+			reinterpret_cast<const __m128*>(rhs.values + 4 * k));
+	}
+	for (std::size_t i = 0; i < 16; i += 8)
+	{
+		__m256 rows = _mm256_loadu_ps(lhs.values + i);
+		__m256 acc = _mm256_mul_ps(_mm256_shuffle_ps(rows, rows, _MM_SHUFFLE(0, 0, 0, 0)), rhsRows[0]);
+		acc = _mm256_add_ps(acc, _mm256_mul_ps(_mm256_shuffle_ps(rows, rows, _MM_SHUFFLE(1, 1, 1, 1)), rhsRows[1]));
+		acc = _mm256_add_ps(acc, _mm256_mul_ps(_mm256_shuffle_ps(rows, rows, _MM_SHUFFLE(2, 2, 2, 2)), rhsRows[2]));
+		acc = _mm256_add_ps(acc, _mm256_mul_ps(_mm256_shuffle_ps(rows, rows, _MM_SHUFFLE(3, 3, 3, 3)), rhsRows[3]));
+		_mm256_storeu_ps(res.values + i, acc);
+	}
+	return res;
+#else
+	// Each result row is a linear combination of the rhs rows, which avoids
+	// gathering the strided rhs columns.
 	Matrix44 res;
-	
-	res.m00 = DotProduct(lhs.Row(0), rhs.Column(0));
-	res.m01 = DotProduct(lhs.Row(0), rhs.Column(1));
-	res.m02 = DotProduct(lhs.Row(0), rhs.Column(2));
-	res.m03 = DotProduct(lhs.Row(0), rhs.Column(3));
-
-	res.m10 = DotProduct(lhs.Row(1), rhs.Column(0));
-	res.m11 = DotProduct(lhs.Row(1), rhs.Column(1));
-	res.m12 = DotProduct(lhs.Row(1), rhs.Column(2));
-	res.m13 = DotProduct(lhs.Row(1), rhs.Column(3));
-
-	res.m20 = DotProduct(lhs.Row(2), rhs.Column(0));
-	res.m21 = DotProduct(lhs.Row(2), rhs.Column(1));
-	res.m22 = DotProduct(lhs.Row(2), rhs.Column(2));
-	res.m23 = DotProduct(lhs.Row(2), rhs.Column(3));
-
-	res.m30 = DotProduct(lhs.Row(3), rhs.Column(0));
-	res.m31 = DotProduct(lhs.Row(3), rhs.Column(1));
-	res.m32 = DotProduct(lhs.Row(3), rhs.Column(2));
-	res.m33 = DotProduct(lhs.Row(3), rhs.Column(3));
+	__m128 rhs0 = _mm_loadu_ps(rhs.values + 0);
+	__m128 rhs1 = _mm_loadu_ps(rhs.values + 4);
+	__m128 rhs2 = _mm_loadu_ps(rhs.values + 8);
+	__m128 rhs3 = _mm_loadu_ps(rhs.values + 12);
+	for (std::size_t i = 0; i < 16; i += 4)
+	{
+		__m128 row = _mm_loadu_ps(lhs.values + i);
+		__m128 acc = _mm_mul_ps(_mm_shuffle_ps(row, row, _MM_SHUFFLE(0, 0, 0, 0)), rhs0);
+		acc = _mm_add_ps(acc, _mm_mul_ps(_mm_shuffle_ps(row, row, _MM_SHUFFLE(1, 1, 1, 1)), rhs1));
+		acc = _mm_add_ps(acc, _mm_mul_ps(_mm_shuffle_ps(row, row, _MM_SHUFFLE(2, 2, 2, 2)), rhs2));
+		acc = _mm_add_ps(acc, _mm_mul_ps(_mm_shuffle_ps(row, row, _MM_SHUFFLE(3, 3, 3, 3)), rhs3));
+		_mm_storeu_ps(res.values + i, acc);
+	}
+	return res;
+#endif
+}
 
+inline Vector4 Multiply(const Matrix44& lhs, const Vector4& rhs)
+{
+	// Transpose-free: multiply every row by the vector, then sum horizontally
+	// across the four products at once.
+	__m128 vec = Simd::Load(rhs);
+	__m128 r0 = _mm_mul_ps(_mm_loadu_ps(lhs.values + 0), vec);
+	__m128 r1 = _mm_mul_ps(_mm_loadu_ps(lhs.values + 4), vec);
+	__m128 r2 = _mm_mul_ps(_mm_loadu_ps(lhs.values + 8), vec);
+	__m128 r3 = _mm_mul_ps(_mm_loadu_ps(lhs.values + 12), vec);
+	_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+	return Simd::Store(_mm_add_ps(_mm_add_ps(r0, r1), _mm_add_ps(r2, r3)));
+}
+
+inline Matrix44 AffineMultiply(const Matrix44& lhs, const Matrix44& rhs)
+{
+	// Same row combination as operator*, but the rhs bottom row is known to
+	// be (0, 0, 0, 1) so only three lhs rows need work.
+	Matrix44 res;
+	__m128 rhs0 = _mm_loadu_ps(rhs.values + 0);
+	__m128 rhs1 = _mm_loadu_ps(rhs.values + 4);
+	__m128 rhs2 = _mm_loadu_ps(rhs.values + 8);
+	__m128 wAxis = _mm_setr_ps(0.0f, 0.0f, 0.0f, 1.0f);
+	for (std::size_t i = 0; i < 12; i += 4)
+	{
+		__m128 row = _mm_loadu_ps(lhs.values + i);
+		__m128 acc = _mm_mul_ps(_mm_shuffle_ps(row, row, _MM_SHUFFLE(0, 0, 0, 0)), rhs0);
+		acc = _mm_add_ps(acc, _mm_mul_ps(_mm_shuffle_ps(row, row, _MM_SHUFFLE(1, 1, 1, 1)), rhs1));
+		acc = _mm_add_ps(acc, _mm_mul_ps(_mm_shuffle_ps(row, row, _MM_SHUFFLE(2, 2, 2, 2)), rhs2));
+		acc = _mm_add_ps(acc, _mm_mul_ps(_mm_shuffle_ps(row, row, _MM_SHUFFLE(3, 3, 3, 3)), wAxis));
+		_mm_storeu_ps(res.values + i, acc);
+	}
+	_mm_storeu_ps(res.values + 12, wAxis);
 	return res;
 }
+}
+#endif
+
+constexpr Matrix44 operator*(const Matrix44& lhs, const Matrix44& rhs)
+{
+#if SBL_MATH_SIMD_SSE
+	if (!IsConstantEvaluated())
+	{
+		return Simd::Multiply(lhs, rhs);
+	}
+#endif
+	return MultiplyReference(lhs, rhs);
+}
 
-inline Vector4 operator*(const Matrix44& lhs, const Vector4& rhs)
+constexpr Matrix44 MultiplyReference(const Matrix44& lhs, const Matrix44& rhs)
 {
+	return Matrix44(
+		lhs.m00 * rhs.m00 + lhs.m01 * rhs.m10 + lhs.m02 * rhs.m20 + lhs.m03 * rhs.m30,
+		lhs.m00 * rhs.m01 + lhs.m01 * rhs.m11 + lhs.m02 * rhs.m21 + lhs.m03 * rhs.m31,
+		lhs.m00 * rhs.m02 + lhs.m01 * rhs.m12 + lhs.m02 * rhs.m22 + lhs.m03 * rhs.m32,
+		lhs.m00 * rhs.m03 + lhs.m01 * rhs.m13 + lhs.m02 * rhs.m23 + lhs.m03 * rhs.m33,
+
+		lhs.m10 * rhs.m00 + lhs.m11 * rhs.m10 + lhs.m12 * rhs.m20 + lhs.m13 * rhs.m30,
+		lhs.m10 * rhs.m01 + lhs.m11 * rhs.m11 + lhs.m12 * rhs.m21 + lhs.m13 * rhs.m31,
+		lhs.m10 * rhs.m02 + lhs.m11 * rhs.m12 + lhs.m12 * rhs.m22 + lhs.m13 * rhs.m32,
+		lhs.m10 * rhs.m03 + lhs.m11 * rhs.m13 + lhs.m12 * rhs.m23 + lhs.m13 * rhs.m33,
+
+		lhs.m20 * rhs.m00 + lhs.m21 * rhs.m10 + lhs.m22 * rhs.m20 + lhs.m23 * rhs.m30,
+		lhs.m20 * rhs.m01 + lhs.m21 * rhs.m11 + lhs.m22 * rhs.m21 + lhs.m23 * rhs.m31,
+		lhs.m20 * rhs.m02 + lhs.m21 * rhs.m12 + lhs.m22 * rhs.m22 + lhs.m23 * rhs.m32,
+		lhs.m20 * rhs.m03 + lhs.m21 * rhs.m13 + lhs.m22 * rhs.m23 + lhs.m23 * rhs.m33,
+
+		lhs.m30 * rhs.m00 + lhs.m31 * rhs.m10 + lhs.m32 * rhs.m20 + lhs.m33 * rhs.m30,
+		lhs.m30 * rhs.m01 + lhs.m31 * rhs.m11 + lhs.m32 * rhs.m21 + lhs.m33 * rhs.m31,
+		lhs.m30 * rhs.m02 + lhs.m31 * rhs.m12 + lhs.m32 * rhs.m22 + lhs.m33 * rhs.m32,
+		lhs.m30 * rhs.m03 + lhs.m31 * rhs.m13 + lhs.m32 * rhs.m23 + lhs.m33 * rhs.m33
+	);
+}
+
+constexpr Vector4 operator*(const Matrix44& lhs, const Vector4& rhs)
+{
+#if SBL_MATH_SIMD_SSE
+	if (!IsConstantEvaluated())
+	{
+		return Simd::Multiply(lhs, rhs);
+	}
+#endif
 	return Vector4(
 		lhs.m00 * rhs.x + lhs.m01 * rhs.y + lhs.m02 * rhs.z + lhs.m03 * rhs.w,
 		lhs.m10 * rhs.x + lhs.m11 * rhs.y + lhs.m12 * rhs.z + lhs.m13 * rhs.w,
@@ -233,7 +346,7 @@ inline Vector4 operator*(const Matrix44& lhs, const Vector4& rhs)
 	);
 }
 
-inline Vector3 operator*(const Matrix44& lhs, const Vector3& rhs)
+constexpr Vector3 operator*(const Matrix44& lhs, const Vector3& rhs)
 {
 	Vector4 homo_rhs = Vector4(
 		rhs.x,
@@ -250,8 +363,8 @@ inline Vector3 operator*(const Matrix44& lhs, const Vector3& rhs)
 	return res;
 }
 
-inline float32 SignOfElement(const Matrix44& mat, std::size_t column,
-							 std::size_t row)
+constexpr float32 SignOfElement(const Matrix44& mat, std::size_t column,
+								std::size_t row)
 {
 	return ((column + row) % 2) ? -1.0f : 1.0f;
 }
@@ -259,29 +372,20 @@ inline float32 SignOfElement(const Matrix44& mat, std::size_t column,
 inline float32 CofactorOfElement(const Matrix44& mat, std::size_t column,
 								 std::size_t row)
 {
-	std::size_t resultColumn = 0;
-	std::size_t resultRow = 0;
+	// The three rows/columns that remain once `row` and `column` are removed
+	const std::size_t c0 = column == 0 ? 1 : 0;
+	const std::size_t c1 = column <= 1 ? 2 : 1;
+	const std::size_t c2 = column <= 2 ? 3 : 2;
+	const std::size_t r0 = row == 0 ? 1 : 0;
+	const std::size_t r1 = row <= 1 ? 2 : 1;
+	const std::size_t r2 = row <= 2 ? 3 : 2;
 
-	Matrix33 mat33;
+	const float32 minor =
+		mat[r0][c0] * (mat[r1][c1] * mat[r2][c2] - mat[r1][c2] * mat[r2][c1]) -
+		mat[r0][c1] * (mat[r1][c0] * mat[r2][c2] - mat[r1][c2] * mat[r2][c0]) +
+		mat[r0][c2] * (mat[r1][c0] * mat[r2][c1] - mat[r1][c1] * mat[r2][c0]);
 
-	for (std::size_t x = 0; x < 4; ++x)
-	{
-		if (x != column)
-		{
-			resultRow = 0;
-			for (std::size_t y = 0; y < 4; ++y)
-			{
-				if (y != row)
-				{
-					mat33[resultRow][resultColumn] = mat[y][x];
-					++resultRow;
-				}
-			}
-			++resultColumn;
-		}
-	}
-
-	return SignOfElement(mat, column, row) * Determinant(mat33);
+	return SignOfElement(mat, column, row) * minor;
 }
 
 inline Matrix44 Cofactor(const Matrix44& mat)
@@ -297,7 +401,7 @@ inline Matrix44 Cofactor(const Matrix44& mat)
 	return result;
 }
 
-inline Matrix44 Transpose(const Matrix44& mat)
+constexpr Matrix44 Transpose(const Matrix44& mat)
 {
 	return Matrix44(
 		mat.m00, mat.m10, mat.m20, mat.m30,
@@ -381,17 +485,100 @@ inline Matrix44 Inverse(const Matrix44& mat)
 	return invMat;
 }
 
-inline float32 Determinant(const Matrix44& mat)
+constexpr float32 Determinant(const Matrix44& mat)
 {
-	// TODO: IMPLEMENT ME <not a part of skybox U graphics assignment>
-	return 0.0f;
+	// Laplace expansion by the top two rows: every 2x2 minor of rows 0-1
+	// times its complementary minor from rows 2-3.
+	const float32 s0 = mat.m00 * mat.m11 - mat.m01 * mat.m10;
+	const float32 s1 = mat.m00 * mat.m12 - mat.m02 * mat.m10;
+	const float32 s2 = mat.m00 * mat.m13 - mat.m03 * mat.m10;
+	const float32 s3 = mat.m01 * mat.m12 - mat.m02 * mat.m11;
+	const float32 s4 = mat.m01 * mat.m13 - mat.m03 * mat.m11;
+	const float32 s5 = mat.m02 * mat.m13 - mat.m03 * mat.m12;
+
+	const float32 c0 = mat.m20 * mat.m31 - mat.m21 * mat.m30;
+	const float32 c1 = mat.m20 * mat.m32 - mat.m22 * mat.m30;
+	const float32 c2 = mat.m20 * mat.m33 - mat.m23 * mat.m30;
+	const float32 c3 = mat.m21 * mat.m32 - mat.m22 * mat.m31;
+	const float32 c4 = mat.m21 * mat.m33 - mat.m23 * mat.m31;
+	const float32 c5 = mat.m22 * mat.m33 - mat.m23 * mat.m32;
+
+	return s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
 }
 
-inline Matrix44 InverseScale(const Vector3 scale) {
+constexpr Matrix44 InverseScale(const Vector3 scale) {
+	return Matrix44(
+		1 / scale.x, 0, 0, 0,
+		0, 1 / scale.y, 0, 0,
+		0, 0, 1 / scale.z, 0,
+		0, 0, 0, 1
+	);
+}
+
+constexpr Matrix44 AffineMultiply(const Matrix44& lhs, const Matrix44& rhs)
+{
+#if SBL_MATH_SIMD_SSE
+	if (!IsConstantEvaluated())
+	{
+		return Simd::AffineMultiply(lhs, rhs);
+	}
+#endif
+	return Matrix44(
+		lhs.m00 * rhs.m00 + lhs.m01 * rhs.m10 + lhs.m02 * rhs.m20,
+		lhs.m00 * rhs.m01 + lhs.m01 * rhs.m11 + lhs.m02 * rhs.m21,
+		lhs.m00 * rhs.m02 + lhs.m01 * rhs.m12 + lhs.m02 * rhs.m22,
+		lhs.m00 * rhs.m03 + lhs.m01 * rhs.m13 + lhs.m02 * rhs.m23 + lhs.m03,
+
+		lhs.m10 * rhs.m00 + lhs.m11 * rhs.m10 + lhs.m12 * rhs.m20,
+		lhs.m10 * rhs.m01 + lhs.m11 * rhs.m11 + lhs.m12 * rhs.m21,
+		lhs.m10 * rhs.m02 + lhs.m11 * rhs.m12 + lhs.m12 * rhs.m22,
+		lhs.m10 * rhs.m03 + lhs.m11 * rhs.m13 + lhs.m12 * rhs.m23 + lhs.m13,
+
+		lhs.m20 * rhs.m00 + lhs.m21 * rhs.m10 + lhs.m22 * rhs.m20,
+		lhs.m20 * rhs.m01 + lhs.m21 * rhs.m11 + lhs.m22 * rhs.m21,
+		lhs.m20 * rhs.m02 + lhs.m21 * rhs.m12 + lhs.m22 * rhs.m22,
+		lhs.m20 * rhs.m03 + lhs.m21 * rhs.m13 + lhs.m22 * rhs.m23 + lhs.m23,
+
+		0, 0, 0, 1
+	);
+}
+
+constexpr Matrix44 AffineInverse(const Matrix44& mat)
+{
+	// Invert the upper 3x3 through its adjugate, then move the translation
+	// into the inverted frame: inv(M) = [inv(A), -inv(A) * t]
+	const float32 c00 = mat.m11 * mat.m22 - mat.m12 * mat.m21;
+	const float32 c01 = mat.m12 * mat.m20 - mat.m10 * mat.m22;
+	const float32 c02 = mat.m10 * mat.m21 - mat.m11 * mat.m20;
+
+	const float32 invDet =
+		1.0f / (mat.m00 * c00 + mat.m01 * c01 + mat.m02 * c02);
+
+	const float32 i00 = c00 * invDet;
+	const float32 i01 = (mat.m02 * mat.m21 - mat.m01 * mat.m22) * invDet;
+	const float32 i02 = (mat.m01 * mat.m12 - mat.m02 * mat.m11) * invDet;
+	const float32 i10 = c01 * invDet;
+	const float32 i11 = (mat.m00 * mat.m22 - mat.m02 * mat.m20) * invDet;
+	const float32 i12 = (mat.m02 * mat.m10 - mat.m00 * mat.m12) * invDet;
+	const float32 i20 = c02 * invDet;
+	const float32 i21 = (mat.m01 * mat.m20 - mat.m00 * mat.m21) * invDet;
+	const float32 i22 = (mat.m00 * mat.m11 - mat.m01 * mat.m10) * invDet;
+
+	return Matrix44(
+		i00, i01, i02, -(i00 * mat.m03 + i01 * mat.m13 + i02 * mat.m23),
+		i10, i11, i12, -(i10 * mat.m03 + i11 * mat.m13 + i12 * mat.m23),
+		i20, i21, i22, -(i20 * mat.m03 + i21 * mat.m13 + i22 * mat.m23),
+		0, 0, 0, 1
+	);
+}
+
+constexpr Matrix44 RigidInverse(const Matrix44& mat)
+{
+	// The rotation is orthonormal, so its inverse is its transpose
 	return Matrix44(
-		1 / scale.x, 0, 0, 1,
-		0, 1 / scale.y, 0, 1,
-		0, 0, 1 / scale.z, 1,
+		mat.m00, mat.m10, mat.m20, -(mat.m00 * mat.m03 + mat.m10 * mat.m13 + mat.m20 * mat.m23),
+		mat.m01, mat.m11, mat.m21, -(mat.m01 * mat.m03 + mat.m11 * mat.m13 + mat.m21 * mat.m23),
+		mat.m02, mat.m12, mat.m22, -(mat.m02 * mat.m03 + mat.m12 * mat.m13 + mat.m22 * mat.m23),
 		0, 0, 0, 1
 	);
 }
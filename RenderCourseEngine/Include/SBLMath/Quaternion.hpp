@@ -4,6 +4,8 @@
 #include <SBLMath/Vector3.hpp>
 #include <SBLMath/Vector4.hpp>
 
+#include <cstddef>
+
 namespace SBL
 {
 namespace Math
@@ -16,9 +18,9 @@ struct Quaternion
 	Quaternion(Quaternion&& rhs) = default;
 	Quaternion& operator=(const Quaternion& rhs) = default;
 	Quaternion& operator=(Quaternion&& rhs) = default;
-	inline Quaternion(float32 _x, float32 _y, float32 _z, float32 _w);
-	explicit inline Quaternion(const Vector4& rhs);
-	inline operator Vector4() const;
+	constexpr Quaternion(float32 _x, float32 _y, float32 _z, float32 _w);
+	explicit constexpr Quaternion(const Vector4& rhs);
+	constexpr operator Vector4() const;
 
 	float32 x;
 	float32 y;
@@ -33,16 +35,32 @@ struct Quaternion
 	static inline Quaternion AxisAngle(const Vector3& axis, Radians angle);
 };
 
-inline bool operator==(const Quaternion& lhs, const Quaternion& rhs);
-inline bool operator!=(const Quaternion& lhs, const Quaternion& rhs);
+constexpr bool operator==(const Quaternion& lhs, const Quaternion& rhs);
+constexpr bool operator!=(const Quaternion& lhs, const Quaternion& rhs);
 
-inline Quaternion operator*(const Quaternion& lhs, const Quaternion& rhs);
+constexpr Quaternion operator*(const Quaternion& lhs, const Quaternion& rhs);
 
 inline Quaternion Normalized(const Quaternion& vec);
+inline Quaternion FastNormalized(const Quaternion& vec);
 inline Quaternion Slerp(const Quaternion& source, const Quaternion& target,
 						float32 portion);
 inline Quaternion Nlerp(const Quaternion& source, const Quaternion& target,
 						float32 portion);
+// Nlerp with a polynomial correction of the portion that keeps the angular
+// velocity close to Slerp's, see https://zeux.io/2015/07/23/approximating-slerp/
+// Inputs must be normalized. Unlike Slerp it always takes the shorter arc.
+// Max error against Slerp on the shorter arc is 5e-4.
+inline Quaternion SlerpFast(const Quaternion& source, const Quaternion& target,
+							float32 portion);
+
+// out[i] = Slerp(source[i], target[i], portions[i]) for i in [0, count).
+// The SIMD path blends four rotations at a time with polynomial acos, sin
+// and cos; it stays within 2e-6 of Slerp.
+void SlerpBatch(const Quaternion* source, const Quaternion* target,
+				const float32* portions, std::size_t count, Quaternion* out);
+// out[i] = Nlerp(source[i], target[i], portions[i]) for i in [0, count).
+void NlerpBatch(const Quaternion* source, const Quaternion* target,
+				const float32* portions, std::size_t count, Quaternion* out);
 }
 }
 
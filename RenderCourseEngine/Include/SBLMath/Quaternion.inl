@@ -6,17 +6,20 @@ namespace SBL
 {
 namespace Math
 {
-inline Quaternion::Quaternion(float32 _x, float32 _y, float32 _z, float32 _w)
+constexpr Quaternion::Quaternion(float32 _x, float32 _y, float32 _z, float32 _w)
 	: x(_x), y(_y), z(_z), w(_w)
 {
 }
 
-inline Quaternion::Quaternion(const Vector4& rhs)
+constexpr Quaternion::Quaternion(const Vector4& rhs)
 	: x(rhs.x), y(rhs.y), z(rhs.z), w(rhs.w)
 {
 }
 
-inline Quaternion::operator Vector4() const
+inline constexpr Quaternion Quaternion::Zero{0.0f, 0.0f, 0.0f, 0.0f};
+inline constexpr Quaternion Quaternion::Identity{0.0f, 0.0f, 0.0f, 1.0f};
+
+constexpr Quaternion::operator Vector4() const
 {
 	return Vector4{x, y, z, w};
 }
@@ -56,18 +59,18 @@ inline Quaternion Quaternion::AxisAngle(const Vector3& axis, Radians angle)
 					  axis.z * Sin(angle / 2.0f), Cos(angle / 2.0f)};
 }
 
-inline bool operator==(const Quaternion& lhs, const Quaternion& rhs)
+constexpr bool operator==(const Quaternion& lhs, const Quaternion& rhs)
 {
 	return Equals(lhs.x, rhs.x) && Equals(lhs.y, rhs.y) &&
 		   Equals(lhs.z, rhs.z) && Equals(lhs.w, rhs.w);
 }
 
-inline bool operator!=(const Quaternion& lhs, const Quaternion& rhs)
+constexpr bool operator!=(const Quaternion& lhs, const Quaternion& rhs)
 {
 	return !(lhs == rhs);
 }
 
-inline Quaternion operator*(const Quaternion& q2, const Quaternion& q1)
+constexpr Quaternion operator*(const Quaternion& q2, const Quaternion& q1)
 {
 	return {q1.w * q2.x + q1.x * q2.w - q1.y * q2.z + q1.z * q2.y,
 			q1.w * q2.y + q1.x * q2.z + q1.y * q2.w - q1.z * q2.x,
@@ -77,8 +80,19 @@ inline Quaternion operator*(const Quaternion& q2, const Quaternion& q1)
 
 inline Quaternion Normalized(const Quaternion& q)
 {
+#ifdef SBL_MATH_FAST_MATH
+	return FastNormalized(q);
+#else
 	const float32 length = Length(q);
 	return {q.x / length, q.y / length, q.z / length, q.w / length};
+#endif
+}
+
+inline Quaternion FastNormalized(const Quaternion& q)
+{
+	const float32 invLength = FastInverseSqrt(LengthSquared(q));
+	return {q.x * invLength, q.y * invLength, q.z * invLength,
+			q.w * invLength};
 }
 
 inline Quaternion Slerp(const Quaternion& source, const Quaternion& target,
@@ -103,5 +117,20 @@ inline Quaternion Nlerp(const Quaternion& source, const Quaternion& target,
 {
 	return (Quaternion)Normalized(Lerp(source, target, portion));
 }
+
+inline Quaternion SlerpFast(const Quaternion& source, const Quaternion& target,
+							float32 portion)
+{
+	const float32 cosAngle = DotProduct(source, target);
+	const float32 d = Abs(cosAngle);
+	const float32 a = 1.0904f + d * (-3.2452f + d * (3.55645f - d * 1.43519f));
+	const float32 b = 0.848013f + d * (-1.06021f + d * 0.215638f);
+	const float32 k = a * (portion - 0.5f) * (portion - 0.5f) + b;
+	const float32 t =
+		portion + portion * (portion - 0.5f) * (portion - 1.0f) * k;
+	const float32 targetPortion = cosAngle < 0.0f ? -t : t;
+	return (Quaternion)Normalized(Vector4(source) * (1.0f - t) +
+								  Vector4(target) * targetPortion);
+}
 }
 }
\ No newline at end of file
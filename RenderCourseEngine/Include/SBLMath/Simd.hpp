@@ -0,0 +1,26 @@
+#pragma once
+
+// Compile-time selection of the SIMD backend used by Vector4 and Matrix44.
+// SSE is picked up automatically on x86/x64, AVX when the compiler is told it
+// may use it (/arch:AVX, -mavx). Define SBL_MATH_NO_SIMD to force the scalar
+// reference path everywhere.
+
+#if !defined(SBL_MATH_NO_SIMD) &&                                             \
+	(defined(__SSE__) || defined(_M_X64) ||                                    \
+	 (defined(_M_IX86_FP) && _M_IX86_FP >= 1))
+#define SBL_MATH_SIMD_SSE 1
+#else
+#define SBL_MATH_SIMD_SSE 0
+#endif
+
+#if SBL_MATH_SIMD_SSE && defined(__AVX__)
+#define SBL_MATH_SIMD_AVX 1
+#else
+#define SBL_MATH_SIMD_AVX 0
+#endif
+
+#if SBL_MATH_SIMD_AVX
+#include <immintrin.h>
+#elif SBL_MATH_SIMD_SSE
+#include <xmmintrin.h>
+#endif
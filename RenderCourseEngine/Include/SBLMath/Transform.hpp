@@ -4,6 +4,9 @@
 #include <SBLMath/Quaternion.hpp>
 #include <SBLMath/Vector3.hpp>
 
+#include <cstddef>
+#include <vector>
+
 namespace SBL
 {
 namespace Math
@@ -15,6 +18,43 @@ struct UniformTransform final
 	float m_uniformScale;
 };
 
+// Structure-of-arrays storage for many translation/rotation/scale transforms.
+// Every component lives in its own contiguous array so that the batch kernels
+// can compose several objects per SIMD register.
+struct TransformBatch final
+{
+	inline std::size_t Size() const;
+	inline void Resize(std::size_t count);
+	inline void Set(std::size_t index, const Vector3& translation,
+					const Quaternion& rotation, const Vector3& scale);
+
+	std::vector<float32> m_translationX;
+	std::vector<float32> m_translationY;
+	std::vector<float32> m_translationZ;
+	std::vector<float32> m_rotationX;
+	std::vector<float32> m_rotationY;
+	std::vector<float32> m_rotationZ;
+	std::vector<float32> m_rotationW;
+	std::vector<float32> m_scaleX;
+	std::vector<float32> m_scaleY;
+	std::vector<float32> m_scaleZ;
+};
+
+// Closed-form Translation * Rotation * Scale, without the intermediate matrix
+// products. The rotation does not need to be normalized.
 Matrix44 BuildWorldTransformMatrix(const UniformTransform& transform);
+void BuildWorldTransformMatrices(const UniformTransform* transforms,
+								 std::size_t count, Matrix44* out);
+
+// Writes Translation * Rotation * Scale for every entry of the batch into
+// out[0 .. batch.Size()). Rotations do not need to be normalized.
+void BuildWorldTransformMatrices(const TransformBatch& batch, Matrix44* out);
+
+// out[i] = Matrix44::Rotation(rotations[i]) for i in [0, count). Rotations do
+// not need to be normalized.
+void ToMatrixBatch(const Quaternion* rotations, std::size_t count,
+				   Matrix44* out);
 }
 }
+
+#include <SBLMath/Transform.inl>
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <SBLMath/Transform.hpp>
+
+namespace SBL
+{
+namespace Math
+{
+inline std::size_t TransformBatch::Size() const
+{
+	return m_translationX.size();
+}
+
+inline void TransformBatch::Resize(std::size_t count)
+{
+	m_translationX.resize(count);
+	m_translationY.resize(count);
+	m_translationZ.resize(count);
+	m_rotationX.resize(count);
+	m_rotationY.resize(count);
+	m_rotationZ.resize(count);
+	m_rotationW.resize(count);
+	m_scaleX.resize(count);
+	m_scaleY.resize(count);
+	m_scaleZ.resize(count);
+}
+
+inline void TransformBatch::Set(std::size_t index, const Vector3& translation,
+								const Quaternion& rotation,
+								const Vector3& scale)
+{
+	m_translationX[index] = translation.x;
+	m_translationY[index] = translation.y;
+	m_translationZ[index] = translation.z;
+	m_rotationX[index] = rotation.x;
+	m_rotationY[index] = rotation.y;
+	m_rotationZ[index] = rotation.z;
+	m_rotationW[index] = rotation.w;
+	m_scaleX[index] = scale.x;
+	m_scaleY[index] = scale.y;
+	m_scaleZ[index] = scale.z;
+}
+}
+}
@@ -17,7 +17,7 @@ struct Vector2
 	Vector2(Vector2&& rhs) = default;
 	Vector2& operator=(const Vector2& rhs) = default;
 	Vector2& operator=(Vector2&& rhs) = default;
-	inline Vector2(float32 _x, float32 _y);
+	constexpr Vector2(float32 _x, float32 _y);
 
 	// In C++, POD types cannot have member initializers
 	union {
@@ -41,52 +41,53 @@ struct Vector2
 	static const Vector2 Unit;
 };
 
-inline bool operator==(const Vector2& lhs, const Vector2& rhs);
-inline bool operator!=(const Vector2& lhs, const Vector2& rhs);
+constexpr bool operator==(const Vector2& lhs, const Vector2& rhs);
+constexpr bool operator!=(const Vector2& lhs, const Vector2& rhs);
 
-inline Vector2 operator-(const Vector2& vec);
+constexpr Vector2 operator-(const Vector2& vec);
 
-inline Vector2 operator+(const Vector2& lhs, const Vector2& rhs);
-inline Vector2 operator-(const Vector2& lhs, const Vector2& rhs);
-inline Vector2 operator*(const Vector2& lhs, const Vector2& rhs);
-inline Vector2 operator/(const Vector2& lhs, const Vector2& rhs);
+constexpr Vector2 operator+(const Vector2& lhs, const Vector2& rhs);
+constexpr Vector2 operator-(const Vector2& lhs, const Vector2& rhs);
+constexpr Vector2 operator*(const Vector2& lhs, const Vector2& rhs);
+constexpr Vector2 operator/(const Vector2& lhs, const Vector2& rhs);
 
-inline Vector2& operator+=(Vector2& lhs, const Vector2& rhs);
-inline Vector2& operator-=(Vector2& lhs, const Vector2& rhs);
-inline Vector2& operator*=(Vector2& lhs, const Vector2& rhs);
-inline Vector2& operator/=(Vector2& lhs, const Vector2& rhs);
+constexpr Vector2& operator+=(Vector2& lhs, const Vector2& rhs);
+constexpr Vector2& operator-=(Vector2& lhs, const Vector2& rhs);
+constexpr Vector2& operator*=(Vector2& lhs, const Vector2& rhs);
+constexpr Vector2& operator/=(Vector2& lhs, const Vector2& rhs);
 
-inline Vector2 operator+(const Vector2& lhs, float32 rhs);
-inline Vector2 operator-(const Vector2& lhs, float32 rhs);
-inline Vector2 operator*(const Vector2& lhs, float32 rhs);
-inline Vector2 operator/(const Vector2& lhs, float32 rhs);
+constexpr Vector2 operator+(const Vector2& lhs, float32 rhs);
+constexpr Vector2 operator-(const Vector2& lhs, float32 rhs);
+constexpr Vector2 operator*(const Vector2& lhs, float32 rhs);
+constexpr Vector2 operator/(const Vector2& lhs, float32 rhs);
 
-inline Vector2 operator+(float32 lhs, const Vector2& rhs);
-inline Vector2 operator-(float32 lhs, const Vector2& rhs);
-inline Vector2 operator*(float32 lhs, const Vector2& rhs);
-inline Vector2 operator/(float32 lhs, const Vector2& rhs);
+constexpr Vector2 operator+(float32 lhs, const Vector2& rhs);
+constexpr Vector2 operator-(float32 lhs, const Vector2& rhs);
+constexpr Vector2 operator*(float32 lhs, const Vector2& rhs);
+constexpr Vector2 operator/(float32 lhs, const Vector2& rhs);
 
-inline Vector2& operator+=(Vector2& lhs, float32 rhs);
-inline Vector2& operator-=(Vector2& lhs, float32 rhs);
-inline Vector2& operator*=(Vector2& lhs, float32 rhs);
-inline Vector2& operator/=(Vector2& lhs, float32 rhs);
+constexpr Vector2& operator+=(Vector2& lhs, float32 rhs);
+constexpr Vector2& operator-=(Vector2& lhs, float32 rhs);
+constexpr Vector2& operator*=(Vector2& lhs, float32 rhs);
+constexpr Vector2& operator/=(Vector2& lhs, float32 rhs);
 
-inline float32 Sum(const Vector2& vec);
-inline float32 LengthSquared(const Vector2& vec);
+constexpr float32 Sum(const Vector2& vec);
+constexpr float32 LengthSquared(const Vector2& vec);
 inline float32 Length(const Vector2& vec);
 inline Vector2 Normalized(const Vector2& vec);
-inline float32 DotProduct(const Vector2& lhs, const Vector2& rhs);
+inline Vector2 FastNormalized(const Vector2& vec);
+constexpr float32 DotProduct(const Vector2& lhs, const Vector2& rhs);
 inline Radians AngleBetween(const Vector2& lhs, const Vector2& rhs);
-inline Vector2 Reflection(const Vector2& direction, const Vector2& normal);
-inline Vector2 Projection(const Vector2& source, const Vector2& target);
-inline Vector2 Rejection(const Vector2& source, const Vector2& target);
-inline Vector2 Lerp(const Vector2& source, const Vector2& target,
-					float32 portion);
-inline Vector2 Min(const Vector2& a, const Vector2& b);
-inline Vector2 Max(const Vector2& a, const Vector2& b);
-inline Vector2 Clamp(const Vector2& val, float32 min, float32 max);
-inline Vector2 Clamp(const Vector2& val, const Vector2& min,
-					 const Vector2& max);
+constexpr Vector2 Reflection(const Vector2& direction, const Vector2& normal);
+constexpr Vector2 Projection(const Vector2& source, const Vector2& target);
+constexpr Vector2 Rejection(const Vector2& source, const Vector2& target);
+constexpr Vector2 Lerp(const Vector2& source, const Vector2& target,
+					   float32 portion);
+constexpr Vector2 Min(const Vector2& a, const Vector2& b);
+constexpr Vector2 Max(const Vector2& a, const Vector2& b);
+constexpr Vector2 Clamp(const Vector2& val, float32 min, float32 max);
+constexpr Vector2 Clamp(const Vector2& val, const Vector2& min,
+						const Vector2& max);
 }
 }
 
@@ -17,7 +17,7 @@ struct Vector3
 	Vector3(Vector3&& rhs) = default;
 	Vector3& operator=(const Vector3& rhs) = default;
 	Vector3& operator=(Vector3&& rhs) = default;
-	inline Vector3(float32 _x, float32 _y, float32 _z);
+	constexpr Vector3(float32 _x, float32 _y, float32 _z);
 
 	// In C++, POD types cannot have member initializers
 	union {
@@ -44,53 +44,54 @@ struct Vector3
 	static const Vector3 Unit;
 };
 
-inline bool operator==(const Vector3& lhs, const Vector3& rhs);
-inline bool operator!=(const Vector3& lhs, const Vector3& rhs);
+constexpr bool operator==(const Vector3& lhs, const Vector3& rhs);
+constexpr bool operator!=(const Vector3& lhs, const Vector3& rhs);
 
-inline Vector3 operator-(const Vector3& vec);
+constexpr Vector3 operator-(const Vector3& vec);
 
-inline Vector3 operator+(const Vector3& lhs, const Vector3& rhs);
-inline Vector3 operator-(const Vector3& lhs, const Vector3& rhs);
-inline Vector3 operator*(const Vector3& lhs, const Vector3& rhs);
-inline Vector3 operator/(const Vector3& lhs, const Vector3& rhs);
+constexpr Vector3 operator+(const Vector3& lhs, const Vector3& rhs);
+constexpr Vector3 operator-(const Vector3& lhs, const Vector3& rhs);
+constexpr Vector3 operator*(const Vector3& lhs, const Vector3& rhs);
+constexpr Vector3 operator/(const Vector3& lhs, const Vector3& rhs);
 
-inline Vector3& operator+=(Vector3& lhs, const Vector3& rhs);
-inline Vector3& operator-=(Vector3& lhs, const Vector3& rhs);
-inline Vector3& operator*=(Vector3& lhs, const Vector3& rhs);
-inline Vector3& operator/=(Vector3& lhs, const Vector3& rhs);
+constexpr Vector3& operator+=(Vector3& lhs, const Vector3& rhs);
+constexpr Vector3& operator-=(Vector3& lhs, const Vector3& rhs);
+constexpr Vector3& operator*=(Vector3& lhs, const Vector3& rhs);
+constexpr Vector3& operator/=(Vector3& lhs, const Vector3& rhs);
 
-inline Vector3 operator+(const Vector3& lhs, float32 rhs);
-inline Vector3 operator-(const Vector3& lhs, float32 rhs);
-inline Vector3 operator*(const Vector3& lhs, float32 rhs);
-inline Vector3 operator/(const Vector3& lhs, float32 rhs);
+constexpr Vector3 operator+(const Vector3& lhs, float32 rhs);
+constexpr Vector3 operator-(const Vector3& lhs, float32 rhs);
+constexpr Vector3 operator*(const Vector3& lhs, float32 rhs);
+constexpr Vector3 operator/(const Vector3& lhs, float32 rhs);
 
-inline Vector3 operator+(float32 lhs, const Vector3& rhs);
-inline Vector3 operator-(float32 lhs, const Vector3& rhs);
-inline Vector3 operator*(float32 lhs, const Vector3& rhs);
-inline Vector3 operator/(float32 lhs, const Vector3& rhs);
+constexpr Vector3 operator+(float32 lhs, const Vector3& rhs);
+constexpr Vector3 operator-(float32 lhs, const Vector3& rhs);
+constexpr Vector3 operator*(float32 lhs, const Vector3& rhs);
+constexpr Vector3 operator/(float32 lhs, const Vector3& rhs);
 
-inline Vector3& operator+=(Vector3& lhs, float32 rhs);
-inline Vector3& operator-=(Vector3& lhs, float32 rhs);
-inline Vector3& operator*=(Vector3& lhs, float32 rhs);
-inline Vector3& operator/=(Vector3& lhs, float32 rhs);
+constexpr Vector3& operator+=(Vector3& lhs, float32 rhs);
+constexpr Vector3& operator-=(Vector3& lhs, float32 rhs);
+constexpr Vector3& operator*=(Vector3& lhs, float32 rhs);
+constexpr Vector3& operator/=(Vector3& lhs, float32 rhs);
 
-inline float32 Sum(const Vector3& vec);
-inline float32 LengthSquared(const Vector3& vec);
+constexpr float32 Sum(const Vector3& vec);
+constexpr float32 LengthSquared(const Vector3& vec);
 inline float32 Length(const Vector3& vec);
 inline Vector3 Normalized(const Vector3& vec);
-inline float32 DotProduct(const Vector3& lhs, const Vector3& rhs);
-inline Vector3 CrossProduct(const Vector3& lhs, const Vector3& rhs);
+inline Vector3 FastNormalized(const Vector3& vec);
+constexpr float32 DotProduct(const Vector3& lhs, const Vector3& rhs);
+constexpr Vector3 CrossProduct(const Vector3& lhs, const Vector3& rhs);
 inline Radians AngleBetween(const Vector3& lhs, const Vector3& rhs);
-inline Vector3 Reflection(const Vector3& direction, const Vector3& normal);
-inline Vector3 Projection(const Vector3& source, const Vector3& target);
-inline Vector3 Rejection(const Vector3& source, const Vector3& target);
-inline Vector3 Lerp(const Vector3& source, const Vector3& target,
-					float32 portion);
-inline Vector3 Min(const Vector3& a, const Vector3& b);
-inline Vector3 Max(const Vector3& a, const Vector3& b);
-inline Vector3 Clamp(const Vector3& val, float32 min, float32 max);
-inline Vector3 Clamp(const Vector3& val, const Vector3& min,
-					 const Vector3& max);
+constexpr Vector3 Reflection(const Vector3& direction, const Vector3& normal);
+constexpr Vector3 Projection(const Vector3& source, const Vector3& target);
+constexpr Vector3 Rejection(const Vector3& source, const Vector3& target);
+constexpr Vector3 Lerp(const Vector3& source, const Vector3& target,
+					   float32 portion);
+constexpr Vector3 Min(const Vector3& a, const Vector3& b);
+constexpr Vector3 Max(const Vector3& a, const Vector3& b);
+constexpr Vector3 Clamp(const Vector3& val, float32 min, float32 max);
+constexpr Vector3 Clamp(const Vector3& val, const Vector3& min,
+						const Vector3& max);
 }
 }
 
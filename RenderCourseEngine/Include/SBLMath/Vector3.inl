@@ -6,11 +6,21 @@ namespace SBL
 {
 namespace Math
 {
-inline Vector3::Vector3(float32 _x, float32 _y, float32 _z)
+constexpr Vector3::Vector3(float32 _x, float32 _y, float32 _z)
 	: x(_x), y(_y), z(_z)
 {
 }
 
+inline constexpr Vector3 Vector3::Zero{0.0f, 0.0f, 0.0f};
+inline constexpr Vector3 Vector3::One{1.0f, 1.0f, 1.0f};
+inline constexpr Vector3 Vector3::Up{0.0f, 1.0f, 0.0f};
+inline constexpr Vector3 Vector3::Down{0.0f, -1.0f, 0.0f};
+inline constexpr Vector3 Vector3::Left{-1.0f, 0.0f, 0.0f};
+inline constexpr Vector3 Vector3::Right{1.0f, 0.0f, 0.0f};
+inline constexpr Vector3 Vector3::In{0.0f, 0.0f, -1.0f};
+inline constexpr Vector3 Vector3::Out{0.0f, 0.0f, 1.0f};
+inline constexpr Vector3 Vector3::Unit{0.577350f, 0.577350f, 0.577350f};
+
 inline float32& Vector3::operator[](std::size_t index)
 {
 	return values[index];
@@ -21,42 +31,42 @@ inline const float32& Vector3::operator[](std::size_t index) const
 	return values[index];
 }
 
-inline bool operator==(const Vector3& lhs, const Vector3& rhs)
+constexpr bool operator==(const Vector3& lhs, const Vector3& rhs)
 {
 	return Equals(lhs.x, rhs.x) && Equals(lhs.y, rhs.y) && Equals(lhs.z, rhs.z);
 }
 
-inline bool operator!=(const Vector3& lhs, const Vector3& rhs)
+constexpr bool operator!=(const Vector3& lhs, const Vector3& rhs)
 {
 	return !(lhs == rhs);
 }
 
-inline Vector3 operator-(const Vector3& vec)
+constexpr Vector3 operator-(const Vector3& vec)
 {
 	return Vector3{-vec.x, -vec.y, -vec.z};
 }
 
-inline Vector3 operator+(const Vector3& lhs, const Vector3& rhs)
+constexpr Vector3 operator+(const Vector3& lhs, const Vector3& rhs)
 {
 	return Vector3{lhs.x + rhs.x, lhs.y + rhs.y, lhs.z + rhs.z};
 }
 
-inline Vector3 operator-(const Vector3& lhs, const Vector3& rhs)
+constexpr Vector3 operator-(const Vector3& lhs, const Vector3& rhs)
 {
 	return Vector3{lhs.x - rhs.x, lhs.y - rhs.y, lhs.z - rhs.z};
 }
 
-inline Vector3 operator*(const Vector3& lhs, const Vector3& rhs)
+constexpr Vector3 operator*(const Vector3& lhs, const Vector3& rhs)
 {
 	return Vector3{lhs.x * rhs.x, lhs.y * rhs.y, lhs.z * rhs.z};
 }
 
-inline Vector3 operator/(const Vector3& lhs, const Vector3& rhs)
+constexpr Vector3 operator/(const Vector3& lhs, const Vector3& rhs)
 {
 	return Vector3{lhs.x / rhs.x, lhs.y / rhs.y, lhs.z / rhs.z};
 }
 
-inline Vector3& operator+=(Vector3& lhs, const Vector3& rhs)
+constexpr Vector3& operator+=(Vector3& lhs, const Vector3& rhs)
 {
 	lhs.x += rhs.x;
 	lhs.y += rhs.y;
@@ -64,7 +74,7 @@ inline Vector3& operator+=(Vector3& lhs, const Vector3& rhs)
 	return lhs;
 }
 
-inline Vector3& operator-=(Vector3& lhs, const Vector3& rhs)
+constexpr Vector3& operator-=(Vector3& lhs, const Vector3& rhs)
 {
 	lhs.x -= rhs.x;
 	lhs.y -= rhs.y;
@@ -72,7 +82,7 @@ inline Vector3& operator-=(Vector3& lhs, const Vector3& rhs)
 	return lhs;
 }
 
-inline Vector3& operator*=(Vector3& lhs, const Vector3& rhs)
+constexpr Vector3& operator*=(Vector3& lhs, const Vector3& rhs)
 {
 	lhs.x *= rhs.x;
 	lhs.y *= rhs.y;
@@ -80,7 +90,7 @@ inline Vector3& operator*=(Vector3& lhs, const Vector3& rhs)
 	return lhs;
 }
 
-inline Vector3& operator/=(Vector3& lhs, const Vector3& rhs)
+constexpr Vector3& operator/=(Vector3& lhs, const Vector3& rhs)
 {
 	lhs.x /= rhs.x;
 	lhs.y /= rhs.y;
@@ -88,47 +98,47 @@ inline Vector3& operator/=(Vector3& lhs, const Vector3& rhs)
 	return lhs;
 }
 
-inline Vector3 operator+(const Vector3& lhs, float32 rhs)
+constexpr Vector3 operator+(const Vector3& lhs, float32 rhs)
 {
 	return Vector3{lhs.x + rhs, lhs.y + rhs, lhs.z + rhs};
 }
 
-inline Vector3 operator-(const Vector3& lhs, float32 rhs)
+constexpr Vector3 operator-(const Vector3& lhs, float32 rhs)
 {
 	return Vector3{lhs.x - rhs, lhs.y - rhs, lhs.z - rhs};
 }
 
-inline Vector3 operator*(const Vector3& lhs, float32 rhs)
+constexpr Vector3 operator*(const Vector3& lhs, float32 rhs)
 {
 	return Vector3{lhs.x * rhs, lhs.y * rhs, lhs.z * rhs};
 }
 
-inline Vector3 operator/(const Vector3& lhs, float32 rhs)
+constexpr Vector3 operator/(const Vector3& lhs, float32 rhs)
 {
 	return Vector3{lhs.x / rhs, lhs.y / rhs, lhs.z / rhs};
 }
 
-inline Vector3 operator+(float32 lhs, const Vector3& rhs)
+constexpr Vector3 operator+(float32 lhs, const Vector3& rhs)
 {
 	return Vector3{lhs + rhs.x, lhs + rhs.y, lhs + rhs.z};
 }
 
-inline Vector3 operator-(float32 lhs, const Vector3& rhs)
+constexpr Vector3 operator-(float32 lhs, const Vector3& rhs)
 {
 	return Vector3{lhs - rhs.x, lhs - rhs.y, lhs - rhs.z};
 }
 
-inline Vector3 operator*(float32 lhs, const Vector3& rhs)
+constexpr Vector3 operator*(float32 lhs, const Vector3& rhs)
 {
 	return Vector3{lhs * rhs.x, lhs * rhs.y, lhs * rhs.z};
 }
 
-inline Vector3 operator/(float32 lhs, const Vector3& rhs)
+constexpr Vector3 operator/(float32 lhs, const Vector3& rhs)
 {
 	return Vector3{lhs / rhs.x, lhs / rhs.y, lhs / rhs.z};
 }
 
-inline Vector3& operator+=(Vector3& lhs, float32 rhs)
+constexpr Vector3& operator+=(Vector3& lhs, float32 rhs)
 {
 	lhs.x += rhs;
 	lhs.y += rhs;
@@ -136,7 +146,7 @@ inline Vector3& operator+=(Vector3& lhs, float32 rhs)
 	return lhs;
 }
 
-inline Vector3& operator-=(Vector3& lhs, float32 rhs)
+constexpr Vector3& operator-=(Vector3& lhs, float32 rhs)
 {
 	lhs.x -= rhs;
 	lhs.y -= rhs;
@@ -144,7 +154,7 @@ inline Vector3& operator-=(Vector3& lhs, float32 rhs)
 	return lhs;
 }
 
-inline Vector3& operator*=(Vector3& lhs, float32 rhs)
+constexpr Vector3& operator*=(Vector3& lhs, float32 rhs)
 {
 	lhs.x *= rhs;
 	lhs.y *= rhs;
@@ -152,7 +162,7 @@ inline Vector3& operator*=(Vector3& lhs, float32 rhs)
 	return lhs;
 }
 
-inline Vector3& operator/=(Vector3& lhs, float32 rhs)
+constexpr Vector3& operator/=(Vector3& lhs, float32 rhs)
 {
 	lhs.x /= rhs;
 	lhs.y /= rhs;
@@ -160,12 +170,12 @@ inline Vector3& operator/=(Vector3& lhs, float32 rhs)
 	return lhs;
 }
 
-inline float32 Sum(const Vector3& vec)
+constexpr float32 Sum(const Vector3& vec)
 {
 	return vec.x + vec.y + vec.z;
 }
 
-inline float32 LengthSquared(const Vector3& vec)
+constexpr float32 LengthSquared(const Vector3& vec)
 {
 	return vec.x*vec.x + vec.y*vec.y + vec.z*vec.z;
 }
@@ -177,15 +187,24 @@ inline float32 Length(const Vector3& vec)
 
 inline Vector3 Normalized(const Vector3& vec)
 {
+#ifdef SBL_MATH_FAST_MATH
+	return FastNormalized(vec);
+#else
 	return vec / Length(vec);
+#endif
+}
+
+inline Vector3 FastNormalized(const Vector3& vec)
+{
+	return vec * FastInverseSqrt(LengthSquared(vec));
 }
 
-inline float32 DotProduct(const Vector3& lhs, const Vector3& rhs)
+constexpr float32 DotProduct(const Vector3& lhs, const Vector3& rhs)
 {
 	return lhs.x * rhs.x + lhs.y * rhs.y + lhs.z * rhs.z;
 }
 
-inline Vector3 CrossProduct(const Vector3& lhs, const Vector3& rhs)
+constexpr Vector3 CrossProduct(const Vector3& lhs, const Vector3& rhs)
 {
 	return Vector3(
 		lhs.y * rhs.z - lhs.z * rhs.y,
@@ -199,7 +218,7 @@ inline Radians AngleBetween(const Vector3& lhs, const Vector3& rhs)
 	return acosf(DotProduct(lhs, rhs) / (Length(lhs) * Length(rhs)));
 }
 
-inline Vector3 Reflection(const Vector3& direction, const Vector3& normal)
+constexpr Vector3 Reflection(const Vector3& direction, const Vector3& normal)
 {
  	/*d    n    r      
            ^	
@@ -226,40 +245,40 @@ inline Vector3 Reflection(const Vector3& direction, const Vector3& normal)
 	return direction - 2 * DotProduct(direction, normal) * normal;
 }
 
-inline Vector3 Projection(const Vector3& source, const Vector3& target)
+constexpr Vector3 Projection(const Vector3& source, const Vector3& target)
 {
 	return DotProduct(source, target) * target;
 }
 
-inline Vector3 Rejection(const Vector3& source, const Vector3& target)
+constexpr Vector3 Rejection(const Vector3& source, const Vector3& target)
 {
 	return source - Projection(source, target);
 }
 
-inline Vector3 Lerp(const Vector3& source, const Vector3& target,
-					float32 portion)
+constexpr Vector3 Lerp(const Vector3& source, const Vector3& target,
+					   float32 portion)
 {
 	return source + ((target - source) * portion);
 }
 
-inline Vector3 Min(const Vector3& a, const Vector3& b)
+constexpr Vector3 Min(const Vector3& a, const Vector3& b)
 {
 	return {std::min(a.x, b.x), std::min(a.y, b.y), std::min(a.z, b.z)};
 }
 
-inline Vector3 Max(const Vector3& a, const Vector3& b)
+constexpr Vector3 Max(const Vector3& a, const Vector3& b)
 {
 	return {std::max(a.x, b.x), std::max(a.y, b.y), std::max(a.z, b.z)};
 }
 
-inline Vector3 Clamp(const Vector3& val, float32 min, float32 max)
+constexpr Vector3 Clamp(const Vector3& val, float32 min, float32 max)
 {
 	return {
 		Clamp(val.x, min, max), Clamp(val.y, min, max), Clamp(val.z, min, max),
 	};
 }
 
-inline Vector3 Clamp(const Vector3& val, const Vector3& min, const Vector3& max)
+constexpr Vector3 Clamp(const Vector3& val, const Vector3& min, const Vector3& max)
 {
 	return {
 		Clamp(val.x, min.x, max.x), Clamp(val.y, min.y, max.y),
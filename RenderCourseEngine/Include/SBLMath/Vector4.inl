@@ -7,7 +7,7 @@ namespace SBL
 namespace Math
 {
 
-inline Vector4::Vector4(const Vector3& rhs, float _w)
+constexpr Vector4::Vector4(const Vector3& rhs, float _w)
 	: x(rhs.x), y(rhs.y), z(rhs.z), w(_w)
 {
 }
@@ -18,6 +18,16 @@ constexpr inline Vector4::Vector4(float32 _x, float32 _y, float32 _z,
 {
 }
 
+inline constexpr Vector4 Vector4::Zero{0.0f, 0.0f, 0.0f, 0.0f};
+inline constexpr Vector4 Vector4::One{1.0f, 1.0f, 1.0f, 1.0f};
+inline constexpr Vector4 Vector4::Up{0.0f, 1.0f, 0.0f, 0.0f};
+inline constexpr Vector4 Vector4::Down{0.0f, -1.0f, 0.0f, 0.0f};
+inline constexpr Vector4 Vector4::Left{-1.0f, 0.0f, 0.0f, 0.0f};
+inline constexpr Vector4 Vector4::Right{1.0f, 0.0f, 0.0f, 0.0f};
+inline constexpr Vector4 Vector4::In{0.0f, 0.0f, -1.0f, 0.0f};
+inline constexpr Vector4 Vector4::Out{0.0f, 0.0f, 1.0f, 0.0f};
+inline constexpr Vector4 Vector4::Unit{0.5f, 0.5f, 0.5f, 0.5f};
+
 inline float32& Vector4::operator[](std::size_t index)
 {
 	return values[index];
@@ -28,43 +38,93 @@ inline const float32& Vector4::operator[](std::size_t index) const
 	return values[index];
 }
 
-inline bool operator==(const Vector4& lhs, const Vector4& rhs)
+#if SBL_MATH_SIMD_SSE
+namespace Simd
+{
+inline __m128 Load(const Vector4& vec)
+{
+	return _mm_loadu_ps(vec.values);
+}
+
+inline Vector4 Store(__m128 value)
+{
+	Vector4 res;
+	_mm_storeu_ps(res.values, value);
+	return res;
+}
+
+inline float32 DotProduct(const Vector4& lhs, const Vector4& rhs)
+{
+	__m128 products = _mm_mul_ps(Load(lhs), Load(rhs));
+	__m128 swapped = _mm_shuffle_ps(products, products, _MM_SHUFFLE(2, 3, 0, 1));
+	__m128 pairs = _mm_add_ps(products, swapped);
+	swapped = _mm_movehl_ps(swapped, pairs);
+	return _mm_cvtss_f32(_mm_add_ss(pairs, swapped));
+}
+}
+#endif
+
+constexpr bool operator==(const Vector4& lhs, const Vector4& rhs)
 {
 	return Equals(lhs.x, rhs.x) && Equals(lhs.y, rhs.y) &&
 		   Equals(lhs.z, rhs.z) && Equals(lhs.w, rhs.w);
 }
 
-inline bool operator!=(const Vector4& lhs, const Vector4& rhs)
+constexpr bool operator!=(const Vector4& lhs, const Vector4& rhs)
 {
 	return !(lhs == rhs);
 }
 
-inline Vector4 operator-(const Vector4& vec)
+constexpr Vector4 operator-(const Vector4& vec)
 {
 	return Vector4{-vec.x, -vec.y, -vec.z, -vec.w};
 }
 
-inline Vector4 operator+(const Vector4& lhs, const Vector4& rhs)
+constexpr Vector4 operator+(const Vector4& lhs, const Vector4& rhs)
 {
+#if SBL_MATH_SIMD_SSE
+	if (!IsConstantEvaluated())
+	{
+		return Simd::Store(_mm_add_ps(Simd::Load(lhs), Simd::Load(rhs)));
+	}
+#endif
 	return Vector4{lhs.x + rhs.x, lhs.y + rhs.y, lhs.z + rhs.z, lhs.w + rhs.w};
 }
 
-inline Vector4 operator-(const Vector4& lhs, const Vector4& rhs)
+constexpr Vector4 operator-(const Vector4& lhs, const Vector4& rhs)
 {
+#if SBL_MATH_SIMD_SSE
+	if (!IsConstantEvaluated())
+	{
+		return Simd::Store(_mm_sub_ps(Simd::Load(lhs), Simd::Load(rhs)));
+	}
+#endif
 	return Vector4{lhs.x - rhs.x, lhs.y - rhs.y, lhs.z - rhs.z, lhs.w - rhs.w};
 }
 
-inline Vector4 operator*(const Vector4& lhs, const Vector4& rhs)
+constexpr Vector4 operator*(const Vector4& lhs, const Vector4& rhs)
 {
+#if SBL_MATH_SIMD_SSE
+	if (!IsConstantEvaluated())
+	{
+		return Simd::Store(_mm_mul_ps(Simd::Load(lhs), Simd::Load(rhs)));
+	}
+#endif
 	return Vector4{lhs.x * rhs.x, lhs.y * rhs.y, lhs.z * rhs.z, lhs.w * rhs.w};
 }
 
-inline Vector4 operator/(const Vector4& lhs, const Vector4& rhs)
+constexpr Vector4 operator/(const Vector4& lhs, const Vector4& rhs)
 {
+#if SBL_MATH_SIMD_SSE
+	if (!IsConstantEvaluated())
+	{
+		return Simd::Store(_mm_div_ps(Simd::Load(lhs), Simd::Load(rhs)));
+	}
+#endif
 	return Vector4{lhs.x / rhs.x, lhs.y / rhs.y, lhs.z / rhs.z, lhs.w / rhs.w};
 }
 
-inline Vector4& operator+=(Vector4& lhs, const Vector4& rhs)
+constexpr Vector4& operator+=(Vector4& lhs, const Vector4& rhs)
 {
 	lhs.x += rhs.x;
 	lhs.y += rhs.y;
@@ -73,7 +133,7 @@ inline Vector4& operator+=(Vector4& lhs, const Vector4& rhs)
 	return lhs;
 }
 
-inline Vector4& operator-=(Vector4& lhs, const Vector4& rhs)
+constexpr Vector4& operator-=(Vector4& lhs, const Vector4& rhs)
 {
 	lhs.x -= rhs.x;
 	lhs.y -= rhs.y;
@@ -82,7 +142,7 @@ inline Vector4& operator-=(Vector4& lhs, const Vector4& rhs)
 	return lhs;
 }
 
-inline Vector4& operator*=(Vector4& lhs, const Vector4& rhs)
+constexpr Vector4& operator*=(Vector4& lhs, const Vector4& rhs)
 {
 	lhs.x *= rhs.x;
 	lhs.y *= rhs.y;
@@ -91,7 +151,7 @@ inline Vector4& operator*=(Vector4& lhs, const Vector4& rhs)
 	return lhs;
 }
 
-inline Vector4& operator/=(Vector4& lhs, const Vector4& rhs)
+constexpr Vector4& operator/=(Vector4& lhs, const Vector4& rhs)
 {
 	lhs.x /= rhs.x;
 	lhs.y /= rhs.y;
@@ -100,47 +160,47 @@ inline Vector4& operator/=(Vector4& lhs, const Vector4& rhs)
 	return lhs;
 }
 
-inline Vector4 operator+(const Vector4& lhs, float32 rhs)
+constexpr Vector4 operator+(const Vector4& lhs, float32 rhs)
 {
 	return Vector4{lhs.x + rhs, lhs.y + rhs, lhs.z + rhs, lhs.w + rhs};
 }
 
-inline Vector4 operator-(const Vector4& lhs, float32 rhs)
+constexpr Vector4 operator-(const Vector4& lhs, float32 rhs)
 {
 	return Vector4{lhs.x - rhs, lhs.y - rhs, lhs.z - rhs, lhs.w - rhs};
 }
 
-inline Vector4 operator*(const Vector4& lhs, float32 rhs)
+constexpr Vector4 operator*(const Vector4& lhs, float32 rhs)
 {
 	return Vector4{lhs.x * rhs, lhs.y * rhs, lhs.z * rhs, lhs.w * rhs};
 }
 
-inline Vector4 operator/(const Vector4& lhs, float32 rhs)
+constexpr Vector4 operator/(const Vector4& lhs, float32 rhs)
 {
 	return Vector4{lhs.x / rhs, lhs.y / rhs, lhs.z / rhs, lhs.w / rhs};
 }
 
-inline Vector4 operator+(float32 lhs, const Vector4& rhs)
+constexpr Vector4 operator+(float32 lhs, const Vector4& rhs)
 {
 	return Vector4{lhs + rhs.x, lhs + rhs.y, lhs + rhs.z, lhs + rhs.w};
 }
 
-inline Vector4 operator-(float32 lhs, const Vector4& rhs)
+constexpr Vector4 operator-(float32 lhs, const Vector4& rhs)
 {
 	return Vector4{lhs - rhs.x, lhs - rhs.y, lhs - rhs.z, lhs - rhs.w};
 }
 
-inline Vector4 operator*(float32 lhs, const Vector4& rhs)
+constexpr Vector4 operator*(float32 lhs, const Vector4& rhs)
 {
 	return Vector4{lhs * rhs.x, lhs * rhs.y, lhs * rhs.z, lhs * rhs.w};
 }
 
-inline Vector4 operator/(float32 lhs, const Vector4& rhs)
+constexpr Vector4 operator/(float32 lhs, const Vector4& rhs)
 {
 	return Vector4{lhs / rhs.x, lhs / rhs.y, lhs / rhs.z, lhs / rhs.w};
 }
 
-inline Vector4& operator+=(Vector4& lhs, float32 rhs)
+constexpr Vector4& operator+=(Vector4& lhs, float32 rhs)
 {
 	lhs.x += rhs;
 	lhs.y += rhs;
@@ -149,7 +209,7 @@ inline Vector4& operator+=(Vector4& lhs, float32 rhs)
 	return lhs;
 }
 
-inline Vector4& operator-=(Vector4& lhs, float32 rhs)
+constexpr Vector4& operator-=(Vector4& lhs, float32 rhs)
 {
 	lhs.x -= rhs;
 	lhs.y -= rhs;
@@ -158,16 +218,16 @@ inline Vector4& operator-=(Vector4& lhs, float32 rhs)
 	return lhs;
 }
 
-inline Vector4& operator*=(Vector4& lhs, float32 rhs)
+constexpr Vector4& operator*=(Vector4& lhs, float32 rhs)
 {
 	lhs.x *= rhs;
 	lhs.y *= rhs;
 	lhs.z *= rhs;
-	lhs.z *= rhs;
+	lhs.w *= rhs;
 	return lhs;
 }
 
-inline Vector4& operator/=(Vector4& lhs, float32 rhs)
+constexpr Vector4& operator/=(Vector4& lhs, float32 rhs)
 {
 	lhs.x /= rhs;
 	lhs.y /= rhs;
@@ -176,12 +236,12 @@ inline Vector4& operator/=(Vector4& lhs, float32 rhs)
 	return lhs;
 }
 
-inline float32 Sum(const Vector4& vec)
+constexpr float32 Sum(const Vector4& vec)
 {
 	return vec.x + vec.y + vec.z + vec.w;
 }
 
-inline float32 LengthSquared(const Vector4& vec)
+constexpr float32 LengthSquared(const Vector4& vec)
 {
 	return vec.x * vec.x + vec.y * vec.y + vec.z * vec.z + vec.w * vec.w;
 }
@@ -193,11 +253,26 @@ inline float32 Length(const Vector4& vec)
 
 inline Vector4 Normalized(const Vector4& vec)
 {
+#ifdef SBL_MATH_FAST_MATH
+	return FastNormalized(vec);
+#else
 	return vec / Length(vec);
+#endif
 }
 
-inline float32 DotProduct(const Vector4& lhs, const Vector4& rhs)
+inline Vector4 FastNormalized(const Vector4& vec)
+{
+	return vec * FastInverseSqrt(LengthSquared(vec));
+}
+
+constexpr float32 DotProduct(const Vector4& lhs, const Vector4& rhs)
 {
+#if SBL_MATH_SIMD_SSE
+	if (!IsConstantEvaluated())
+	{
+		return Simd::DotProduct(lhs, rhs);
+	}
+#endif
 	return lhs.x * rhs.x +
 		lhs.y * rhs.y +
 		lhs.z * rhs.z +
@@ -209,40 +284,40 @@ inline Radians AngleBetween(const Vector4& lhs, const Vector4& rhs)
 	return acos(DotProduct(lhs, rhs) / (Length(lhs) * Length(rhs)));
 }
 
-inline Vector4 Reflection(const Vector4& direction, const Vector4& normal)
+constexpr Vector4 Reflection(const Vector4& direction, const Vector4& normal)
 {
 	return direction - 2 * DotProduct(direction, normal) * normal;
 }
 
-inline Vector4 Projection(const Vector4& source, const Vector4& target)
+constexpr Vector4 Projection(const Vector4& source, const Vector4& target)
 {
 	return DotProduct(source, target) * target;
 }
 
-inline Vector4 Rejection(const Vector4& source, const Vector4& target)
+constexpr Vector4 Rejection(const Vector4& source, const Vector4& target)
 {
 	return source - Projection(source, target);
 }
 
-inline Vector4 Lerp(const Vector4& source, const Vector4& target,
-					float32 portion)
+constexpr Vector4 Lerp(const Vector4& source, const Vector4& target,
+					   float32 portion)
 {
 	return source + ((target - source) * portion);
 }
 
-inline Vector4 Min(const Vector4& a, const Vector4& b)
+constexpr Vector4 Min(const Vector4& a, const Vector4& b)
 {
 	return {std::min(a.x, b.x), std::min(a.y, b.y), std::min(a.z, b.z),
 			std::min(a.w, b.w)};
 }
 
-inline Vector4 Max(const Vector4& a, const Vector4& b)
+constexpr Vector4 Max(const Vector4& a, const Vector4& b)
 {
 	return {std::max(a.x, b.x), std::max(a.y, b.y), std::max(a.z, b.z),
 			std::max(a.w, b.w)};
 }
 
-inline Vector4 Clamp(const Vector4& val, float32 min, float32 max)
+constexpr Vector4 Clamp(const Vector4& val, float32 min, float32 max)
 {
 	return {
 		Clamp(val.x, min, max), Clamp(val.y, min, max), Clamp(val.z, min, max),
@@ -250,7 +325,7 @@ inline Vector4 Clamp(const Vector4& val, float32 min, float32 max)
 	};
 }
 
-inline Vector4 Clamp(const Vector4& val, const Vector4& min, const Vector4& max)
+constexpr Vector4 Clamp(const Vector4& val, const Vector4& min, const Vector4& max)
 {
 	return {
 		Clamp(val.x, min.x, max.x), Clamp(val.y, min.y, max.y),
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+// Minimal self-registering benchmark runner. A benchmark is a void function
+// declared with SBL_BENCHMARK; it times its kernels with Measure and prints
+// the results. Pass a substring of a benchmark name to run only those, and
+// --smoke to run every kernel once (used by ctest to keep them compiling and
+// running).
+
+namespace SBL
+{
+namespace Benchmark
+{
+struct BenchmarkCase
+{
+	const char* name;
+	void (*function)();
+};
+
+inline std::vector<BenchmarkCase>& Registry()
+{
+	static std::vector<BenchmarkCase> benchmarks;
+	return benchmarks;
+}
+
+inline bool& SmokeMode()
+{
+	static bool smoke = false;
+	return smoke;
+}
+
+struct Registrar
+{
+	Registrar(const char* name, void (*function)())
+	{
+		Registry().push_back({name, function});
+	}
+};
+
+// Keeps the optimizer from discarding a result that is never read.
+template <typename T> inline void DoNotOptimize(const T& value)
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+	static volatile const void* sink;
+	sink = &value;
+	_ReadWriteBarrier();
+#else
+	asm volatile("" : : "r"(&value) : "memory");
+#endif
+}
+
+struct Result
+{
+	const char* name;
+	double nanosecondsPerItem;
+};
+
+// Calls function() until at least 200 ms have passed, best of three rounds.
+// Every call is expected to process itemsPerCall items.
+template <typename Function>
+Result Measure(const char* name, std::size_t itemsPerCall, Function&& function)
+{
+	using Clock = std::chrono::steady_clock;
+
+	function();
+	if (SmokeMode())
+	{
+		std::printf("  %-40s ran\n", name);
+		return {name, 0.0};
+	}
+
+	double best = 0.0;
+	for (int round = 0; round < 3; ++round)
+	{
+		std::size_t calls = 0;
+		const Clock::time_point start = Clock::now();
+		Clock::duration elapsed;
+		do
+		{
+			function();
+			++calls;
+			elapsed = Clock::now() - start;
+		} while (elapsed < std::chrono::milliseconds(200));
+
+		const double nanoseconds =
+			std::chrono::duration<double, std::nano>(elapsed).count() /
+			(static_cast<double>(calls) * static_cast<double>(itemsPerCall));
+		if (round == 0 || nanoseconds < best)
+		{
+			best = nanoseconds;
+		}
+	}
+
+	std::printf("  %-40s %10.2f ns/item %10.2f M items/s\n", name, best,
+				1e3 / best);
+	return {name, best};
+}
+
+inline void ReportSpeedup(const Result& baseline, const Result& candidate)
+{
+	if (SmokeMode())
+	{
+		return;
+	}
+	std::printf("  %-40s %10.2fx vs %s\n", candidate.name,
+				baseline.nanosecondsPerItem / candidate.nanosecondsPerItem,
+				baseline.name);
+}
+
+inline int RunAll(int argc, char** argv)
+{
+	const char* filter = nullptr;
+	for (int i = 1; i < argc; ++i)
+	{
+		if (std::strcmp(argv[i], "--smoke") == 0)
+		{
+			SmokeMode() = true;
+		}
+		else
+		{
+			filter = argv[i];
+		}
+	}
+
+	for (const BenchmarkCase& benchmark : Registry())
+	{
+		if (filter && !std::strstr(benchmark.name, filter))
+		{
+			continue;
+		}
+		std::printf("%s\n", benchmark.name);
+		benchmark.function();
+	}
+	return 0;
+}
+}
+}
+
+#define SBL_BENCHMARK(name)                                                    \
+	static void name();                                                        \
+	static ::SBL::Benchmark::Registrar name##Registrar(#name, &name);          \
+	static void name()
@@ -0,0 +1,105 @@
+#include "Benchmark.hpp"
+
+#include "../Tests/MathHelpers.hpp"
+
+#include <SBLMath/Common.hpp>
+#include <SBLMath/Vector3.hpp>
+
+#include <cmath>
+#include <vector>
+
+using namespace SBL::Math;
+using SBL::Benchmark::DoNotOptimize;
+using SBL::Benchmark::Measure;
+using SBL::Benchmark::ReportSpeedup;
+
+namespace
+{
+constexpr std::size_t ValueCount = 4096;
+
+std::vector<float32> RandomValues(float32 min, float32 max)
+{
+	SBL::Test::Random random(61);
+	std::vector<float32> values(ValueCount);
+	for (float32& value : values)
+	{
+		value = random.Range(min, max);
+	}
+	return values;
+}
+
+// Times function(input[i]) over the whole array.
+template <typename Function>
+SBL::Benchmark::Result MeasureUnary(const char* name,
+									const std::vector<float32>& input,
+									std::vector<float32>& out,
+									Function&& function)
+{
+	return Measure(name, ValueCount, [&] {
+		for (std::size_t i = 0; i < ValueCount; ++i)
+		{
+			out[i] = function(input[i]);
+		}
+		DoNotOptimize(out);
+	});
+}
+}
+
+SBL_BENCHMARK(FastMathTrigonometry)
+{
+	const std::vector<float32> angles = RandomValues(-10.0f, 10.0f);
+	const std::vector<float32> cosines = RandomValues(-1.0f, 1.0f);
+	std::vector<float32> out(ValueCount);
+
+	const SBL::Benchmark::Result sin =
+		MeasureUnary("std::sin", angles, out, [](float32 x) { return std::sin(x); });
+	ReportSpeedup(sin, MeasureUnary("FastSin", angles, out,
+									[](float32 x) { return FastSin(x); }));
+	const SBL::Benchmark::Result cos =
+		MeasureUnary("std::cos", angles, out, [](float32 x) { return std::cos(x); });
+	ReportSpeedup(cos, MeasureUnary("FastCos", angles, out,
+									[](float32 x) { return FastCos(x); }));
+	const SBL::Benchmark::Result acos = MeasureUnary(
+		"std::acos", cosines, out, [](float32 x) { return std::acos(x); });
+	ReportSpeedup(acos, MeasureUnary("FastArcCos", cosines, out,
+									 [](float32 x) { return FastArcCos(x); }));
+}
+
+SBL_BENCHMARK(FastMathNormalize)
+{
+	const std::vector<float32> values = RandomValues(0.01f, 100.0f);
+	std::vector<float32> out(ValueCount);
+
+	const SBL::Benchmark::Result sqrt = MeasureUnary(
+		"1 / std::sqrt", values, out,
+		[](float32 x) { return 1.0f / std::sqrt(x); });
+	ReportSpeedup(sqrt, MeasureUnary("FastInverseSqrt", values, out, [](float32 x) {
+					  return FastInverseSqrt(x);
+				  }));
+
+	SBL::Test::Random random(67);
+	std::vector<Vector3> vectors(ValueCount);
+	for (Vector3& vec : vectors)
+	{
+		vec = SBL::Test::RandomVector3(random, -100.0f, 100.0f);
+	}
+	std::vector<Vector3> normalized(ValueCount);
+
+	const SBL::Benchmark::Result precise =
+		Measure("vec / Length(vec)", ValueCount, [&] {
+			for (std::size_t i = 0; i < ValueCount; ++i)
+			{
+				normalized[i] = vectors[i] / Length(vectors[i]);
+			}
+			DoNotOptimize(normalized);
+		});
+	const SBL::Benchmark::Result fast =
+		Measure("FastNormalized(Vector3)", ValueCount, [&] {
+			for (std::size_t i = 0; i < ValueCount; ++i)
+			{
+				normalized[i] = FastNormalized(vectors[i]);
+			}
+			DoNotOptimize(normalized);
+		});
+	ReportSpeedup(precise, fast);
+}
@@ -0,0 +1,181 @@
+#include "Benchmark.hpp"
+
+#include "../Tests/MathHelpers.hpp"
+
+#include <SBLMath/Matrix44.hpp>
+
+#include <vector>
+
+using namespace SBL::Math;
+using SBL::Benchmark::DoNotOptimize;
+using SBL::Benchmark::Measure;
+
+namespace
+{
+constexpr std::size_t MatrixCount = 256;
+
+std::vector<Matrix44> RandomMatrices(std::uint32_t seed)
+{
+	SBL::Test::Random random(seed);
+	std::vector<Matrix44> matrices(MatrixCount);
+	for (Matrix44& mat : matrices)
+	{
+		mat = SBL::Test::RandomInvertible(random);
+	}
+	return matrices;
+}
+
+std::vector<Matrix44> RandomAffineMatrices(std::uint32_t seed)
+{
+	SBL::Test::Random random(seed);
+	std::vector<Matrix44> matrices(MatrixCount);
+	for (Matrix44& mat : matrices)
+	{
+		mat = SBL::Test::RandomAffine(random);
+	}
+	return matrices;
+}
+}
+
+SBL_BENCHMARK(MatrixInverse)
+{
+	const std::vector<Matrix44> matrices = RandomMatrices(1);
+	std::vector<Matrix44> out(MatrixCount);
+
+	Measure("Inverse", MatrixCount, [&] {
+		for (std::size_t i = 0; i < MatrixCount; ++i)
+		{
+			out[i] = Inverse(matrices[i]);
+		}
+		DoNotOptimize(out);
+	});
+	Measure("Adjoint", MatrixCount, [&] {
+		for (std::size_t i = 0; i < MatrixCount; ++i)
+		{
+			out[i] = Adjoint(matrices[i]);
+		}
+		DoNotOptimize(out);
+	});
+}
+
+SBL_BENCHMARK(MatrixDeterminant)
+{
+	const std::vector<Matrix44> matrices = RandomMatrices(2);
+	std::vector<float> out(MatrixCount);
+
+	Measure("Determinant", MatrixCount, [&] {
+		for (std::size_t i = 0; i < MatrixCount; ++i)
+		{
+			out[i] = Determinant(matrices[i]);
+		}
+		DoNotOptimize(out);
+	});
+}
+
+SBL_BENCHMARK(MatrixVectorMultiply)
+{
+	const std::vector<Matrix44> matrices = RandomMatrices(3);
+	std::vector<Vector4> out(MatrixCount);
+	const Vector4 point{1.0f, 2.0f, 3.0f, 1.0f};
+
+	Measure("Matrix44 * Vector4", MatrixCount, [&] {
+		for (std::size_t i = 0; i < MatrixCount; ++i)
+		{
+			out[i] = matrices[i] * point;
+		}
+		DoNotOptimize(out);
+	});
+}
+
+SBL_BENCHMARK(MatrixMultiply)
+{
+	const std::vector<Matrix44> lhs = RandomMatrices(4);
+	const std::vector<Matrix44> rhs = RandomMatrices(5);
+	std::vector<Matrix44> out(MatrixCount);
+
+	// operator* is the SIMD row-combination kernel whenever Simd.hpp picked
+	// a backend, and the same code as MultiplyReference otherwise.
+	const SBL::Benchmark::Result reference =
+		Measure("MultiplyReference", MatrixCount, [&] {
+			for (std::size_t i = 0; i < MatrixCount; ++i)
+			{
+				out[i] = MultiplyReference(lhs[i], rhs[i]);
+			}
+			DoNotOptimize(out);
+		});
+	const SBL::Benchmark::Result simd =
+		Measure(SBL_MATH_SIMD_AVX	? "operator* (AVX)"
+				: SBL_MATH_SIMD_SSE ? "operator* (SSE)"
+									: "operator* (scalar)",
+				MatrixCount, [&] {
+					for (std::size_t i = 0; i < MatrixCount; ++i)
+					{
+						out[i] = lhs[i] * rhs[i];
+					}
+					DoNotOptimize(out);
+				});
+	SBL::Benchmark::ReportSpeedup(reference, simd);
+
+	// The chain main.cpp evaluates for every object each frame.
+	const Matrix44 projection = RandomMatrices(6)[0];
+	const Matrix44 camera = RandomMatrices(7)[0];
+	Measure("projection * camera * T * R * S", MatrixCount, [&] {
+		for (std::size_t i = 0; i < MatrixCount; ++i)
+		{
+			out[i] = projection * camera * lhs[i] * rhs[i] * lhs[i];
+		}
+		DoNotOptimize(out);
+	});
+}
+
+SBL_BENCHMARK(MatrixAffine)
+{
+	const std::vector<Matrix44> lhs = RandomAffineMatrices(8);
+	const std::vector<Matrix44> rhs = RandomAffineMatrices(9);
+	std::vector<Matrix44> out(MatrixCount);
+
+	const SBL::Benchmark::Result inverse =
+		Measure("Inverse (affine input)", MatrixCount, [&] {
+			for (std::size_t i = 0; i < MatrixCount; ++i)
+			{
+				out[i] = Inverse(lhs[i]);
+			}
+			DoNotOptimize(out);
+		});
+	const SBL::Benchmark::Result affineInverse =
+		Measure("AffineInverse", MatrixCount, [&] {
+			for (std::size_t i = 0; i < MatrixCount; ++i)
+			{
+				out[i] = AffineInverse(lhs[i]);
+			}
+			DoNotOptimize(out);
+		});
+	SBL::Benchmark::ReportSpeedup(inverse, affineInverse);
+	const SBL::Benchmark::Result rigidInverse =
+		Measure("RigidInverse", MatrixCount, [&] {
+			for (std::size_t i = 0; i < MatrixCount; ++i)
+			{
+				out[i] = RigidInverse(lhs[i]);
+			}
+			DoNotOptimize(out);
+		});
+	SBL::Benchmark::ReportSpeedup(inverse, rigidInverse);
+
+	const SBL::Benchmark::Result multiply =
+		Measure("operator* (affine input)", MatrixCount, [&] {
+			for (std::size_t i = 0; i < MatrixCount; ++i)
+			{
+				out[i] = lhs[i] * rhs[i];
+			}
+			DoNotOptimize(out);
+		});
+	const SBL::Benchmark::Result affineMultiply =
+		Measure("AffineMultiply", MatrixCount, [&] {
+			for (std::size_t i = 0; i < MatrixCount; ++i)
+			{
+				out[i] = AffineMultiply(lhs[i], rhs[i]);
+			}
+			DoNotOptimize(out);
+		});
+	SBL::Benchmark::ReportSpeedup(multiply, affineMultiply);
+}
@@ -0,0 +1,133 @@
+#include "Benchmark.hpp"
+
+#include "../Tests/MathHelpers.hpp"
+
+#include <SBLMath/Quaternion.hpp>
+#include <SBLMath/Transform.hpp>
+
+#include <vector>
+
+using namespace SBL::Math;
+using SBL::Benchmark::DoNotOptimize;
+using SBL::Benchmark::Measure;
+using SBL::Benchmark::ReportSpeedup;
+
+namespace
+{
+constexpr std::size_t RotationCount = 4096;
+
+struct BlendInputs
+{
+	std::vector<Quaternion> source;
+	std::vector<Quaternion> target;
+	std::vector<float32> portions;
+};
+
+BlendInputs RandomBlendInputs()
+{
+	SBL::Test::Random random(21);
+	BlendInputs inputs;
+	for (std::size_t i = 0; i < RotationCount; ++i)
+	{
+		inputs.source.push_back(SBL::Test::RandomRotation(random));
+		inputs.target.push_back(SBL::Test::RandomRotation(random));
+		inputs.portions.push_back(random.Range(0.0f, 1.0f));
+	}
+	return inputs;
+}
+}
+
+SBL_BENCHMARK(QuaternionSlerp)
+{
+	const BlendInputs inputs = RandomBlendInputs();
+	std::vector<Quaternion> out(RotationCount);
+
+	const SBL::Benchmark::Result slerp =
+		Measure("Slerp", RotationCount, [&] {
+			for (std::size_t i = 0; i < RotationCount; ++i)
+			{
+				out[i] = Slerp(inputs.source[i], inputs.target[i],
+							   inputs.portions[i]);
+			}
+			DoNotOptimize(out);
+		});
+	const SBL::Benchmark::Result slerpBatch =
+		Measure("SlerpBatch", RotationCount, [&] {
+			SlerpBatch(inputs.source.data(), inputs.target.data(),
+					   inputs.portions.data(), RotationCount, out.data());
+			DoNotOptimize(out);
+		});
+	ReportSpeedup(slerp, slerpBatch);
+	const SBL::Benchmark::Result slerpFast =
+		Measure("SlerpFast", RotationCount, [&] {
+			for (std::size_t i = 0; i < RotationCount; ++i)
+			{
+				out[i] = SlerpFast(inputs.source[i], inputs.target[i],
+								   inputs.portions[i]);
+			}
+			DoNotOptimize(out);
+		});
+	ReportSpeedup(slerp, slerpFast);
+}
+
+SBL_BENCHMARK(QuaternionNlerp)
+{
+	const BlendInputs inputs = RandomBlendInputs();
+	std::vector<Quaternion> out(RotationCount);
+
+	const SBL::Benchmark::Result nlerp =
+		Measure("Nlerp", RotationCount, [&] {
+			for (std::size_t i = 0; i < RotationCount; ++i)
+			{
+				out[i] = Nlerp(inputs.source[i], inputs.target[i],
+							   inputs.portions[i]);
+			}
+			DoNotOptimize(out);
+		});
+	const SBL::Benchmark::Result nlerpBatch =
+		Measure("NlerpBatch", RotationCount, [&] {
+			NlerpBatch(inputs.source.data(), inputs.target.data(),
+					   inputs.portions.data(), RotationCount, out.data());
+			DoNotOptimize(out);
+		});
+	ReportSpeedup(nlerp, nlerpBatch);
+
+	const SBL::Benchmark::Result normalized =
+		Measure("Normalized(Quaternion)", RotationCount, [&] {
+			for (std::size_t i = 0; i < RotationCount; ++i)
+			{
+				out[i] = Normalized(inputs.source[i]);
+			}
+			DoNotOptimize(out);
+		});
+	const SBL::Benchmark::Result fastNormalized =
+		Measure("FastNormalized(Quaternion)", RotationCount, [&] {
+			for (std::size_t i = 0; i < RotationCount; ++i)
+			{
+				out[i] = FastNormalized(inputs.source[i]);
+			}
+			DoNotOptimize(out);
+		});
+	ReportSpeedup(normalized, fastNormalized);
+}
+
+SBL_BENCHMARK(QuaternionToMatrix)
+{
+	const BlendInputs inputs = RandomBlendInputs();
+	std::vector<Matrix44> out(RotationCount);
+
+	const SBL::Benchmark::Result rotation =
+		Measure("Matrix44::Rotation", RotationCount, [&] {
+			for (std::size_t i = 0; i < RotationCount; ++i)
+			{
+				out[i] = Matrix44::Rotation(inputs.source[i]);
+			}
+			DoNotOptimize(out);
+		});
+	const SBL::Benchmark::Result batch =
+		Measure("ToMatrixBatch", RotationCount, [&] {
+			ToMatrixBatch(inputs.source.data(), RotationCount, out.data());
+			DoNotOptimize(out);
+		});
+	ReportSpeedup(rotation, batch);
+}
@@ -0,0 +1,106 @@
+#include "Benchmark.hpp"
+
+#include "../Tests/MathHelpers.hpp"
+
+#include <SBLMath/Transform.hpp>
+
+#include <vector>
+
+using namespace SBL::Math;
+using SBL::Benchmark::DoNotOptimize;
+using SBL::Benchmark::Measure;
+
+namespace
+{
+constexpr std::size_t TransformCount = 4096;
+
+struct TransformInputs
+{
+	std::vector<Vector3> translations;
+	std::vector<Quaternion> rotations;
+	std::vector<Vector3> scales;
+	TransformBatch batch;
+};
+
+TransformInputs RandomTransforms()
+{
+	SBL::Test::Random random(31);
+	TransformInputs inputs;
+	inputs.batch.Resize(TransformCount);
+	for (std::size_t i = 0; i < TransformCount; ++i)
+	{
+		inputs.translations.push_back(
+			SBL::Test::RandomVector3(random, -100.0f, 100.0f));
+		inputs.rotations.push_back(SBL::Test::RandomRotation(random));
+		inputs.scales.push_back(SBL::Test::RandomVector3(random, 0.1f, 10.0f));
+		inputs.batch.Set(i, inputs.translations[i], inputs.rotations[i],
+						 inputs.scales[i]);
+	}
+	return inputs;
+}
+}
+
+SBL_BENCHMARK(TransformBatchCompose)
+{
+	const TransformInputs inputs = RandomTransforms();
+	std::vector<Matrix44> out(TransformCount);
+
+	// ns/item is also ms per million transforms.
+	const SBL::Benchmark::Result composed =
+		Measure("Translation * Rotation * Scale", TransformCount, [&] {
+			for (std::size_t i = 0; i < TransformCount; ++i)
+			{
+				out[i] = Matrix44::Translation(inputs.translations[i]) *
+						 Matrix44::Rotation(inputs.rotations[i]) *
+						 Matrix44::Scale(inputs.scales[i]);
+			}
+			DoNotOptimize(out);
+		});
+	const SBL::Benchmark::Result batched =
+		Measure("BuildWorldTransformMatrices(batch)", TransformCount, [&] {
+			BuildWorldTransformMatrices(inputs.batch, out.data());
+			DoNotOptimize(out);
+		});
+	SBL::Benchmark::ReportSpeedup(composed, batched);
+}
+
+SBL_BENCHMARK(TransformUniformBuild)
+{
+	const TransformInputs inputs = RandomTransforms();
+	std::vector<UniformTransform> transforms(TransformCount);
+	for (std::size_t i = 0; i < TransformCount; ++i)
+	{
+		transforms[i] = {inputs.translations[i], inputs.rotations[i],
+						 inputs.scales[i].x};
+	}
+	std::vector<Matrix44> out(TransformCount);
+
+	// The chain main.cpp used to build per object.
+	const SBL::Benchmark::Result chain =
+		Measure("Translation * Rotation * Scale(s)", TransformCount, [&] {
+			for (std::size_t i = 0; i < TransformCount; ++i)
+			{
+				const UniformTransform& transform = transforms[i];
+				out[i] = Matrix44::Translation(transform.m_translation) *
+						 Matrix44::Rotation(transform.m_rotation) *
+						 Matrix44::Scale(transform.m_uniformScale);
+			}
+			DoNotOptimize(out);
+		});
+	const SBL::Benchmark::Result single =
+		Measure("BuildWorldTransformMatrix", TransformCount, [&] {
+			for (std::size_t i = 0; i < TransformCount; ++i)
+			{
+				out[i] = BuildWorldTransformMatrix(transforms[i]);
+			}
+			DoNotOptimize(out);
+		});
+	SBL::Benchmark::ReportSpeedup(chain, single);
+	const SBL::Benchmark::Result array =
+		Measure("BuildWorldTransformMatrices(array)", TransformCount, [&] {
+			BuildWorldTransformMatrices(transforms.data(), TransformCount,
+										out.data());
+			DoNotOptimize(out);
+		});
+	SBL::Benchmark::ReportSpeedup(chain, array);
+}
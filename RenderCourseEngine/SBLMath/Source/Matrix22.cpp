@@ -1,10 +0,0 @@
-#include <SBLMath/Matrix22.hpp>
-
-namespace SBL
-{
-namespace Math
-{
-const Matrix22 Matrix22::Identity{1.0f, 0.0f, 1.0f, 0.0f};
-const Matrix22 Matrix22::Zero{0.0f, 0.0f, 0.0f, 0.0f};
-}
-}
\ No newline at end of file
@@ -4,7 +4,184 @@ namespace SBL
 {
 namespace Math
 {
-const Quaternion Quaternion::Zero{0.0f, 0.0f, 0.0f, 0.0f};
-const Quaternion Quaternion::Identity{0.0f, 0.0f, 0.0f, 1.0f};
+namespace
+{
+#if SBL_MATH_SIMD_SSE
+static_assert(sizeof(Quaternion) == 4 * sizeof(float32),
+			  "Quaternion is expected to be four packed floats");
+
+// Loads four quaternions and transposes them so every register holds one
+// component of all four.
+inline void Load4(const Quaternion* q, __m128& x, __m128& y, __m128& z,
+				  __m128& w)
+{
+	const float32* src = reinterpret_cast<const float32*>(q);
+	x = _mm_loadu_ps(src + 0);
+	y = _mm_loadu_ps(src + 4);
+	z = _mm_loadu_ps(src + 8);
+	w = _mm_loadu_ps(src + 12);
+	_MM_TRANSPOSE4_PS(x, y, z, w);
+}
+
+inline void Store4(__m128 x, __m128 y, __m128 z, __m128 w, Quaternion* out)
+{
+	_MM_TRANSPOSE4_PS(x, y, z, w);
+	float32* dst = reinterpret_cast<float32*>(out);
+	_mm_storeu_ps(dst + 0, x);
+	_mm_storeu_ps(dst + 4, y);
+	_mm_storeu_ps(dst + 8, z);
+	_mm_storeu_ps(dst + 12, w);
+}
+
+inline __m128 Dot4(__m128 ax, __m128 ay, __m128 az, __m128 aw, __m128 bx,
+				   __m128 by, __m128 bz, __m128 bw)
+{
+	return _mm_add_ps(_mm_add_ps(_mm_mul_ps(ax, bx), _mm_mul_ps(ay, by)),
+					  _mm_add_ps(_mm_mul_ps(az, bz), _mm_mul_ps(aw, bw)));
+}
+
+inline void Normalize4(__m128& x, __m128& y, __m128& z, __m128& w)
+{
+	const __m128 invLength = _mm_div_ps(
+		_mm_set1_ps(1.0f), _mm_sqrt_ps(Dot4(x, y, z, w, x, y, z, w)));
+	x = _mm_mul_ps(x, invLength);
+	y = _mm_mul_ps(y, invLength);
+	z = _mm_mul_ps(z, invLength);
+	w = _mm_mul_ps(w, invLength);
+}
+
+inline __m128 Select(__m128 mask, __m128 ifTrue, __m128 ifFalse)
+{
+	return _mm_or_ps(_mm_and_ps(mask, ifTrue), _mm_andnot_ps(mask, ifFalse));
+}
+
+// Same polynomial as FastSin, valid on [-PI / 2, PI / 2].
+inline __m128 SinPolynomial4(__m128 x)
+{
+	const __m128 x2 = _mm_mul_ps(x, x);
+	__m128 poly = _mm_set1_ps(-2.3889859e-8f);
+	poly = _mm_add_ps(_mm_mul_ps(poly, x2), _mm_set1_ps(2.7525562e-6f));
+	poly = _mm_add_ps(_mm_mul_ps(poly, x2), _mm_set1_ps(-0.00019840874f));
+	poly = _mm_add_ps(_mm_mul_ps(poly, x2), _mm_set1_ps(0.0083333310f));
+	poly = _mm_add_ps(_mm_mul_ps(poly, x2), _mm_set1_ps(-0.16666667f));
+	poly = _mm_add_ps(_mm_mul_ps(poly, x2), _mm_set1_ps(1.0f));
+	return _mm_mul_ps(x, poly);
+}
+
+// Abramowitz & Stegun 4.4.46, max error 2e-8 on [0, 1], mirrored for
+// negative inputs.
+inline __m128 ArcCos4(__m128 val)
+{
+	const __m128 x = _mm_andnot_ps(_mm_set1_ps(-0.0f), val);
+	__m128 poly = _mm_set1_ps(-0.0012624911f);
+	poly = _mm_add_ps(_mm_mul_ps(poly, x), _mm_set1_ps(0.0066700901f));
+	poly = _mm_add_ps(_mm_mul_ps(poly, x), _mm_set1_ps(-0.0170881256f));
+	poly = _mm_add_ps(_mm_mul_ps(poly, x), _mm_set1_ps(0.0308918810f));
+	poly = _mm_add_ps(_mm_mul_ps(poly, x), _mm_set1_ps(-0.0501743046f));
+	poly = _mm_add_ps(_mm_mul_ps(poly, x), _mm_set1_ps(0.0889789874f));
+	poly = _mm_add_ps(_mm_mul_ps(poly, x), _mm_set1_ps(-0.2145988016f));
+	poly = _mm_add_ps(_mm_mul_ps(poly, x), _mm_set1_ps(1.5707963050f));
+	const __m128 result =
+		_mm_mul_ps(_mm_sqrt_ps(_mm_sub_ps(_mm_set1_ps(1.0f), x)), poly);
+	return Select(_mm_cmplt_ps(val, _mm_setzero_ps()),
+				  _mm_sub_ps(_mm_set1_ps(PI), result), result);
+}
+
+inline void Nlerp4(__m128 sx, __m128 sy, __m128 sz, __m128 sw, __m128 tx,
+				   __m128 ty, __m128 tz, __m128 tw, __m128 portion,
+				   __m128& x, __m128& y, __m128& z, __m128& w)
+{
+	x = _mm_add_ps(sx, _mm_mul_ps(_mm_sub_ps(tx, sx), portion));
+	y = _mm_add_ps(sy, _mm_mul_ps(_mm_sub_ps(ty, sy), portion));
+	z = _mm_add_ps(sz, _mm_mul_ps(_mm_sub_ps(tz, sz), portion));
+	w = _mm_add_ps(sw, _mm_mul_ps(_mm_sub_ps(tw, sw), portion));
+	Normalize4(x, y, z, w);
+}
+#endif
+}
+
+void SlerpBatch(const Quaternion* source, const Quaternion* target,
+				const float32* portions, std::size_t count, Quaternion* out)
+{
+	std::size_t i = 0;
+
+#if SBL_MATH_SIMD_SSE
+	const __m128 one = _mm_set1_ps(1.0f);
+	const __m128 halfPi = _mm_set1_ps(0.5f * PI);
+	for (; i + 4 <= count; i += 4)
+	{
+		__m128 sx, sy, sz, sw, tx, ty, tz, tw;
+		Load4(source + i, sx, sy, sz, sw);
+		Load4(target + i, tx, ty, tz, tw);
+		Normalize4(sx, sy, sz, sw);
+		Normalize4(tx, ty, tz, tw);
+		const __m128 portion = _mm_loadu_ps(portions + i);
+
+		const __m128 dot =
+			_mm_max_ps(_mm_min_ps(Dot4(sx, sy, sz, sw, tx, ty, tz, tw), one),
+					   _mm_set1_ps(-1.0f));
+
+		// Same construction as Slerp: rotate source towards the normalized
+		// part of target that is orthogonal to it.
+		const __m128 angle = _mm_mul_ps(ArcCos4(dot), portion);
+		const __m128 foldedAngle =
+			Select(_mm_cmpgt_ps(angle, halfPi),
+				   _mm_sub_ps(_mm_set1_ps(PI), angle), angle);
+		const __m128 sinAngle = SinPolynomial4(foldedAngle);
+		const __m128 cosAngle = SinPolynomial4(_mm_sub_ps(halfPi, angle));
+
+		const __m128 ox = _mm_sub_ps(tx, _mm_mul_ps(sx, dot));
+		const __m128 oy = _mm_sub_ps(ty, _mm_mul_ps(sy, dot));
+		const __m128 oz = _mm_sub_ps(tz, _mm_mul_ps(sz, dot));
+		const __m128 ow = _mm_sub_ps(tw, _mm_mul_ps(sw, dot));
+		const __m128 orthoScale = _mm_div_ps(
+			sinAngle, _mm_sqrt_ps(Dot4(ox, oy, oz, ow, ox, oy, oz, ow)));
+		const __m128 rx = _mm_add_ps(_mm_mul_ps(sx, cosAngle),
+									 _mm_mul_ps(ox, orthoScale));
+		const __m128 ry = _mm_add_ps(_mm_mul_ps(sy, cosAngle),
+									 _mm_mul_ps(oy, orthoScale));
+		const __m128 rz = _mm_add_ps(_mm_mul_ps(sz, cosAngle),
+									 _mm_mul_ps(oz, orthoScale));
+		const __m128 rw = _mm_add_ps(_mm_mul_ps(sw, cosAngle),
+									 _mm_mul_ps(ow, orthoScale));
+
+		// Nearly parallel lanes fall back to nlerp, as Slerp does.
+		__m128 nx, ny, nz, nw;
+		Nlerp4(sx, sy, sz, sw, tx, ty, tz, tw, portion, nx, ny, nz, nw);
+		const __m128 nearlyParallel = _mm_cmpgt_ps(dot, _mm_set1_ps(0.999f));
+		Store4(Select(nearlyParallel, nx, rx), Select(nearlyParallel, ny, ry),
+			   Select(nearlyParallel, nz, rz), Select(nearlyParallel, nw, rw),
+			   out + i);
+	}
+#endif
+
+	for (; i < count; ++i)
+	{
+		out[i] = Slerp(source[i], target[i], portions[i]);
+	}
+}
+
+void NlerpBatch(const Quaternion* source, const Quaternion* target,
+				const float32* portions, std::size_t count, Quaternion* out)
+{
+	std::size_t i = 0;
+
+#if SBL_MATH_SIMD_SSE
+	for (; i + 4 <= count; i += 4)
+	{
+		__m128 sx, sy, sz, sw, tx, ty, tz, tw, x, y, z, w;
+		Load4(source + i, sx, sy, sz, sw);
+		Load4(target + i, tx, ty, tz, tw);
+		Nlerp4(sx, sy, sz, sw, tx, ty, tz, tw, _mm_loadu_ps(portions + i), x,
+			   y, z, w);
+		Store4(x, y, z, w, out + i);
+	}
+#endif
+
+	for (; i < count; ++i)
+	{
+		out[i] = Nlerp(source[i], target[i], portions[i]);
+	}
+}
+}
 }
-}
\ No newline at end of file
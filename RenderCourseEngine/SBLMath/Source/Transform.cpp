@@ -0,0 +1,202 @@
+#include <SBLMath/Transform.hpp>
+
+namespace SBL
+{
+namespace Math
+{
+namespace
+{
+// Closed-form Translation * Rotation * Scale, see Matrix44::Rotation for the
+// quaternion terms.
+inline void ComposeTranslationRotationScale(float32 tx, float32 ty, float32 tz,
+											float32 qx, float32 qy, float32 qz,
+											float32 qw, float32 sx, float32 sy,
+											float32 sz, Matrix44& out)
+{
+	const float32 invLength = 1.0f / sqrtf(qx * qx + qy * qy + qz * qz + qw * qw);
+	const float32 x = qx * invLength;
+	const float32 y = qy * invLength;
+	const float32 z = qz * invLength;
+	const float32 s = qw * invLength;
+
+	out = Matrix44(
+		(1 - 2 * y * y - 2 * z * z) * sx,	(2 * x * y - 2 * s * z) * sy,		(2 * x * z + 2 * s * y) * sz,		tx,
+		(2 * x * y + 2 * s * z) * sx,		(1 - 2 * x * x - 2 * z * z) * sy,	(2 * y * z - 2 * s * x) * sz,		ty,
+		(2 * x * z - 2 * s * y) * sx,		(2 * y * z + 2 * s * x) * sy,		(1 - 2 * x * x - 2 * y * y) * sz,	tz,
+		0,									0,									0,									1);
+}
+
+#if SBL_MATH_SIMD_SSE
+// Composes four transforms at once. Every register holds the same component
+// for four objects; the rows are transposed back into four Matrix44 on the
+// way out.
+inline void ComposeTranslationRotationScale4(__m128 tx, __m128 ty, __m128 tz,
+											 __m128 x, __m128 y, __m128 z,
+											 __m128 s, __m128 scaleX,
+											 __m128 scaleY, __m128 scaleZ,
+											 Matrix44* out)
+{
+	const __m128 one = _mm_set1_ps(1.0f);
+	const __m128 two = _mm_set1_ps(2.0f);
+
+	__m128 lengthSquared = _mm_add_ps(
+		_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)),
+		_mm_add_ps(_mm_mul_ps(z, z), _mm_mul_ps(s, s)));
+	__m128 invLength = _mm_div_ps(one, _mm_sqrt_ps(lengthSquared));
+	x = _mm_mul_ps(x, invLength);
+	y = _mm_mul_ps(y, invLength);
+	z = _mm_mul_ps(z, invLength);
+	s = _mm_mul_ps(s, invLength);
+
+	__m128 x2 = _mm_mul_ps(two, x);
+	__m128 y2 = _mm_mul_ps(two, y);
+	__m128 z2 = _mm_mul_ps(two, z);
+	__m128 xx = _mm_mul_ps(x2, x);
+	__m128 yy = _mm_mul_ps(y2, y);
+	__m128 zz = _mm_mul_ps(z2, z);
+	__m128 xy = _mm_mul_ps(x2, y);
+	__m128 xz = _mm_mul_ps(x2, z);
+	__m128 yz = _mm_mul_ps(y2, z);
+	__m128 sx = _mm_mul_ps(x2, s);
+	__m128 sy = _mm_mul_ps(y2, s);
+	__m128 sz = _mm_mul_ps(z2, s);
+
+	__m128 rows[3][4] = {
+		{_mm_mul_ps(_mm_sub_ps(_mm_sub_ps(one, yy), zz), scaleX),
+		 _mm_mul_ps(_mm_sub_ps(xy, sz), scaleY),
+		 _mm_mul_ps(_mm_add_ps(xz, sy), scaleZ),
+		 tx},
+		{_mm_mul_ps(_mm_add_ps(xy, sz), scaleX),
+		 _mm_mul_ps(_mm_sub_ps(_mm_sub_ps(one, xx), zz), scaleY),
+		 _mm_mul_ps(_mm_sub_ps(yz, sx), scaleZ),
+		 ty},
+		{_mm_mul_ps(_mm_sub_ps(xz, sy), scaleX),
+		 _mm_mul_ps(_mm_add_ps(yz, sx), scaleY),
+		 _mm_mul_ps(_mm_sub_ps(_mm_sub_ps(one, xx), yy), scaleZ),
+		 tz},
+	};
+
+	const __m128 lastRow = _mm_setr_ps(0.0f, 0.0f, 0.0f, 1.0f);
+	for (std::size_t row = 0; row < 3; ++row)
+	{
+		_MM_TRANSPOSE4_PS(rows[row][0], rows[row][1], rows[row][2], rows[row][3]);
+		for (std::size_t i = 0; i < 4; ++i)
+		{
+			_mm_storeu_ps(out[i].values + 4 * row, rows[row][i]);
+		}
+	}
+	for (std::size_t i = 0; i < 4; ++i)
+	{
+		_mm_storeu_ps(out[i].values + 12, lastRow);
+	}
+}
+#endif
+}
+
+Matrix44 BuildWorldTransformMatrix(const UniformTransform& transform)
+{
+	Matrix44 result;
+	ComposeTranslationRotationScale(
+		transform.m_translation.x, transform.m_translation.y,
+		transform.m_translation.z, transform.m_rotation.x,
+		transform.m_rotation.y, transform.m_rotation.z, transform.m_rotation.w,
+		transform.m_uniformScale, transform.m_uniformScale,
+		transform.m_uniformScale, result);
+	return result;
+}
+
+void BuildWorldTransformMatrices(const UniformTransform* transforms,
+								 std::size_t count, Matrix44* out)
+{
+	std::size_t i = 0;
+
+#if SBL_MATH_SIMD_SSE
+	// A UniformTransform is eight packed floats: (tx, ty, tz, qx) and
+	// (qy, qz, qw, scale). Two 4x4 transposes turn four of them into lanes.
+	static_assert(sizeof(UniformTransform) == 8 * sizeof(float32),
+				  "UniformTransform is expected to be eight packed floats");
+	for (; i + 4 <= count; i += 4)
+	{
+		const float32* src = reinterpret_cast<const float32*>(transforms + i);
+		__m128 tx = _mm_loadu_ps(src + 0);
+		__m128 ty = _mm_loadu_ps(src + 8);
+		__m128 tz = _mm_loadu_ps(src + 16);
+		__m128 qx = _mm_loadu_ps(src + 24);
+		__m128 qy = _mm_loadu_ps(src + 4);
+		__m128 qz = _mm_loadu_ps(src + 12);
+		__m128 qw = _mm_loadu_ps(src + 20);
+		__m128 scale = _mm_loadu_ps(src + 28);
+		_MM_TRANSPOSE4_PS(tx, ty, tz, qx);
+		_MM_TRANSPOSE4_PS(qy, qz, qw, scale);
+		ComposeTranslationRotationScale4(tx, ty, tz, qx, qy, qz, qw, scale,
+										 scale, scale, out + i);
+	}
+#endif
+
+	for (; i < count; ++i)
+	{
+		out[i] = BuildWorldTransformMatrix(transforms[i]);
+	}
+}
+
+void BuildWorldTransformMatrices(const TransformBatch& batch, Matrix44* out)
+{
+	const std::size_t count = batch.Size();
+	std::size_t i = 0;
+
+#if SBL_MATH_SIMD_SSE
+	for (; i + 4 <= count; i += 4)
+	{
+		ComposeTranslationRotationScale4(
+			_mm_loadu_ps(&batch.m_translationX[i]),
+			_mm_loadu_ps(&batch.m_translationY[i]),
+			_mm_loadu_ps(&batch.m_translationZ[i]),
+			_mm_loadu_ps(&batch.m_rotationX[i]),
+			_mm_loadu_ps(&batch.m_rotationY[i]),
+			_mm_loadu_ps(&batch.m_rotationZ[i]),
+			_mm_loadu_ps(&batch.m_rotationW[i]),
+			_mm_loadu_ps(&batch.m_scaleX[i]), _mm_loadu_ps(&batch.m_scaleY[i]),
+			_mm_loadu_ps(&batch.m_scaleZ[i]), out + i);
+	}
+#endif
+
+	for (; i < count; ++i)
+	{
+		ComposeTranslationRotationScale(
+			batch.m_translationX[i], batch.m_translationY[i],
+			batch.m_translationZ[i], batch.m_rotationX[i], batch.m_rotationY[i],
+			batch.m_rotationZ[i], batch.m_rotationW[i], batch.m_scaleX[i],
+			batch.m_scaleY[i], batch.m_scaleZ[i], out[i]);
+	}
+}
+
+void ToMatrixBatch(const Quaternion* rotations, std::size_t count,
+				   Matrix44* out)
+{
+	std::size_t i = 0;
+
+#if SBL_MATH_SIMD_SSE
+	static_assert(sizeof(Quaternion) == 4 * sizeof(float32),
+				  "Quaternion is expected to be four packed floats");
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 one = _mm_set1_ps(1.0f);
+	for (; i + 4 <= count; i += 4)
+	{
+		const float32* src = reinterpret_cast<const float32*>(rotations + i);
+		__m128 x = _mm_loadu_ps(src + 0);
+		__m128 y = _mm_loadu_ps(src + 4);
+		__m128 z = _mm_loadu_ps(src + 8);
+		__m128 w = _mm_loadu_ps(src + 12);
+		_MM_TRANSPOSE4_PS(x, y, z, w);
+		ComposeTranslationRotationScale4(zero, zero, zero, x, y, z, w, one,
+										 one, one, out + i);
+	}
+#endif
+
+	for (; i < count; ++i)
+	{
+		out[i] = Matrix44::Rotation(rotations[i]);
+	}
+}
+}
+}
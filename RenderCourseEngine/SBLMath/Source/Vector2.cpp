@@ -1,15 +0,0 @@
-#include <SBLMath/Vector2.hpp>
-
-namespace SBL
-{
-namespace Math
-{
-const Vector2 Vector2::Zero{0.0f, 0.0f};
-const Vector2 Vector2::One{1.0f, 1.0f};
-const Vector2 Vector2::Up{0.0f, 1.0f};
-const Vector2 Vector2::Down{0.0f, -1.0f};
-const Vector2 Vector2::Left{-1.0f, 0.0f};
-const Vector2 Vector2::Right{1.0f, 0.0f};
-const Vector2 Vector2::Unit{0.707107f, 0.707107f};
-}
-}
\ No newline at end of file
@@ -0,0 +1,119 @@
+#include "MathHelpers.hpp"
+
+#include <SBLMath/Common.hpp>
+#include <SBLMath/Quaternion.hpp>
+#include <SBLMath/Vector3.hpp>
+#include <SBLMath/Vector4.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace SBL::Math;
+using SBL::Test::Random;
+
+// These check the bounds documented in Common.hpp. Every variant runs them:
+// the default and SBL_MATH_NO_SIMD builds cover both FastInverseSqrt paths,
+// and SBL_MATH_FAST_MATH checks that ArcCos and Normalized route through the
+// approximations while Sin and Cos stay on libm.
+
+namespace
+{
+#if SBL_MATH_SIMD_SSE
+constexpr double InverseSqrtRelativeError = 3e-7;
+#else
+constexpr double InverseSqrtRelativeError = 5e-6;
+#endif
+
+#ifdef SBL_MATH_FAST_MATH
+constexpr double NormalizedLengthError = InverseSqrtRelativeError * 2;
+#else
+constexpr double NormalizedLengthError = 2e-7;
+#endif
+}
+
+SBL_TEST(FastSinAndCosErrorBound)
+{
+	double sinError = 0.0;
+	double cosError = 0.0;
+	for (int i = -1000000; i <= 1000000; ++i)
+	{
+		const float x = static_cast<float>(i) * (100.0f / 1000000.0f);
+		sinError = std::max(sinError,
+							std::fabs(FastSin(x) - std::sin(double(x))));
+		cosError = std::max(cosError,
+							std::fabs(FastCos(x) - std::cos(double(x))));
+	}
+	SBL_CHECK(sinError < 5e-7);
+	SBL_CHECK(cosError < 5e-7);
+}
+
+SBL_TEST(FastArcCosErrorBound)
+{
+	double error = 0.0;
+	for (int i = -1000000; i <= 1000000; ++i)
+	{
+		const float x = static_cast<float>(i) / 1000000.0f;
+		error = std::max(error, std::fabs(FastArcCos(x) - std::acos(double(x))));
+	}
+	SBL_CHECK(error < 7e-5);
+	SBL_CHECK_NEAR(FastArcCos(1.0f), 0.0f, 1e-6f);
+	SBL_CHECK_NEAR(FastArcCos(-1.0f), PI, 1e-6f);
+}
+
+SBL_TEST(FastInverseSqrtErrorBound)
+{
+	double error = 0.0;
+	for (int exponent = -40; exponent <= 40; ++exponent)
+	{
+		for (int step = 0; step < 4096; ++step)
+		{
+			const float x = std::ldexp(1.0f + step / 4096.0f, exponent);
+			const double expected = 1.0 / std::sqrt(double(x));
+			error = std::max(error,
+							 std::fabs(FastInverseSqrt(x) - expected) / expected);
+		}
+	}
+	SBL_CHECK(error < InverseSqrtRelativeError);
+}
+
+SBL_TEST(FastNormalizedMatchesNormalized)
+{
+	Random random(53);
+	for (int i = 0; i < 10000; ++i)
+	{
+		const Vector3 vec3 = SBL::Test::RandomVector3(random, -100.0f, 100.0f);
+		const Vector3 fast3 = FastNormalized(vec3);
+		const Vector3 precise3 = vec3 / std::sqrt(LengthSquared(vec3));
+		SBL_CHECK_NEAR(Length(fast3), 1.0, 2 * InverseSqrtRelativeError);
+		SBL_CHECK(Length(fast3 - precise3) < 2 * InverseSqrtRelativeError);
+		SBL_CHECK_NEAR(Length(Normalized(vec3)), 1.0, NormalizedLengthError);
+
+		const Vector4 vec4{vec3, random.Range(-100.0f, 100.0f)};
+		SBL_CHECK_NEAR(Length(FastNormalized(vec4)), 1.0,
+					   2 * InverseSqrtRelativeError);
+		SBL_CHECK_NEAR(Length(Normalized(vec4)), 1.0, NormalizedLengthError);
+
+		const Quaternion q(vec4);
+		SBL_CHECK_NEAR(Length(Vector4(FastNormalized(q))), 1.0,
+					   2 * InverseSqrtRelativeError);
+		SBL_CHECK_NEAR(Length(Vector4(Normalized(q))), 1.0,
+					   NormalizedLengthError);
+	}
+}
+
+SBL_TEST(PolicyRoutesTrigonometry)
+{
+	Random random(59);
+	for (int i = 0; i < 10000; ++i)
+	{
+		const float x = random.Range(-10.0f, 10.0f);
+		const float c = random.Range(-1.0f, 1.0f);
+		SBL_CHECK(Sin(x) == MakeZero(std::sin(x)));
+		SBL_CHECK(Cos(x) == MakeZero(std::cos(x)));
+#ifdef SBL_MATH_FAST_MATH
+		SBL_CHECK(ArcCos(c) == MakeZero(FastArcCos(c)));
+#else
+		SBL_CHECK(ArcCos(c) == MakeZero(std::acos(c)));
+#endif
+	}
+}
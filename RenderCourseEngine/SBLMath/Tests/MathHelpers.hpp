@@ -0,0 +1,80 @@
+#pragma once
+
+#include "Test.hpp"
+
+#include <SBLMath/Matrix44.hpp>
+#include <SBLMath/Quaternion.hpp>
+#include <SBLMath/Vector3.hpp>
+#include <SBLMath/Vector4.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace SBL
+{
+namespace Test
+{
+inline Math::Vector3 RandomVector3(Random& random, float min, float max)
+{
+	return {random.Range(min, max), random.Range(min, max),
+			random.Range(min, max)};
+}
+
+inline Math::Quaternion RandomRotation(Random& random)
+{
+	const Math::Vector4 q{random.Range(-1.0f, 1.0f), random.Range(-1.0f, 1.0f),
+						  random.Range(-1.0f, 1.0f), random.Range(-1.0f, 1.0f)};
+	return Math::Quaternion(q / std::sqrt(Math::LengthSquared(q)));
+}
+
+// Diagonally dominant, so it is always comfortably invertible.
+inline Math::Matrix44 RandomInvertible(Random& random)
+{
+	Math::Matrix44 mat;
+	for (float& value : mat.values)
+	{
+		value = random.Range(-1.0f, 1.0f);
+	}
+	for (std::size_t i = 0; i < 4; ++i)
+	{
+		mat[i][i] += random.Range(0.0f, 1.0f) < 0.5f ? -5.0f : 5.0f;
+	}
+	return mat;
+}
+
+// Translation * Rotation * Scale with a non-uniform positive scale.
+inline Math::Matrix44 RandomAffine(Random& random)
+{
+	return Math::Matrix44::Translation(RandomVector3(random, -50.0f, 50.0f)) *
+		   Math::Matrix44::Rotation(RandomRotation(random)) *
+		   Math::Matrix44::Scale(RandomVector3(random, 0.25f, 4.0f));
+}
+
+inline float MaxAbsDifference(const Math::Matrix44& lhs,
+							  const Math::Matrix44& rhs)
+{
+	float result = 0.0f;
+	for (std::size_t i = 0; i < 16; ++i)
+	{
+		result = std::max(result, std::fabs(lhs.values[i] - rhs.values[i]));
+	}
+	return result;
+}
+
+// Quaternions q and -q are the same rotation.
+inline float RotationDifference(const Math::Quaternion& lhs,
+								const Math::Quaternion& rhs)
+{
+	float same = 0.0f;
+	float flipped = 0.0f;
+	const float a[4] = {lhs.x, lhs.y, lhs.z, lhs.w};
+	const float b[4] = {rhs.x, rhs.y, rhs.z, rhs.w};
+	for (std::size_t i = 0; i < 4; ++i)
+	{
+		same = std::max(same, std::fabs(a[i] - b[i]));
+		flipped = std::max(flipped, std::fabs(a[i] + b[i]));
+	}
+	return std::min(same, flipped);
+}
+}
+}
@@ -0,0 +1,217 @@
+#include "MathHelpers.hpp"
+
+#include <SBLMath/Matrix33.hpp>
+#include <SBLMath/Matrix44.hpp>
+
+using namespace SBL::Math;
+using SBL::Test::MaxAbsDifference;
+using SBL::Test::Random;
+
+namespace
+{
+// Determinant of the 3x3 left once `row` and `column` are struck out.
+float Minor(const Matrix44& mat, std::size_t column, std::size_t row)
+{
+	Matrix33 sub;
+	std::size_t index = 0;
+	for (std::size_t r = 0; r < 4; ++r)
+	{
+		for (std::size_t c = 0; c < 4; ++c)
+		{
+			if (r != row && c != column)
+			{
+				sub.values[index++] = mat[r][c];
+			}
+		}
+	}
+	return Determinant(sub);
+}
+
+// Cofactor expansion along the first row, independent of Determinant.
+float ExpandDeterminant(const Matrix44& mat)
+{
+	float result = 0.0f;
+	for (std::size_t column = 0; column < 4; ++column)
+	{
+		const float sign = column % 2 ? -1.0f : 1.0f;
+		result += sign * mat[0][column] * Minor(mat, column, 0);
+	}
+	return result;
+}
+}
+
+SBL_TEST(InverseTimesMatrixIsIdentity)
+{
+	Random random;
+	for (int i = 0; i < 1000; ++i)
+	{
+		const Matrix44 mat = SBL::Test::RandomInvertible(random);
+		const Matrix44 inverse = Inverse(mat);
+		SBL_CHECK(MaxAbsDifference(mat * inverse, Matrix44::Identity) < 1e-5f);
+		SBL_CHECK(MaxAbsDifference(inverse * mat, Matrix44::Identity) < 1e-5f);
+	}
+}
+
+SBL_TEST(InverseOfKnownMatrices)
+{
+	SBL_CHECK(Inverse(Matrix44::Identity) == Matrix44::Identity);
+
+	const Matrix44 translation = Matrix44::Translation({1.0f, -2.0f, 3.0f});
+	SBL_CHECK(Inverse(translation) ==
+			  Matrix44::Translation({-1.0f, 2.0f, -3.0f}));
+
+	const Vector3 scale{2.0f, 4.0f, 0.5f};
+	SBL_CHECK(MaxAbsDifference(Inverse(Matrix44::Scale(scale)),
+							   InverseScale(scale)) < 1e-6f);
+}
+
+SBL_TEST(CofactorMatchesSignedMinors)
+{
+	Random random(7);
+	for (int i = 0; i < 200; ++i)
+	{
+		const Matrix44 mat = SBL::Test::RandomInvertible(random);
+		const Matrix44 cofactor = Cofactor(mat);
+		for (std::size_t row = 0; row < 4; ++row)
+		{
+			for (std::size_t column = 0; column < 4; ++column)
+			{
+				const float sign = (row + column) % 2 ? -1.0f : 1.0f;
+				const float expected = sign * Minor(mat, column, row);
+				SBL_CHECK_NEAR(CofactorOfElement(mat, column, row), expected,
+							   1e-3f * (1.0f + std::fabs(expected)));
+				SBL_CHECK_NEAR(cofactor[row][column], expected,
+							   1e-3f * (1.0f + std::fabs(expected)));
+			}
+		}
+	}
+}
+
+SBL_TEST(AdjointIsScaledInverse)
+{
+	Random random(11);
+	for (int i = 0; i < 200; ++i)
+	{
+		const Matrix44 mat = SBL::Test::RandomInvertible(random);
+		const float det = Determinant(mat);
+		const Matrix44 expected = Inverse(mat) * det;
+		SBL_CHECK(MaxAbsDifference(Adjoint(mat), expected) <
+				  1e-5f * std::fabs(det));
+	}
+}
+
+SBL_TEST(DeterminantMatchesCofactorExpansion)
+{
+	Random random(13);
+	for (int i = 0; i < 1000; ++i)
+	{
+		const Matrix44 mat = SBL::Test::RandomInvertible(random);
+		const float expected = ExpandDeterminant(mat);
+		SBL_CHECK_NEAR(Determinant(mat), expected,
+					   1e-5f * std::fabs(expected));
+	}
+}
+
+SBL_TEST(DeterminantProperties)
+{
+	SBL_CHECK(Determinant(Matrix44::Identity) == 1.0f);
+	SBL_CHECK(Determinant(Matrix44::Zero) == 0.0f);
+	SBL_CHECK_NEAR(Determinant(Matrix44::Scale({2.0f, 3.0f, 4.0f})), 24.0f,
+				   1e-6f);
+
+	// A swapped pair of rows flips the sign.
+	Random random(17);
+	const Matrix44 mat = SBL::Test::RandomInvertible(random);
+	Matrix44 swapped = mat;
+	swapped[0] = mat[2];
+	swapped[2] = mat[0];
+	SBL_CHECK_NEAR(Determinant(swapped), -Determinant(mat),
+				   1e-5f * std::fabs(Determinant(mat)));
+
+	// det(AB) = det(A) det(B) and det(inv(A)) = 1 / det(A).
+	for (int i = 0; i < 200; ++i)
+	{
+		const Matrix44 a = SBL::Test::RandomInvertible(random);
+		const Matrix44 b = SBL::Test::RandomInvertible(random);
+		const float expected = Determinant(a) * Determinant(b);
+		SBL_CHECK_NEAR(Determinant(a * b), expected,
+					   1e-5f * std::fabs(expected));
+		SBL_CHECK_NEAR(Determinant(a) * Determinant(Inverse(a)), 1.0f, 1e-5f);
+	}
+
+	static_assert(Determinant(Matrix44::Identity) == 1.0f,
+				  "Determinant is usable in constant expressions");
+}
+
+SBL_TEST(MultiplyMatchesReference)
+{
+	Random random(19);
+	for (int i = 0; i < 1000; ++i)
+	{
+		const Matrix44 lhs = SBL::Test::RandomInvertible(random);
+		const Matrix44 rhs = SBL::Test::RandomInvertible(random);
+		SBL_CHECK(MaxAbsDifference(lhs * rhs, MultiplyReference(lhs, rhs)) <
+				  1e-5f);
+	}
+
+	constexpr Matrix44 scale = Matrix44::Scale(2.0f);
+	constexpr Matrix44 product = scale * Matrix44::Translation({1, 2, 3});
+	static_assert(product.m03 == 2.0f && product.m33 == 1.0f,
+				  "operator* is usable in constant expressions");
+}
+
+SBL_TEST(MatrixVectorMultiplyMatchesReference)
+{
+	Random random(23);
+	for (int i = 0; i < 1000; ++i)
+	{
+		const Matrix44 mat = SBL::Test::RandomInvertible(random);
+		const Vector4 vec{random.Range(-5.0f, 5.0f), random.Range(-5.0f, 5.0f),
+						  random.Range(-5.0f, 5.0f), 1.0f};
+		const Vector4 result = mat * vec;
+		for (std::size_t row = 0; row < 4; ++row)
+		{
+			const Vector4 r = mat.Row(row);
+			SBL_CHECK_NEAR(result[row],
+						   r.x * vec.x + r.y * vec.y + r.z * vec.z + r.w * vec.w,
+						   1e-4f);
+		}
+	}
+}
+
+SBL_TEST(AffineInverseMatchesInverse)
+{
+	Random random(37);
+	for (int i = 0; i < 1000; ++i)
+	{
+		const Matrix44 mat = SBL::Test::RandomAffine(random);
+		const Matrix44 inverse = AffineInverse(mat);
+		SBL_CHECK(MaxAbsDifference(inverse, Inverse(mat)) < 1e-4f);
+		SBL_CHECK(MaxAbsDifference(AffineMultiply(mat, inverse),
+								   Matrix44::Identity) < 1e-4f);
+	}
+}
+
+SBL_TEST(RigidInverseMatchesInverse)
+{
+	Random random(41);
+	for (int i = 0; i < 1000; ++i)
+	{
+		const Matrix44 mat =
+			Matrix44::Translation(SBL::Test::RandomVector3(random, -50, 50)) *
+			Matrix44::Rotation(SBL::Test::RandomRotation(random));
+		SBL_CHECK(MaxAbsDifference(RigidInverse(mat), Inverse(mat)) < 1e-4f);
+	}
+}
+
+SBL_TEST(AffineMultiplyMatchesMultiply)
+{
+	Random random(43);
+	for (int i = 0; i < 1000; ++i)
+	{
+		const Matrix44 lhs = SBL::Test::RandomAffine(random);
+		const Matrix44 rhs = SBL::Test::RandomAffine(random);
+		SBL_CHECK(MaxAbsDifference(AffineMultiply(lhs, rhs),
+								   MultiplyReference(lhs, rhs)) < 1e-3f);
+	}
+}
@@ -0,0 +1,154 @@
+#include "MathHelpers.hpp"
+
+#include <SBLMath/Quaternion.hpp>
+
+#include <algorithm>
+#include <vector>
+
+using namespace SBL::Math;
+using SBL::Test::Random;
+using SBL::Test::RotationDifference;
+
+SBL_TEST(SlerpHitsEndpoints)
+{
+	Random random(5);
+	for (int i = 0; i < 500; ++i)
+	{
+		const Quaternion source = SBL::Test::RandomRotation(random);
+		const Quaternion target = SBL::Test::RandomRotation(random);
+		SBL_CHECK(RotationDifference(Slerp(source, target, 0.0f), source) <
+				  1e-4f);
+		SBL_CHECK(RotationDifference(Slerp(source, target, 1.0f), target) <
+				  1e-3f);
+	}
+}
+
+SBL_TEST(SlerpFollowsTheGreatArc)
+{
+	// Interpolating about a fixed axis must match the rotation built for the
+	// interpolated angle directly.
+	const Vector3 axis = Normalized(Vector3{1.0f, 2.0f, -0.5f});
+	const Quaternion source = Quaternion::AxisAngle(axis, 0.2f);
+	const Quaternion target = Quaternion::AxisAngle(axis, 2.6f);
+	for (int step = 0; step <= 16; ++step)
+	{
+		const float portion = step / 16.0f;
+		const Quaternion expected =
+			Quaternion::AxisAngle(axis, 0.2f + 2.4f * portion);
+		SBL_CHECK(RotationDifference(Slerp(source, target, portion),
+									 expected) < 1e-3f);
+	}
+}
+
+SBL_TEST(SlerpStaysNormalized)
+{
+	Random random(9);
+	for (int i = 0; i < 1000; ++i)
+	{
+		const Quaternion result =
+			Slerp(SBL::Test::RandomRotation(random),
+				  SBL::Test::RandomRotation(random), random.Range(0.0f, 1.0f));
+		SBL_CHECK_NEAR(Length(Vector4(result)), 1.0f, 1e-4f);
+	}
+}
+
+SBL_TEST(SlerpOfNearlyEqualRotations)
+{
+	// The nlerp fallback for nearly parallel inputs must not produce NaNs.
+	const Quaternion source = Quaternion::AxisAngle(Vector3::Up, 1.0f);
+	const Quaternion target = Quaternion::AxisAngle(Vector3::Up, 1.0001f);
+	const Quaternion result = Slerp(source, target, 0.5f);
+	SBL_CHECK(RotationDifference(result, source) < 1e-4f);
+	SBL_CHECK(RotationDifference(Slerp(source, source, 0.3f), source) < 1e-5f);
+}
+
+namespace
+{
+// Odd on purpose, so the SIMD loops also hand a tail to the scalar path.
+constexpr std::size_t BlendCount = 1001;
+
+#ifdef SBL_MATH_FAST_MATH
+// Slerp itself runs on FastArcCos here, the batch on the exact polynomial.
+constexpr float SlerpBatchError = 2e-4f;
+#else
+constexpr float SlerpBatchError = 2e-6f;
+#endif
+
+struct BlendInputs
+{
+	std::vector<Quaternion> source;
+	std::vector<Quaternion> target;
+	std::vector<float32> portions;
+};
+
+BlendInputs RandomBlendInputs(std::uint32_t seed)
+{
+	Random random(seed);
+	BlendInputs inputs;
+	for (std::size_t i = 0; i < BlendCount; ++i)
+	{
+		inputs.source.push_back(SBL::Test::RandomRotation(random));
+		inputs.target.push_back(SBL::Test::RandomRotation(random));
+		inputs.portions.push_back(random.Range(0.0f, 1.0f));
+	}
+	// Nearly parallel pairs take the nlerp fallback in both paths.
+	for (std::size_t i = 0; i < BlendCount; i += 7)
+	{
+		inputs.target[i] = Quaternion(
+			Normalized(Vector4(inputs.source[i]) +
+					   Vector4(random.Range(-0.01f, 0.01f), 0.0f, 0.0f, 0.0f)));
+	}
+	return inputs;
+}
+}
+
+SBL_TEST(SlerpBatchMatchesSlerp)
+{
+	const BlendInputs inputs = RandomBlendInputs(71);
+	std::vector<Quaternion> out(BlendCount);
+	SlerpBatch(inputs.source.data(), inputs.target.data(),
+			   inputs.portions.data(), BlendCount, out.data());
+	for (std::size_t i = 0; i < BlendCount; ++i)
+	{
+		const Quaternion expected =
+			Slerp(inputs.source[i], inputs.target[i], inputs.portions[i]);
+		SBL_CHECK(RotationDifference(out[i], expected) < SlerpBatchError);
+	}
+}
+
+SBL_TEST(NlerpBatchMatchesNlerp)
+{
+	const BlendInputs inputs = RandomBlendInputs(73);
+	std::vector<Quaternion> out(BlendCount);
+	NlerpBatch(inputs.source.data(), inputs.target.data(),
+			   inputs.portions.data(), BlendCount, out.data());
+	for (std::size_t i = 0; i < BlendCount; ++i)
+	{
+		const Quaternion expected =
+			Nlerp(inputs.source[i], inputs.target[i], inputs.portions[i]);
+		SBL_CHECK(RotationDifference(out[i], expected) < 1e-5f);
+	}
+}
+
+SBL_TEST(SlerpFastErrorBound)
+{
+	const BlendInputs inputs = RandomBlendInputs(79);
+	float error = 0.0f;
+	for (std::size_t i = 0; i < BlendCount; ++i)
+	{
+		// SlerpFast always takes the shorter arc, Slerp follows the sign.
+		const Quaternion& source = inputs.source[i];
+		Quaternion target = inputs.target[i];
+		if (DotProduct(Vector4(source), Vector4(target)) < 0.0f)
+		{
+			target = Quaternion(-Vector4(target));
+		}
+		const Quaternion expected = Slerp(source, target, inputs.portions[i]);
+		error = std::max(
+			error, RotationDifference(SlerpFast(inputs.source[i],
+												inputs.target[i],
+												inputs.portions[i]),
+									  expected));
+	}
+	SBL_CHECK(error < 5e-4f);
+}
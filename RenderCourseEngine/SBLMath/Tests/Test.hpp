@@ -0,0 +1,134 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+// Minimal self-registering test runner, kept dependency-free so that the
+// suites build anywhere SBLMath does. A test is a void function declared with
+// SBL_TEST; checks record a failure and let the test carry on.
+
+namespace SBL
+{
+namespace Test
+{
+struct TestCase
+{
+	const char* name;
+	void (*function)();
+};
+
+inline std::vector<TestCase>& Registry()
+{
+	static std::vector<TestCase> tests;
+	return tests;
+}
+
+inline int& FailureCount()
+{
+	static int failures = 0;
+	return failures;
+}
+
+struct Registrar
+{
+	Registrar(const char* name, void (*function)())
+	{
+		Registry().push_back({name, function});
+	}
+};
+
+inline void ReportFailure(const char* file, int line, const char* expression)
+{
+	std::printf("  %s:%d: check failed: %s\n", file, line, expression);
+	++FailureCount();
+}
+
+inline void ReportNearFailure(const char* file, int line,
+							  const char* expression, double actual,
+							  double expected, double tolerance)
+{
+	std::printf("  %s:%d: check failed: %s (got %.9g, expected %.9g +- %g)\n",
+				file, line, expression, actual, expected, tolerance);
+	++FailureCount();
+}
+
+// Runs every registered test whose name contains argv[1], or all of them.
+inline int RunAll(int argc, char** argv)
+{
+	const char* filter = argc > 1 ? argv[1] : nullptr;
+	int run = 0;
+	int failed = 0;
+	for (const TestCase& test : Registry())
+	{
+		if (filter && !std::strstr(test.name, filter))
+		{
+			continue;
+		}
+
+		const int failuresBefore = FailureCount();
+		test.function();
+		++run;
+		if (FailureCount() != failuresBefore)
+		{
+			std::printf("FAILED %s\n", test.name);
+			++failed;
+		}
+	}
+	std::printf("%d tests, %d failed\n", run, failed);
+	return failed == 0 ? 0 : 1;
+}
+
+// Deterministic xorshift generator so failures reproduce across platforms.
+struct Random
+{
+	explicit Random(std::uint32_t seed = 0x9e3779b9u) : state(seed) {}
+
+	std::uint32_t Next()
+	{
+		state ^= state << 13;
+		state ^= state >> 17;
+		state ^= state << 5;
+		return state;
+	}
+
+	// Uniform in [min, max).
+	float Range(float min, float max)
+	{
+		return min + (max - min) * static_cast<float>(Next() >> 8) *
+						 (1.0f / 16777216.0f);
+	}
+
+	std::uint32_t state;
+};
+}
+}
+
+#define SBL_TEST(name)                                                         \
+	static void name();                                                        \
+	static ::SBL::Test::Registrar name##Registrar(#name, &name);               \
+	static void name()
+
+#define SBL_CHECK(expression)                                                  \
+	do                                                                         \
+	{                                                                          \
+		if (!(expression))                                                     \
+		{                                                                      \
+			::SBL::Test::ReportFailure(__FILE__, __LINE__, #expression);       \
+		}                                                                      \
+	} while (false)
+
+#define SBL_CHECK_NEAR(actual, expected, tolerance)                            \
+	do                                                                         \
+	{                                                                          \
+		const double sblActual = static_cast<double>(actual);                  \
+		const double sblExpected = static_cast<double>(expected);              \
+		if (!(std::fabs(sblActual - sblExpected) <= (tolerance)))              \
+		{                                                                      \
+			::SBL::Test::ReportNearFailure(__FILE__, __LINE__, #actual,        \
+										   sblActual, sblExpected,             \
+										   (tolerance));                       \
+		}                                                                      \
+	} while (false)
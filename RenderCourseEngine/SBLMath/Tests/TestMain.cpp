@@ -0,0 +1,6 @@
+#include "Test.hpp"
+
+int main(int argc, char** argv)
+{
+	return SBL::Test::RunAll(argc, argv);
+}
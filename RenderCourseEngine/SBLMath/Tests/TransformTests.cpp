@@ -0,0 +1,105 @@
+#include "MathHelpers.hpp"
+
+#include <SBLMath/Transform.hpp>
+
+#include <vector>
+
+using namespace SBL::Math;
+using SBL::Test::MaxAbsDifference;
+using SBL::Test::Random;
+
+namespace
+{
+// Odd on purpose, so the SIMD loops also hand a tail to the scalar path.
+constexpr std::size_t TransformCount = 103;
+
+Matrix44 ComposedMatrix(const Vector3& translation, const Quaternion& rotation,
+						const Vector3& scale)
+{
+	return Matrix44::Translation(translation) * Matrix44::Rotation(rotation) *
+		   Matrix44::Scale(scale);
+}
+}
+
+SBL_TEST(TransformBatchMatchesComposedMatrices)
+{
+	Random random(29);
+	TransformBatch batch;
+	batch.Resize(TransformCount);
+	std::vector<Matrix44> expected(TransformCount);
+	for (std::size_t i = 0; i < TransformCount; ++i)
+	{
+		const Vector3 translation =
+			SBL::Test::RandomVector3(random, -100.0f, 100.0f);
+		// Unnormalized on purpose; both paths normalize.
+		const Quaternion rotation(
+			Vector4(SBL::Test::RandomRotation(random)) *
+			random.Range(0.5f, 2.0f));
+		const Vector3 scale = SBL::Test::RandomVector3(random, 0.1f, 10.0f);
+		batch.Set(i, translation, rotation, scale);
+		expected[i] = ComposedMatrix(translation, rotation, scale);
+	}
+
+	std::vector<Matrix44> out(TransformCount);
+	BuildWorldTransformMatrices(batch, out.data());
+	for (std::size_t i = 0; i < TransformCount; ++i)
+	{
+		SBL_CHECK(MaxAbsDifference(out[i], expected[i]) < 1e-4f);
+	}
+}
+
+SBL_TEST(EmptyTransformBatch)
+{
+	TransformBatch batch;
+	SBL_CHECK(batch.Size() == 0);
+	BuildWorldTransformMatrices(batch, nullptr);
+}
+
+SBL_TEST(BuildWorldTransformMatrixMatchesMultiplyChain)
+{
+	Random random(47);
+	std::vector<UniformTransform> transforms(TransformCount);
+	std::vector<Matrix44> expected(TransformCount);
+	for (std::size_t i = 0; i < TransformCount; ++i)
+	{
+		UniformTransform& transform = transforms[i];
+		transform.m_translation =
+			SBL::Test::RandomVector3(random, -100.0f, 100.0f);
+		transform.m_rotation = Quaternion(
+			Vector4(SBL::Test::RandomRotation(random)) *
+			random.Range(0.5f, 2.0f));
+		transform.m_uniformScale = random.Range(0.1f, 10.0f);
+		expected[i] = ComposedMatrix(
+			transform.m_translation, transform.m_rotation,
+			Vector3::One * transform.m_uniformScale);
+
+		SBL_CHECK(MaxAbsDifference(BuildWorldTransformMatrix(transform),
+								   expected[i]) < 1e-4f);
+	}
+
+	std::vector<Matrix44> out(TransformCount);
+	BuildWorldTransformMatrices(transforms.data(), TransformCount, out.data());
+	for (std::size_t i = 0; i < TransformCount; ++i)
+	{
+		SBL_CHECK(MaxAbsDifference(out[i], expected[i]) < 1e-4f);
+	}
+}
+
+SBL_TEST(ToMatrixBatchMatchesRotation)
+{
+	Random random(83);
+	std::vector<Quaternion> rotations(TransformCount);
+	for (Quaternion& rotation : rotations)
+	{
+		rotation = Quaternion(Vector4(SBL::Test::RandomRotation(random)) *
+							  random.Range(0.5f, 2.0f));
+	}
+
+	std::vector<Matrix44> out(TransformCount);
+	ToMatrixBatch(rotations.data(), TransformCount, out.data());
+	for (std::size_t i = 0; i < TransformCount; ++i)
+	{
+		SBL_CHECK(MaxAbsDifference(out[i], Matrix44::Rotation(rotations[i])) <
+				  1e-5f);
+	}
+}
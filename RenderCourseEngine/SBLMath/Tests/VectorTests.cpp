@@ -0,0 +1,38 @@
+#include "MathHelpers.hpp"
+
+#include <SBLMath/Vector3.hpp>
+
+using namespace SBL::Math;
+using SBL::Test::Random;
+
+SBL_TEST(CrossProductOfBasisVectors)
+{
+	SBL_CHECK(CrossProduct(Vector3::Right, Vector3::Up) == Vector3::Out);
+	SBL_CHECK(CrossProduct(Vector3::Up, Vector3::Out) == Vector3::Right);
+	SBL_CHECK(CrossProduct(Vector3::Out, Vector3::Right) == Vector3::Up);
+	SBL_CHECK(CrossProduct(Vector3::Up, Vector3::Up) == Vector3::Zero);
+
+	static_assert(CrossProduct(Vector3::Right, Vector3::Up) == Vector3::Out,
+				  "CrossProduct is usable in constant expressions");
+}
+
+SBL_TEST(CrossProductProperties)
+{
+	Random random(3);
+	for (int i = 0; i < 1000; ++i)
+	{
+		const Vector3 a = SBL::Test::RandomVector3(random, -10.0f, 10.0f);
+		const Vector3 b = SBL::Test::RandomVector3(random, -10.0f, 10.0f);
+		const Vector3 cross = CrossProduct(a, b);
+		const float scale = Length(a) * Length(b);
+
+		// Orthogonal to both inputs and anticommutative.
+		SBL_CHECK_NEAR(DotProduct(cross, a), 0.0f, 1e-5f * scale * Length(a));
+		SBL_CHECK_NEAR(DotProduct(cross, b), 0.0f, 1e-5f * scale * Length(b));
+		SBL_CHECK(CrossProduct(b, a) == -cross);
+
+		// |a x b|^2 + (a . b)^2 = |a|^2 |b|^2 (Lagrange's identity).
+		SBL_CHECK_NEAR(LengthSquared(cross) + Pow2(DotProduct(a, b)),
+					   scale * scale, 1e-5f * scale * scale);
+	}
+}
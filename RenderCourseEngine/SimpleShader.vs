@@ -52,7 +52,11 @@ struct InDataVS
 {
 	float3 position : Position;
 	float2 textureCoord : TEXCOORD;
+#if PACKED_VERTEX
+	float2 octNormal : Normal; // see RCE::VertexFormat::OctahedralEncode
+#else
 	float3 normal : Normal;
+#endif
 };
 
 struct OutDataVS 
@@ -64,14 +68,27 @@ struct OutDataVS
 	float3 worldNormal : Normal1;
 };
 
+float3 OctahedralDecode(float2 e)
+{
+    float3 n = float3(e.xy, 1.0 - abs(e.x) - abs(e.y));
+    float t = saturate(-n.z);
+    n.xy += n.xy >= 0.0 ? -t : t;
+    return normalize(n);
+}
+
 OutDataVS main(InDataVS inData)
 {
     OutDataVS outData;
+#if PACKED_VERTEX
+    float3 normal = OctahedralDecode(inData.octNormal);
+#else
+    float3 normal = inData.normal;
+#endif
     outData.viewPosition = mul(transform.objectToView, float4(inData.position, 1.0));
-    outData.viewNormal = normalize(mul(transform.normalToView, float4(inData.normal, 0.f)).xyz);
+    outData.viewNormal = normalize(mul(transform.normalToView, float4(normal, 0.f)).xyz);
     outData.textureCoord = inData.textureCoord.xy;
     outData.worldPosition = mul(transform.objectToWorld, float4(inData.position, 1.0));
-    outData.worldNormal = normalize(mul(transform.normalToWorld, float4(inData.normal, 0.f)).xyz);
+    outData.worldNormal = normalize(mul(transform.normalToWorld, float4(normal, 0.f)).xyz);
 
     return outData;
 }
\ No newline at end of file
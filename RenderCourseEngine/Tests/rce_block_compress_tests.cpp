@@ -0,0 +1,207 @@
+#include "Test.hpp"
+
+#include "rce_block_compress.h"
+
+#include <algorithm>
+#include <stdlib.h>
+#include <string.h>
+
+using namespace RCE::BlockCompress;
+
+namespace {
+	void FillBlock(uint8_t block[64], uint8_t r, uint8_t g, uint8_t b, uint8_t a) {
+		for (int i = 0; i < 16; i++) {
+			block[i * 4 + 0] = r;
+			block[i * 4 + 1] = g;
+			block[i * 4 + 2] = b;
+			block[i * 4 + 3] = a;
+		}
+	}
+
+	// Encodes and decodes one block, channels the format does not store are copied from the input so whole blocks compare
+	void RoundTrip(BlockFormat format, const uint8_t block[64], uint8_t decoded[64]) {
+		uint8_t encoded[16];
+		EncodeBlock(format, block, encoded);
+		DecodeBlock(format, encoded, decoded);
+		const int channels = format == BlockFormat::BC1 ? 3 : ChannelCount(format);
+		for (int i = 0; i < 16; i++) {
+			for (int c = channels; c < 4; c++) {
+				decoded[i * 4 + c] = block[i * 4 + c];
+			}
+		}
+	}
+
+	// The 8-bit value a 5 or 6 bit 565 channel expands to
+	uint8_t Expand(int value, int bits) {
+		return (uint8_t)(bits == 5 ? (value << 3) | (value >> 2) : (value << 2) | (value >> 4));
+	}
+}
+
+SBL_TEST(ConstantBlocksRoundTripExactly) {
+	uint8_t block[64];
+	uint8_t decoded[64];
+	bool exact = true;
+
+	// BC1 is exact for colors 565 can hold
+	for (int r = 0; r < 32; r += 3) {
+		for (int g = 0; g < 64; g += 5) {
+			for (int b = 0; b < 32; b += 7) {
+				FillBlock(block, Expand(r, 5), Expand(g, 6), Expand(b, 5), 255);
+				RoundTrip(BlockFormat::BC1, block, decoded);
+				exact = exact && memcmp(block, decoded, 64) == 0;
+			}
+		}
+	}
+	SBL_CHECK(exact);
+
+	// BC4 is exact for every value
+	for (int v = 0; v < 256; v++) {
+		FillBlock(block, (uint8_t)v, 0, 0, 255);
+		RoundTrip(BlockFormat::BC4, block, decoded);
+		exact = exact && memcmp(block, decoded, 64) == 0;
+	}
+	SBL_CHECK(exact);
+
+	// BC7 mode 6 is exact unless a color holds both 0 and 255, which no pair of endpoints reaches, those are off by one
+	int largestError = 0;
+	for (int v = 0; v < 256; v++) {
+		const uint8_t color[4] = { (uint8_t)v, (uint8_t)(255 - v), (uint8_t)(v * 7), (uint8_t)(v * 13) };
+		FillBlock(block, color[0], color[1], color[2], color[3]);
+		RoundTrip(BlockFormat::BC7, block, decoded);
+		if (memchr(color, 0, 4) && memchr(color, 255, 4)) {
+			for (int i = 0; i < 64; i++) {
+				largestError = std::max(largestError, abs(block[i] - decoded[i]));
+			}
+		} else {
+			exact = exact && memcmp(block, decoded, 64) == 0;
+		}
+	}
+	SBL_CHECK(exact);
+	SBL_CHECK(largestError <= 1);
+}
+
+SBL_TEST(GradientBlocksKeepTheirQuality) {
+	// A smooth color ramp across the block, and one that runs along a diagonal with alpha
+	uint8_t horizontal[64];
+	uint8_t diagonal[64];
+	for (int y = 0; y < 4; y++) {
+		for (int x = 0; x < 4; x++) {
+			uint8_t* h = horizontal + (y * 4 + x) * 4;
+			h[0] = (uint8_t)(40 + x * 50);
+			h[1] = (uint8_t)(200 - x * 30);
+			h[2] = (uint8_t)(90 + x * 20 + y * 3);
+			h[3] = 255;
+			uint8_t* d = diagonal + (y * 4 + x) * 4;
+			const int t = x + y;
+			d[0] = (uint8_t)(t * 40);
+			d[1] = (uint8_t)(100 + t * 10);
+			d[2] = (uint8_t)(250 - t * 35);
+			d[3] = (uint8_t)(255 - t * 30);
+		}
+	}
+
+	// Floors sit about a decibel under what the encoder measures. The diagonal takes seven steps, more than BC1's four
+	// palette entries can follow, and BC4's eight entries do not land on its spacing.
+	uint8_t decoded[64];
+	RoundTrip(BlockFormat::BC1, horizontal, decoded);
+	SBL_CHECK(PeakSignalToNoise(horizontal, decoded, 16, 3) > 38.5);
+	RoundTrip(BlockFormat::BC1, diagonal, decoded);
+	SBL_CHECK(PeakSignalToNoise(diagonal, decoded, 16, 3) > 23.5);
+	RoundTrip(BlockFormat::BC4, horizontal, decoded);
+	SBL_CHECK(PeakSignalToNoise(horizontal, decoded, 16, 1) > 33.0);
+	RoundTrip(BlockFormat::BC4, diagonal, decoded);
+	SBL_CHECK(PeakSignalToNoise(diagonal, decoded, 16, 1) > 26.0);
+	RoundTrip(BlockFormat::BC7, horizontal, decoded);
+	SBL_CHECK(PeakSignalToNoise(horizontal, decoded, 16, 4) > 42.0);
+	RoundTrip(BlockFormat::BC7, diagonal, decoded);
+	SBL_CHECK(PeakSignalToNoise(diagonal, decoded, 16, 4) > 37.0);
+}
+
+SBL_TEST(BC7Mode6BitLayout) {
+	// Endpoint 0 is black and transparent with p-bit 0, endpoint 1 white and opaque with p-bit 1, pixel i uses index i.
+	// Mode bit 6, then R0 R1 G0 G1 B0 B1 A0 A1 at 7 bits, the p-bits, a 3-bit first index and 4-bit indices, LSB first.
+	const uint8_t expected[16] = { 0x40, 0xc0, 0x1f, 0xf0, 0x07, 0xfc, 0x01, 0x7f, 0x11, 0x32, 0x54, 0x76, 0x98, 0xba, 0xdc,
+		0xfe };
+	// (64 - w) * 0 + w * 255 + 32 >> 6 for the 4-bit weights
+	const uint8_t ramp[16] = { 0, 16, 36, 52, 68, 84, 104, 120, 135, 151, 171, 187, 203, 219, 239, 255 };
+
+	uint8_t decoded[64];
+	DecodeBC7(expected, decoded);
+	bool matches = true;
+	for (int i = 0; i < 16; i++) {
+		for (int c = 0; c < 4; c++) {
+			matches = matches && decoded[i * 4 + c] == ramp[i];
+		}
+	}
+	SBL_CHECK(matches);
+
+	// Pixels that are exactly the palette encode back to the same bits
+	uint8_t encoded[16];
+	EncodeBC7(decoded, encoded);
+	SBL_CHECK(memcmp(encoded, expected, 16) == 0);
+
+	// Any other mode decodes to the error color
+	uint8_t mode5[16];
+	memcpy(mode5, expected, 16);
+	mode5[0] = 0x20;
+	DecodeBC7(mode5, decoded);
+	bool zero = true;
+	for (int i = 0; i < 64; i++) {
+		zero = zero && decoded[i] == 0;
+	}
+	SBL_CHECK(zero);
+}
+
+SBL_TEST(BC1SwapsEndpointsIntoFourColorMode) {
+	// Red is 0xf800 and blue 0x001f, so red first is already four color mode; blue first has to be swapped
+	const uint16_t red = 0xf800;
+	const uint16_t blue = 0x001f;
+	// Pixel i uses index i % 4: blue, red, 2/3 blue, 2/3 red when blue is color0
+	const uint32_t indices = 0xe4e4e4e4;
+
+	uint8_t asWritten[8];
+	WriteBC1(blue, red, indices, asWritten);
+	uint16_t color0, color1;
+	uint32_t storedIndices;
+	memcpy(&color0, asWritten, 2);
+	memcpy(&color1, asWritten + 2, 2);
+	memcpy(&storedIndices, asWritten + 4, 4);
+	SBL_CHECK(color0 == red && color1 == blue);
+	SBL_CHECK(storedIndices == (indices ^ 0x55555555));
+
+	// Decodes to the pixels the unswapped endpoints and indices describe
+	int palette[4][4];
+	BC1Palette(blue, red, true, palette);
+	uint8_t decoded[64];
+	DecodeBC1(asWritten, false, decoded);
+	bool matches = true;
+	for (int i = 0; i < 16; i++) {
+		for (int c = 0; c < 4; c++) {
+			matches = matches && decoded[i * 4 + c] == palette[(indices >> (i * 2)) & 3][c];
+		}
+	}
+	SBL_CHECK(matches);
+
+	// Equal endpoints would select the three color mode, all indices go to color0 instead
+	uint8_t flat[8];
+	WriteBC1(red, red, indices, flat);
+	memcpy(&storedIndices, flat + 4, 4);
+	SBL_CHECK(storedIndices == 0);
+
+	// A two color block round trips exactly whichever end the fit calls high
+	uint8_t block[64];
+	for (int i = 0; i < 16; i++) {
+		const bool isRed = (i & 1) != 0;
+		block[i * 4 + 0] = isRed ? 255 : 0;
+		block[i * 4 + 1] = 0;
+		block[i * 4 + 2] = isRed ? 0 : 255;
+		block[i * 4 + 3] = 255;
+	}
+	uint8_t encoded[8];
+	EncodeBC1(block, encoded);
+	memcpy(&color0, encoded, 2);
+	memcpy(&color1, encoded + 2, 2);
+	SBL_CHECK(color0 > color1);
+	DecodeBC1(encoded, false, decoded);
+	SBL_CHECK(memcmp(block, decoded, 64) == 0);
+}
@@ -0,0 +1,95 @@
+#include "Test.hpp"
+
+#include "rce_frame_allocator.h"
+
+using namespace RCE;
+
+SBL_TEST(FrameAllocatorAlignsOddSizes) {
+	Upload::FrameAllocator allocator;
+	Upload::InitFrameAllocator(&allocator, 1 << 16, 2);
+	Upload::BeginFrame(&allocator, 0);
+
+	// Every size rounds up to the next 256 bytes, so the offsets step by that
+	SBL_CHECK(Upload::AllocateFrame(&allocator, 1) == 0);
+	SBL_CHECK(Upload::AllocateFrame(&allocator, 255) == 256);
+	SBL_CHECK(Upload::AllocateFrame(&allocator, 256) == 512);
+	SBL_CHECK(Upload::AllocateFrame(&allocator, 257) == 768);
+	SBL_CHECK(Upload::AllocateFrame(&allocator, 100) == 1280);
+	SBL_CHECK(allocator.used == 1536);
+
+	SBL::Test::Random random(11);
+	bool aligned = true;
+	for (int i = 0; i < 100; i++) {
+		const uint64_t offset = Upload::AllocateFrame(&allocator, 1 + (uint64_t)random.Range(0.0f, 600.0f));
+		aligned = aligned && offset != Upload::INVALID_OFFSET && offset % Upload::CONSTANT_ALIGNMENT == 0;
+	}
+	SBL_CHECK(aligned);
+}
+
+SBL_TEST(FrameAllocatorRegionsPerSlot) {
+	Upload::FrameAllocator allocator;
+	Upload::InitFrameAllocator(&allocator, 4096, 3);
+
+	// Each slot starts at its own region and stays inside it
+	for (int region = 0; region < 3; region++) {
+		Upload::BeginFrame(&allocator, region);
+		SBL_CHECK(Upload::AllocateFrame(&allocator, 100) == region * 4096);
+		SBL_CHECK(Upload::AllocateFrame(&allocator, 100) == region * 4096 + 256);
+	}
+}
+
+SBL_TEST(FrameAllocatorFullExactlyAtTheRegionEnd) {
+	Upload::FrameAllocator allocator;
+	Upload::InitFrameAllocator(&allocator, 1024, 2);
+	Upload::BeginFrame(&allocator, 1);
+
+	// More than a region never fits
+	SBL_CHECK(Upload::AllocateFrame(&allocator, 1025) == Upload::INVALID_OFFSET);
+
+	// 768 bytes leave room for exactly one more aligned allocation, the next one spills past the region
+	SBL_CHECK(Upload::AllocateFrame(&allocator, 700) == 1024);
+	SBL_CHECK(Upload::AllocateFrame(&allocator, 256) == 1024 + 768);
+	SBL_CHECK(allocator.used == 1024);
+	SBL_CHECK(Upload::AllocateFrame(&allocator, 1) == Upload::INVALID_OFFSET);
+
+	// A failed allocation takes nothing
+	SBL_CHECK(allocator.used == 1024);
+	SBL_CHECK(allocator.peak == 1024);
+}
+
+SBL_TEST(FrameAllocatorBeginFrameResets) {
+	Upload::FrameAllocator allocator;
+	Upload::InitFrameAllocator(&allocator, 1024, 2);
+	Upload::BeginFrame(&allocator, 0);
+	SBL_CHECK(Upload::AllocateFrame(&allocator, 1024) == 0);
+	SBL_CHECK(Upload::AllocateFrame(&allocator, 1) == Upload::INVALID_OFFSET);
+
+	// Another slot starts empty, and so does the same slot coming around again
+	Upload::BeginFrame(&allocator, 1);
+	SBL_CHECK(allocator.used == 0);
+	SBL_CHECK(Upload::AllocateFrame(&allocator, 512) == 1024);
+	Upload::BeginFrame(&allocator, 0);
+	SBL_CHECK(allocator.used == 0);
+	SBL_CHECK(Upload::AllocateFrame(&allocator, 1) == 0);
+
+	// The peak survives the reset
+	SBL_CHECK(allocator.peak == 1024);
+}
+
+SBL_TEST(FrameAllocatorRoundsRegionSizeDown) {
+	// 1000 bytes hold three whole 256-byte blocks, so regions are 768 bytes apart and a fourth block does not fit
+	Upload::FrameAllocator allocator;
+	Upload::InitFrameAllocator(&allocator, 1000, 2);
+	SBL_CHECK(allocator.regionSize == 768);
+
+	Upload::BeginFrame(&allocator, 1);
+	SBL_CHECK(Upload::AllocateFrame(&allocator, 512) == 768);
+	SBL_CHECK(Upload::AllocateFrame(&allocator, 256) == 768 + 512);
+	SBL_CHECK(Upload::AllocateFrame(&allocator, 1) == Upload::INVALID_OFFSET);
+
+	// Below one block a region holds nothing
+	Upload::InitFrameAllocator(&allocator, 255, 1);
+	SBL_CHECK(allocator.regionSize == 0);
+	Upload::BeginFrame(&allocator, 0);
+	SBL_CHECK(Upload::AllocateFrame(&allocator, 1) == Upload::INVALID_OFFSET);
+}
@@ -0,0 +1,91 @@
+#include "Test.hpp"
+
+#include "rce_frame_pacing.h"
+
+#include <vector>
+
+using namespace RCE;
+
+SBL_TEST(FrameWaitValueAtStartUp) {
+	// Until framesInFlight frames have been submitted nothing has to be waited for, the slots are all fresh
+	for (int framesInFlight = 1; framesInFlight <= 3; framesInFlight++) {
+		for (uint64_t lastSubmitted = 0; lastSubmitted < (uint64_t)framesInFlight; lastSubmitted++) {
+			SBL_CHECK(Pacing::FrameWaitValue(lastSubmitted, 0, framesInFlight) == 0);
+		}
+	}
+
+	// The frame after that waits for the first one
+	SBL_CHECK(Pacing::FrameWaitValue(1, 0, 1) == 1);
+	SBL_CHECK(Pacing::FrameWaitValue(2, 0, 2) == 1);
+	SBL_CHECK(Pacing::FrameWaitValue(3, 0, 3) == 1);
+}
+
+SBL_TEST(FrameWaitValueInSteadyState) {
+	// Frame v signals v and records into slot v % framesInFlight, like the render loop. Before recording it, only
+	// framesInFlight - 1 earlier frames may still be running, so it waits for v - framesInFlight, which is also the frame
+	// that used its slot last.
+	for (int framesInFlight = 1; framesInFlight <= 3; framesInFlight++) {
+		std::vector<uint64_t> slotFenceValue(framesInFlight, 0);
+		bool matches = true;
+		for (uint64_t v = 1; v <= 20; v++) {
+			const int slot = (int)(v % framesInFlight);
+			const uint64_t wait = Pacing::FrameWaitValue(v - 1, slotFenceValue[slot], framesInFlight);
+			const uint64_t expected = v > (uint64_t)framesInFlight ? v - framesInFlight : 0;
+			matches = matches && wait == expected;
+			slotFenceValue[slot] = v;
+		}
+		SBL_CHECK(matches);
+	}
+
+	// A slot used more recently than the in-flight limit still has to be free
+	SBL_CHECK(Pacing::FrameWaitValue(10, 9, 3) == 9);
+	SBL_CHECK(Pacing::FrameWaitValue(10, 8, 3) == 8);
+	SBL_CHECK(Pacing::FrameWaitValue(10, 7, 3) == 8);
+
+	// Dropping from three frames in flight to one leaves the slots with old values, the limit waits for everything
+	SBL_CHECK(Pacing::FrameWaitValue(10, 8, 1) == 10);
+	SBL_CHECK(Pacing::FrameWaitValue(10, 9, 2) == 9);
+}
+
+SBL_TEST(OverlapFractionFromBusyTimes) {
+	// Nothing recorded, or no GPU times back yet
+	Pacing::OverlapStats stats = {};
+	SBL_CHECK(Pacing::OverlapFraction(stats) == 0.0);
+	Pacing::RecordCpuFrame(&stats, 10.0, 0.0);
+	SBL_CHECK(Pacing::OverlapFraction(stats) == 0.0);
+
+	// CPU and GPU take turns: each works half of a 10 ms frame and the CPU waits out the other half
+	Pacing::OverlapStats alternating = {};
+	for (int i = 0; i < 10; i++) {
+		Pacing::RecordCpuFrame(&alternating, 10.0, 5.0);
+		Pacing::RecordGpuFrame(&alternating, 5.0);
+	}
+	SBL_CHECK_NEAR(Pacing::OverlapFraction(alternating), 0.0, 1e-9);
+
+	// Both work the whole frame
+	Pacing::OverlapStats overlapped = {};
+	for (int i = 0; i < 10; i++) {
+		Pacing::RecordCpuFrame(&overlapped, 10.0, 0.0);
+		Pacing::RecordGpuFrame(&overlapped, 10.0);
+	}
+	SBL_CHECK_NEAR(Pacing::OverlapFraction(overlapped), 1.0, 1e-9);
+
+	// The CPU is busy the whole frame and the GPU half of it. GPU times lag behind, so fewer of them have arrived, and
+	// they are averaged on their own.
+	Pacing::OverlapStats partial = {};
+	for (int i = 0; i < 10; i++) {
+		Pacing::RecordCpuFrame(&partial, 10.0, 0.0);
+		if (i >= 2) {
+			Pacing::RecordGpuFrame(&partial, 5.0);
+		}
+	}
+	SBL_CHECK_NEAR(Pacing::OverlapFraction(partial), 0.5, 1e-9);
+
+	// Waits longer than the frame count as no CPU time, and the fraction stays within 0 to 1
+	Pacing::OverlapStats clamped = {};
+	Pacing::RecordCpuFrame(&clamped, 10.0, 12.0);
+	Pacing::RecordGpuFrame(&clamped, 4.0);
+	SBL_CHECK(Pacing::OverlapFraction(clamped) == 0.0);
+	Pacing::RecordGpuFrame(&clamped, 40.0);
+	SBL_CHECK(Pacing::OverlapFraction(clamped) == 1.0);
+}
@@ -0,0 +1,72 @@
+#include "Test.hpp"
+
+#include "rce_job_pool.h"
+
+#include <atomic>
+#include <chrono>
+#include <vector>
+
+using namespace RCE;
+
+SBL_TEST(JobPoolHandsBackEveryJob) {
+	Jobs::JobPool pool;
+	std::vector<int> results(64, 0);
+	Jobs::StartJobs(&pool, (int)results.size(), [&results](int i) { results[i] = i * i; }, 4);
+
+	std::vector<bool> seen(results.size(), false);
+	int handedBack = 0;
+	while (!Jobs::AllJobsTaken(&pool)) {
+		const int i = Jobs::TryNextJob(&pool);
+		if (i < 0) {
+			std::this_thread::yield();
+			continue;
+		}
+		SBL_CHECK(!seen[i]);
+		SBL_CHECK(results[i] == i * i);
+		seen[i] = true;
+		handedBack++;
+	}
+	SBL_CHECK(handedBack == (int)results.size());
+	SBL_CHECK(Jobs::TryNextJob(&pool) == -1);
+	Jobs::JoinJobs(&pool);
+	SBL_CHECK(pool.workers.empty());
+}
+
+SBL_TEST(JobPoolCancelDropsJobsNotStarted) {
+	std::atomic<int> started{ 0 };
+	std::atomic<bool> release{ false };
+	{
+		Jobs::JobPool pool;
+		Jobs::StartJobs(&pool, 100, [&](int) {
+			started++;
+			while (!release) {
+				std::this_thread::yield();
+			}
+		}, 2);
+		while (started < 2) {
+			std::this_thread::yield();
+		}
+		Jobs::CancelJobs(&pool);
+		release = true;
+		Jobs::JoinJobs(&pool);
+	}
+	// Only the jobs that were already running when the pool was cancelled
+	SBL_CHECK(started == 2);
+}
+
+SBL_TEST(JobPoolDestructorJoinsRunningJobs) {
+	std::atomic<int> finished{ 0 };
+	{
+		Jobs::JobPool pool;
+		Jobs::StartJobs(&pool, 1000, [&finished](int) {
+			std::this_thread::sleep_for(std::chrono::microseconds(100));
+			finished++;
+		}, 2);
+		// Goes out of scope with jobs running, which would call std::terminate on joinable threads
+	}
+	SBL_CHECK(finished < 1000);
+
+	// A pool that never started any jobs
+	Jobs::JobPool idle;
+	(void)idle;
+}
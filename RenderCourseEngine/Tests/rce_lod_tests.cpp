@@ -0,0 +1,119 @@
+#include "Test.hpp"
+
+#include "rce_lod.h"
+#include "rce_mesh.h"
+
+#include <vector>
+
+using namespace RCE;
+using SBL::Math::Vector3;
+
+namespace {
+	// World space error of the sphere chain main.cpp draws, coarsest first
+	std::vector<float> SphereChainErrors() {
+		std::vector<Mesh::MeshData> lods;
+		Mesh::GenerateLodChain(Mesh::Primitive::Sphere, 8, 512, &lods);
+		std::vector<float> errors;
+		for (const Mesh::MeshData& lod : lods) {
+			errors.push_back(lod.geometricError);
+		}
+		return errors;
+	}
+
+	// Largest distance from the unit sphere over the centroids and edge midpoints of every triangle
+	float MeasuredSphereError(const Mesh::MeshData& mesh) {
+		float worst = 0.0f;
+		for (size_t i = 0; i < mesh.indices.size(); i += 3) {
+			const Vector3 a = mesh.vertices[mesh.indices[i]].position;
+			const Vector3 b = mesh.vertices[mesh.indices[i + 1]].position;
+			const Vector3 c = mesh.vertices[mesh.indices[i + 2]].position;
+			const Vector3 samples[] = { (a + b + c) / 3.0f, (a + b) * 0.5f, (b + c) * 0.5f, (a + c) * 0.5f };
+			for (const Vector3& sample : samples) {
+				worst = std::max(worst, 1.0f - Length(sample));
+			}
+		}
+		return worst;
+	}
+}
+
+SBL_TEST(TessellationErrorBoundsTheSphere) {
+	for (int segments = 8; segments <= 512; segments *= 2) {
+		Mesh::MeshData mesh;
+		Mesh::GenerateMesh(Mesh::Primitive::Sphere, segments, segments / 2, &mesh);
+		const float measured = MeasuredSphereError(mesh);
+		// An upper bound, but not so loose that LOD selection would keep needlessly fine levels
+		SBL_CHECK(measured <= mesh.geometricError * 1.01f);
+		SBL_CHECK(measured >= mesh.geometricError * 0.25f);
+	}
+}
+
+SBL_TEST(LodChainErrorsDecrease) {
+	const std::vector<float> errors = SphereChainErrors();
+	for (size_t level = 1; level < errors.size(); level++) {
+		// Doubling the segments and rings quarters a second order error
+		SBL_CHECK_NEAR(errors[level] / errors[level - 1], 0.25, 1e-3);
+	}
+	SBL_CHECK(Mesh::TessellationError(Mesh::Primitive::Plane, 8, 8) == 0.0f);
+}
+
+SBL_TEST(SelectLevelPicksTheCoarsestLevelUnderTheThreshold) {
+	const float errors[] = { 0.16f, 0.04f, 0.01f, 0.0025f };
+	SBL_CHECK(Lod::SelectLevel(errors, 4, 1.0f, -1) == 0);
+	SBL_CHECK(Lod::SelectLevel(errors, 4, 10.0f, -1) == 1);
+	SBL_CHECK(Lod::SelectLevel(errors, 4, 25.0f, -1) == 1);
+	SBL_CHECK(Lod::SelectLevel(errors, 4, 26.0f, -1) == 2);
+	// Nothing is fine enough, so the finest level is the best available
+	SBL_CHECK(Lod::SelectLevel(errors, 4, 1000.0f, -1) == 3);
+	SBL_CHECK(Lod::SelectLevel(errors, 4, 10.0f, -1, 0.5f) == 1);
+	SBL_CHECK(Lod::SelectLevel(errors, 4, 10.0f, -1, 0.3f) == 2);
+}
+
+SBL_TEST(SelectLevelIsMonotonicInScreenSize) {
+	const std::vector<float> errors = SphereChainErrors();
+	int previous = 0;
+	for (float pixelsPerUnit = 1.0f; pixelsPerUnit < 1e6f; pixelsPerUnit *= 1.05f) {
+		const int level = Lod::SelectLevel(errors.data(), (int)errors.size(), pixelsPerUnit, -1);
+		SBL_CHECK(level >= previous);
+		previous = level;
+	}
+	SBL_CHECK(previous == (int)errors.size() - 1);
+}
+
+SBL_TEST(SelectLevelHysteresisBand) {
+	const float errors[] = { 0.16f, 0.04f, 0.01f };
+	const float threshold = Lod::DEFAULT_PIXEL_ERROR / errors[0];
+
+	// Finer levels are picked as soon as the coarse one is over the threshold
+	SBL_CHECK(Lod::SelectLevel(errors, 3, threshold * 1.01f, 0) == 1);
+
+	// Going back to the coarse level waits until its error is under HYSTERESIS of the threshold
+	SBL_CHECK(Lod::SelectLevel(errors, 3, threshold, 1) == 1);
+	SBL_CHECK(Lod::SelectLevel(errors, 3, threshold * (Lod::HYSTERESIS + 0.01f), 1) == 1);
+	SBL_CHECK(Lod::SelectLevel(errors, 3, threshold * (Lod::HYSTERESIS - 0.01f), 1) == 0);
+
+	// An out of range previous level is ignored
+	SBL_CHECK(Lod::SelectLevel(errors, 3, threshold, 7) == 0);
+}
+
+SBL_TEST(SelectLevelDoesNotFlickerAtASwitchDistance) {
+	const std::vector<float> errors = SphereChainErrors();
+	const float threshold = Lod::DEFAULT_PIXEL_ERROR / errors[2];
+	int level = -1;
+	int switches = 0;
+	for (int frame = 0; frame < 100; frame++) {
+		// The object wobbles 10% around the point where level 2 becomes too coarse
+		const float pixelsPerUnit = threshold * (frame % 2 ? 1.1f : 0.9f);
+		const int selected = Lod::SelectLevel(errors.data(), (int)errors.size(), pixelsPerUnit, level);
+		switches += level >= 0 && selected != level;
+		level = selected;
+	}
+	SBL_CHECK(switches == 1);
+}
+
+SBL_TEST(PixelsPerUnitClampsToTheNearPlane) {
+	const Lod::Bounds bounds = { Vector3(0, 0, -10), 1.0f };
+	const float scale = Lod::ProjectionScale(1.0f, 720);
+	SBL_CHECK_NEAR(Lod::PixelsPerUnit(bounds, Vector3(0, 0, 0), scale, 0.1f), scale / 9.0f, 1e-3);
+	// The camera sits inside the bounds
+	SBL_CHECK_NEAR(Lod::PixelsPerUnit(bounds, Vector3(0, 0, -10.5f), scale, 0.1f), scale / 0.1f, 1e-2);
+}
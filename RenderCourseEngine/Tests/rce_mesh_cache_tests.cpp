@@ -0,0 +1,213 @@
+#include "Test.hpp"
+
+#include "rce_mesh.h"
+#include "rce_mesh_cache.h"
+
+#include <limits.h>
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+
+using namespace RCE;
+using MeshCache::LoadResult;
+using VertexFormat::Vertex;
+
+namespace {
+	const char* TEST_CACHE_PATH = "rce_mesh_cache_test.bin";
+	constexpr uint64_t SOURCE_KEY = 0x1234567890abcdefull;
+
+	// Two sphere levels laid out like main.cpp's BuildSphereMesh, with meshlets and 16-bit indices
+	MeshCache::MeshArrays BuildTestMesh() {
+		MeshCache::MeshArrays arrays = {};
+		std::vector<Vertex> vertices;
+		for (int segments : { 8, 16 }) {
+			Mesh::MeshData lod;
+			Mesh::GenerateMesh(Mesh::Primitive::Sphere, segments, segments / 2, &lod, 1);
+			Meshlet::MeshletData meshlets;
+			Meshlet::BuildMeshlets(lod.vertices.data(), (int)lod.vertices.size(), lod.indices.data(), lod.indices.size(),
+				&meshlets);
+
+			MeshCache::LodEntry entry = { (int)vertices.size(), (int)(arrays.indices.size() / 2), (int)lod.indices.size(),
+				lod.geometricError, (int)arrays.meshlets.size(), (int)meshlets.meshlets.size() };
+			arrays.lods.push_back(entry);
+			const int meshletVertexBase = (int)arrays.meshletVertices.size();
+			for (Meshlet::Meshlet meshlet : meshlets.meshlets) {
+				meshlet.vertexOffset += meshletVertexBase;
+				arrays.meshlets.push_back(meshlet);
+			}
+			arrays.meshletBounds.insert(arrays.meshletBounds.end(), meshlets.bounds.begin(), meshlets.bounds.end());
+			arrays.meshletVertices.insert(arrays.meshletVertices.end(), meshlets.vertices.begin(), meshlets.vertices.end());
+			arrays.meshletTriangles.insert(arrays.meshletTriangles.end(), meshlets.triangles.begin(), meshlets.triangles.end());
+
+			vertices.insert(vertices.end(), lod.vertices.begin(), lod.vertices.end());
+			for (int index : lod.indices) {
+				const uint16_t index16 = (uint16_t)index;
+				arrays.indices.insert(arrays.indices.end(), (const uint8_t*)&index16, (const uint8_t*)&index16 + 2);
+			}
+		}
+		arrays.vertexFormat = MeshCache::VERTEX_FORMAT_FULL;
+		arrays.vertexStride = sizeof(Vertex);
+		arrays.vertices.assign((const uint8_t*)vertices.data(), (const uint8_t*)(vertices.data() + vertices.size()));
+		arrays.indexStride = sizeof(uint16_t);
+		arrays.bounds.center = SBL::Math::Vector3(0, 0, 0);
+		arrays.bounds.radius = 1.0f;
+		return arrays;
+	}
+
+	std::vector<uint8_t> ReadWholeFile(const char* path) {
+		std::vector<uint8_t> bytes;
+		FILE* in = fopen(path, "rb");
+		if (in == nullptr) {
+			return bytes;
+		}
+		uint8_t buffer[4096];
+		size_t read;
+		while ((read = fread(buffer, 1, sizeof(buffer), in)) > 0) {
+			bytes.insert(bytes.end(), buffer, buffer + read);
+		}
+		fclose(in);
+		return bytes;
+	}
+
+	// The cached file's bytes, written once through WriteMeshCache
+	const std::vector<uint8_t>& CachedBytes() {
+		static const std::vector<uint8_t> bytes = [] {
+			MeshCache::MeshArrays arrays = BuildTestMesh();
+			MeshCache::WriteMeshCache(TEST_CACHE_PATH, MeshCache::ViewOf(arrays), SOURCE_KEY);
+			std::vector<uint8_t> written = ReadWholeFile(TEST_CACHE_PATH);
+			remove(TEST_CACHE_PATH);
+			return written;
+		}();
+		return bytes;
+	}
+
+	// Loads bytes as if they were a mapped file, so tests can corrupt them in memory
+	LoadResult LoadBytes(const std::vector<uint8_t>& bytes, uint64_t sourceKey = SOURCE_KEY, bool verifyChecksum = true) {
+		File::MappedFile file = {};
+		file.data = bytes.data();
+		file.size = bytes.size();
+		MeshCache::MeshView view;
+		return MeshCache::LoadMeshCache(file, sourceKey, &view, verifyChecksum);
+	}
+
+	// Overwrites one LOD or meshlet table entry and fixes up the checksum, so only the range checks can reject it
+	template<typename T>
+	std::vector<uint8_t> WithEntry(MeshCache::Section section, size_t index, const T& entry) {
+		std::vector<uint8_t> bytes = CachedBytes();
+		MeshCache::Header header;
+		memcpy(&header, bytes.data(), sizeof(header));
+		memcpy(bytes.data() + header.sections[section].offset + index * sizeof(T), &entry, sizeof(T));
+		header.checksum = File::Checksum64(bytes.data() + sizeof(header), bytes.size() - sizeof(header));
+		memcpy(bytes.data(), &header, sizeof(header));
+		return bytes;
+	}
+
+	template<typename T>
+	T EntryAt(MeshCache::Section section, size_t index) {
+		MeshCache::Header header;
+		memcpy(&header, CachedBytes().data(), sizeof(header));
+		T entry;
+		memcpy(&entry, CachedBytes().data() + header.sections[section].offset + index * sizeof(T), sizeof(T));
+		return entry;
+	}
+}
+
+SBL_TEST(MeshCacheRoundTrip) {
+	const MeshCache::MeshArrays arrays = BuildTestMesh();
+	SBL_CHECK(MeshCache::WriteMeshCache(TEST_CACHE_PATH, MeshCache::ViewOf(arrays), SOURCE_KEY));
+
+	File::MappedFile file;
+	SBL_CHECK(File::OpenMappedFile(TEST_CACHE_PATH, &file));
+	MeshCache::MeshView view = {};
+	SBL_CHECK(MeshCache::LoadMeshCache(file, SOURCE_KEY, &view) == LoadResult::Ok);
+	SBL_CHECK(view.vertexFormat == arrays.vertexFormat && view.vertexStride == arrays.vertexStride);
+	SBL_CHECK(view.vertexCount * view.vertexStride == arrays.vertices.size());
+	SBL_CHECK(memcmp(view.vertices, arrays.vertices.data(), arrays.vertices.size()) == 0);
+	SBL_CHECK(view.indexStride == 2 && view.indexCount * 2 == arrays.indices.size());
+	SBL_CHECK(memcmp(view.indices, arrays.indices.data(), arrays.indices.size()) == 0);
+	SBL_CHECK(view.lodCount == 2 && memcmp(view.lods, arrays.lods.data(), 2 * sizeof(MeshCache::LodEntry)) == 0);
+	SBL_CHECK(view.meshletCount == arrays.meshlets.size());
+	SBL_CHECK(memcmp(view.meshlets, arrays.meshlets.data(), arrays.meshlets.size() * sizeof(Meshlet::Meshlet)) == 0);
+	SBL_CHECK(memcmp(view.meshletBounds, arrays.meshletBounds.data(),
+		arrays.meshletBounds.size() * sizeof(Meshlet::MeshletBounds)) == 0);
+	SBL_CHECK(view.meshletVertexCount == arrays.meshletVertices.size());
+	SBL_CHECK(memcmp(view.meshletVertices, arrays.meshletVertices.data(), arrays.meshletVertices.size() * sizeof(int)) == 0);
+	SBL_CHECK(view.meshletTriangleBytes == arrays.meshletTriangles.size());
+	SBL_CHECK(memcmp(view.meshletTriangles, arrays.meshletTriangles.data(), arrays.meshletTriangles.size()) == 0);
+	SBL_CHECK(view.bounds.radius == 1.0f);
+	// Every section is used in place
+	SBL_CHECK((const uint8_t*)view.vertices >= file.data && (const uint8_t*)view.vertices < file.data + file.size);
+	SBL_CHECK(((uintptr_t)view.meshlets - (uintptr_t)file.data) % MeshCache::SECTION_ALIGNMENT == 0);
+
+	File::CloseMappedFile(&file);
+	remove(TEST_CACHE_PATH);
+}
+
+SBL_TEST(MeshCacheRejectsCorruptFiles) {
+	const std::vector<uint8_t>& good = CachedBytes();
+	SBL_CHECK(!good.empty());
+	SBL_CHECK(LoadBytes(good) == LoadResult::Ok);
+
+	// A flipped payload byte, anywhere after the header
+	for (size_t offset : { sizeof(MeshCache::Header), good.size() / 2, good.size() - 1 }) {
+		std::vector<uint8_t> flipped = good;
+		flipped[offset] ^= 0x10;
+		SBL_CHECK(LoadBytes(flipped) == LoadResult::ChecksumMismatch);
+	}
+
+	// Truncated inside the sections, and inside the header
+	std::vector<uint8_t> truncated(good.begin(), good.end() - 1);
+	SBL_CHECK(LoadBytes(truncated) == LoadResult::Invalid);
+	truncated.resize(sizeof(MeshCache::Header) - 1);
+	SBL_CHECK(LoadBytes(truncated) == LoadResult::Invalid);
+
+	std::vector<uint8_t> wrongMagic = good;
+	wrongMagic[0] ^= 1;
+	SBL_CHECK(LoadBytes(wrongMagic) == LoadResult::Invalid);
+
+	std::vector<uint8_t> wrongVersion = good;
+	wrongVersion[offsetof(MeshCache::Header, version)]++;
+	SBL_CHECK(LoadBytes(wrongVersion) == LoadResult::WrongVersion);
+
+	SBL_CHECK(LoadBytes(good, SOURCE_KEY + 1) == LoadResult::Stale);
+}
+
+SBL_TEST(MeshCacheRejectsOutOfRangeEntries) {
+	using MeshCache::LodEntry;
+	const LodEntry lod = EntryAt<LodEntry>(MeshCache::SECTION_LODS, 1);
+	SBL_CHECK(LoadBytes(WithEntry(MeshCache::SECTION_LODS, 1, lod)) == LoadResult::Ok);
+
+	std::vector<LodEntry> badLods(8, lod);
+	badLods[0].baseVertex = -1;
+	badLods[1].startIndex += 3;         // runs past the index section
+	badLods[2].indexCount = INT_MAX;
+	badLods[3].meshletOffset = -1;
+	badLods[4].meshletCount++;          // one meshlet past the table
+	badLods[5].meshletOffset = INT_MAX;
+	badLods[6].baseVertex = INT_MAX;
+	badLods[7].indexCount = -3;
+	for (const LodEntry& bad : badLods) {
+		// Caught by the range checks whether or not the checksum is verified
+		SBL_CHECK(LoadBytes(WithEntry(MeshCache::SECTION_LODS, 1, bad)) == LoadResult::Invalid);
+		SBL_CHECK(LoadBytes(WithEntry(MeshCache::SECTION_LODS, 1, bad), SOURCE_KEY, false) == LoadResult::Invalid);
+	}
+
+	// The last meshlet of the last level ends exactly at its level's indices and at the end of the triangle section
+	const size_t last = lod.meshletOffset + lod.meshletCount - 1;
+	const Meshlet::Meshlet meshlet = EntryAt<Meshlet::Meshlet>(MeshCache::SECTION_MESHLETS, last);
+	SBL_CHECK((meshlet.triangleOffset + meshlet.triangleCount) * 3 == lod.indexCount);
+
+	std::vector<Meshlet::Meshlet> badMeshlets(7, meshlet);
+	badMeshlets[0].vertexOffset = -1;
+	badMeshlets[1].vertexCount = INT_MAX;
+	badMeshlets[2].triangleOffset = -1;
+	badMeshlets[3].triangleCount++;     // one triangle past the level
+	badMeshlets[4].triangleCount = -1;
+	// Sums to more than INT_MAX, which wrapped to a negative end before the operands were widened
+	badMeshlets[5].triangleOffset = INT_MAX;
+	badMeshlets[5].triangleCount = INT_MAX;
+	badMeshlets[6].triangleCount = INT_MAX / 3 + 1;
+	for (const Meshlet::Meshlet& bad : badMeshlets) {
+		SBL_CHECK(LoadBytes(WithEntry(MeshCache::SECTION_MESHLETS, last, bad)) == LoadResult::Invalid);
+	}
+}
@@ -0,0 +1,68 @@
+#include "Test.hpp"
+
+#include "rce_mesh.h"
+
+#include <string.h>
+#include <vector>
+
+using namespace RCE::Mesh;
+
+namespace {
+	const Primitive ALL_PRIMITIVES[] = { Primitive::Sphere, Primitive::Torus, Primitive::Plane };
+
+	bool SameMesh(const MeshData& a, const MeshData& b) {
+		return a.vertices.size() == b.vertices.size() && a.indices == b.indices &&
+			memcmp(a.vertices.data(), b.vertices.data(), a.vertices.size() * sizeof(Vertex)) == 0 &&
+			a.geometricError == b.geometricError;
+	}
+}
+
+SBL_TEST(GeneratedMeshSizes) {
+	for (Primitive primitive : ALL_PRIMITIVES) {
+		MeshData mesh;
+		GenerateMesh(primitive, 24, 12, &mesh, 1);
+		SBL_CHECK((int)mesh.vertices.size() == VertexCount(24, 12));
+		SBL_CHECK((int)mesh.indices.size() == IndexCount(primitive, 24, 12));
+
+		bool inRange = true;
+		for (int index : mesh.indices) {
+			inRange = inRange && index >= 0 && index < (int)mesh.vertices.size();
+		}
+		SBL_CHECK(inRange);
+	}
+}
+
+SBL_TEST(SphereVerticesLieOnTheUnitSphere) {
+	MeshData mesh;
+	GenerateMesh(Primitive::Sphere, 512, 256, &mesh, 1);
+	double worst = 0.0;
+	for (const Vertex& vertex : mesh.vertices) {
+		worst = std::max(worst, fabs(Length(vertex.position) - 1.0));
+	}
+	SBL_CHECK(worst < 1e-6);
+}
+
+SBL_TEST(ThreadCountDoesNotChangeTheOutput) {
+	for (Primitive primitive : ALL_PRIMITIVES) {
+		std::vector<MeshData> serial;
+		GenerateLodChain(primitive, 8, 256, &serial, 1);
+		for (int threads : { 2, 3, 8 }) {
+			std::vector<MeshData> parallel;
+			GenerateLodChain(primitive, 8, 256, &parallel, threads);
+			SBL_CHECK(parallel.size() == serial.size());
+			for (size_t level = 0; level < serial.size() && level < parallel.size(); level++) {
+				SBL_CHECK(SameMesh(parallel[level], serial[level]));
+			}
+		}
+	}
+}
+
+SBL_TEST(LodChainLevels) {
+	std::vector<MeshData> lods;
+	GenerateLodChain(Primitive::Sphere, 8, 512, &lods);
+	SBL_CHECK(lods.size() == 7);
+	for (size_t level = 0; level < lods.size(); level++) {
+		const int segments = 8 << level;
+		SBL_CHECK((int)lods[level].vertices.size() == VertexCount(segments, segments / 2));
+	}
+}
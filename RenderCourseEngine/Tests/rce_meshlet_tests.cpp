@@ -0,0 +1,196 @@
+#include "Test.hpp"
+
+#include "rce_camera.h"
+#include "rce_mesh.h"
+#include "rce_meshlet.h"
+#include "rce_vertex_cache.h"
+
+#include <vector>
+
+using namespace RCE;
+using SBL::Math::Matrix44;
+using SBL::Math::Vector3;
+
+namespace {
+	struct SphereMeshlets {
+		Mesh::MeshData mesh;
+		Meshlet::MeshletData meshlets;
+	};
+
+	// The 64 segment sphere level, vertex cache optimized as main.cpp does before building meshlets
+	SphereMeshlets BuildSphereMeshlets() {
+		SphereMeshlets sphere;
+		Mesh::GenerateMesh(Mesh::Primitive::Sphere, 64, 32, &sphere.mesh);
+		std::vector<int> optimized(sphere.mesh.indices.size());
+		VertexCache::OptimizeVertexCache(sphere.mesh.indices.data(), sphere.mesh.indices.size(),
+			(int)sphere.mesh.vertices.size(), optimized.data());
+		sphere.mesh.indices.swap(optimized);
+		Meshlet::BuildMeshlets(sphere.mesh.vertices.data(), (int)sphere.mesh.vertices.size(), sphere.mesh.indices.data(),
+			sphere.mesh.indices.size(), &sphere.meshlets);
+		return sphere;
+	}
+
+	Vector3 TriangleNormal(const Mesh::MeshData& mesh, const int* tri) {
+		Vector3 p0 = mesh.vertices[tri[0]].position;
+		Vector3 p1 = mesh.vertices[tri[1]].position;
+		Vector3 p2 = mesh.vertices[tri[2]].position;
+		return CrossProduct(p2 - p0, p1 - p0);
+	}
+
+	Camera::Frustum LookAlongZ(Vector3 camPosition, float direction) {
+		return Camera::MakeFrustum(camPosition, Vector3(0, 0, direction), Vector3(0, 1, 0), SBL::Math::PI / 2, 16.0f / 9.0f,
+			0.1f, 100.0f);
+	}
+}
+
+SBL_TEST(MeshletsRespectTheLimits) {
+	const SphereMeshlets sphere = BuildSphereMeshlets();
+	const Meshlet::MeshletData& data = sphere.meshlets;
+
+	int triangles = 0;
+	int largestVertexCount = 0;
+	int largestTriangleCount = 0;
+	bool indicesMatch = true;
+	for (const Meshlet::Meshlet& meshlet : data.meshlets) {
+		SBL_CHECK(meshlet.vertexCount <= Meshlet::MAX_VERTICES);
+		SBL_CHECK(meshlet.triangleCount <= Meshlet::MAX_TRIANGLES);
+		SBL_CHECK(meshlet.triangleOffset == triangles);
+		largestVertexCount = std::max(largestVertexCount, meshlet.vertexCount);
+		largestTriangleCount = std::max(largestTriangleCount, meshlet.triangleCount);
+
+		// Local triangles map back to the original index buffer range
+		for (int i = 0; i < meshlet.triangleCount * 3; i++) {
+			const int local = data.triangles[meshlet.triangleOffset * 3 + i];
+			indicesMatch = indicesMatch && local < meshlet.vertexCount &&
+				data.vertices[meshlet.vertexOffset + local] == sphere.mesh.indices[meshlet.triangleOffset * 3 + i];
+		}
+		triangles += meshlet.triangleCount;
+	}
+	SBL_CHECK(indicesMatch);
+	SBL_CHECK(triangles * 3 == (int)sphere.mesh.indices.size());
+	// Meshlets are cut at the limits, not before them
+	SBL_CHECK(largestVertexCount == Meshlet::MAX_VERTICES || largestTriangleCount == Meshlet::MAX_TRIANGLES);
+	SBL_CHECK(data.bounds.size() == data.meshlets.size());
+}
+
+SBL_TEST(MeshletsCutAtCustomLimits) {
+	Mesh::MeshData mesh;
+	Mesh::GenerateMesh(Mesh::Primitive::Plane, 4, 4, &mesh);
+	Meshlet::MeshletData data;
+
+	Meshlet::BuildMeshlets(mesh.vertices.data(), (int)mesh.vertices.size(), mesh.indices.data(), mesh.indices.size(), &data,
+		3, 124);
+	SBL_CHECK(data.meshlets.size() * 3 == mesh.indices.size());
+
+	Meshlet::BuildMeshlets(mesh.vertices.data(), (int)mesh.vertices.size(), mesh.indices.data(), mesh.indices.size(), &data,
+		64, 2);
+	SBL_CHECK(data.meshlets.size() * 6 == mesh.indices.size());
+	for (const Meshlet::Meshlet& meshlet : data.meshlets) {
+		SBL_CHECK(meshlet.triangleCount == 2);
+	}
+}
+
+SBL_TEST(MeshletBoundsContainTheirVertices) {
+	const SphereMeshlets sphere = BuildSphereMeshlets();
+	const Meshlet::MeshletData& data = sphere.meshlets;
+	for (size_t m = 0; m < data.meshlets.size(); m++) {
+		const Meshlet::Meshlet& meshlet = data.meshlets[m];
+		const Meshlet::MeshletBounds& bounds = data.bounds[m];
+		for (int i = 0; i < meshlet.vertexCount; i++) {
+			const Vector3 p = sphere.mesh.vertices[data.vertices[meshlet.vertexOffset + i]].position;
+			SBL_CHECK(Length(p - bounds.center) <= bounds.radius * 1.0001f);
+		}
+		// Sphere meshlets face outwards
+		SBL_CHECK(DotProduct(bounds.coneAxis, bounds.center) > 0.0f);
+	}
+}
+
+SBL_TEST(ConeCullOnlyRejectsBackFacingMeshlets) {
+	const SphereMeshlets sphere = BuildSphereMeshlets();
+	const Meshlet::MeshletData& data = sphere.meshlets;
+	SBL::Test::Random random(89);
+
+	int rejected = 0;
+	for (int c = 0; c < 200; c++) {
+		const Vector3 camPosition = Normalized(Vector3(random.Range(-1, 1), random.Range(-1, 1), random.Range(-1, 1))) *
+			random.Range(1.5f, 20.0f);
+		for (size_t m = 0; m < data.meshlets.size(); m++) {
+			if (!Meshlet::IsBackFacing(data.bounds[m], camPosition)) {
+				continue;
+			}
+			rejected++;
+
+			// Every triangle of a rejected meshlet must face away from the camera
+			const Meshlet::Meshlet& meshlet = data.meshlets[m];
+			for (int t = 0; t < meshlet.triangleCount; t++) {
+				const int* tri = sphere.mesh.indices.data() + (meshlet.triangleOffset + t) * 3;
+				const Vector3 toTriangle = sphere.mesh.vertices[tri[0]].position - camPosition;
+				SBL_CHECK(DotProduct(TriangleNormal(sphere.mesh, tri), toTriangle) >= 0.0f);
+			}
+		}
+	}
+	// The cone is conservative but still rejects a good share of the far side
+	SBL_CHECK(rejected > 200 * (int)data.meshlets.size() / 5);
+}
+
+SBL_TEST(ConeCutoffOfFlatAndSpreadMeshlets) {
+	Mesh::MeshData plane;
+	Mesh::GenerateMesh(Mesh::Primitive::Plane, 2, 2, &plane);
+	Meshlet::MeshletData flat;
+	Meshlet::BuildMeshlets(plane.vertices.data(), (int)plane.vertices.size(), plane.indices.data(), plane.indices.size(),
+		&flat);
+	SBL_CHECK(flat.meshlets.size() == 1);
+	const Meshlet::MeshletBounds& bounds = flat.bounds[0];
+	// Identical normals make a zero width cone that rejects anything behind the plane
+	SBL_CHECK_NEAR(bounds.coneCutoff, 0.0f, 1e-3f);
+	SBL_CHECK(Meshlet::IsBackFacing(bounds, bounds.center - bounds.coneAxis * 5.0f));
+	SBL_CHECK(!Meshlet::IsBackFacing(bounds, bounds.center + bounds.coneAxis * 5.0f));
+
+	// A whole sphere in one meshlet has normals in every direction, so the cone must never reject it
+	Mesh::MeshData mesh;
+	Mesh::GenerateMesh(Mesh::Primitive::Sphere, 8, 4, &mesh);
+	Meshlet::MeshletData spread;
+	Meshlet::BuildMeshlets(mesh.vertices.data(), (int)mesh.vertices.size(), mesh.indices.data(), mesh.indices.size(),
+		&spread);
+	SBL_CHECK(spread.meshlets.size() == 1);
+	SBL_CHECK(spread.bounds[0].coneCutoff == 1.0f);
+	SBL_CHECK(!Meshlet::IsBackFacing(spread.bounds[0], Vector3(0, 0, -3)));
+}
+
+SBL_TEST(SphereInFrustumRejectsOutsideSpheres) {
+	const Camera::Frustum frustum = LookAlongZ(Vector3(0, 0, 0), 1.0f);
+	SBL_CHECK(Camera::SphereInFrustum(frustum, Vector3(0, 0, 10), 1.0f));
+	// Behind the camera, past the far plane, and off to each side
+	SBL_CHECK(!Camera::SphereInFrustum(frustum, Vector3(0, 0, -5), 1.0f));
+	SBL_CHECK(!Camera::SphereInFrustum(frustum, Vector3(0, 0, 102), 1.0f));
+	SBL_CHECK(!Camera::SphereInFrustum(frustum, Vector3(40, 0, 10), 1.0f));
+	SBL_CHECK(!Camera::SphereInFrustum(frustum, Vector3(-40, 0, 10), 1.0f));
+	SBL_CHECK(!Camera::SphereInFrustum(frustum, Vector3(0, 20, 10), 1.0f));
+	SBL_CHECK(!Camera::SphereInFrustum(frustum, Vector3(0, -20, 10), 1.0f));
+	// Straddling a plane still counts as inside
+	SBL_CHECK(Camera::SphereInFrustum(frustum, Vector3(0, 0, 100.5f), 1.0f));
+	SBL_CHECK(Camera::SphereInFrustum(frustum, Vector3(0, 0, -0.5f), 1.0f));
+	// The vertical fov is 90 degrees, so the top plane passes through y = z
+	SBL_CHECK(Camera::SphereInFrustum(frustum, Vector3(0, 10.5f, 10), 1.0f));
+	SBL_CHECK(!Camera::SphereInFrustum(frustum, Vector3(0, 11.5f, 10), 0.5f));
+}
+
+SBL_TEST(CullMeshletsAgainstTheCamera) {
+	const SphereMeshlets sphere = BuildSphereMeshlets();
+	const Meshlet::MeshletData& data = sphere.meshlets;
+	const Matrix44 objectToWorld = Matrix44::TranslationScale(Vector3(0, 0, 5), 2.0f);
+	std::vector<int> visible;
+
+	// Looking at the sphere: the far side is culled, the near side kept
+	const Vector3 camPosition = Vector3(0, 0, 0);
+	Meshlet::CullMeshlets(data, objectToWorld, 2.0f, camPosition, LookAlongZ(camPosition, 1.0f), &visible);
+	SBL_CHECK(!visible.empty());
+	SBL_CHECK(visible.size() < data.meshlets.size());
+	for (size_t i = 1; i < visible.size(); i++) {
+		SBL_CHECK(visible[i] > visible[i - 1]);
+	}
+
+	// Looking away from it: everything is outside the frustum
+	Meshlet::CullMeshlets(data, objectToWorld, 2.0f, camPosition, LookAlongZ(camPosition, -1.0f), &visible);
+	SBL_CHECK(visible.empty());
+}
@@ -0,0 +1,194 @@
+#include "Test.hpp"
+
+#include "rce_static_buffer.h"
+
+#include <string.h>
+#include <vector>
+
+using namespace RCE;
+
+namespace {
+	// Records what CreateStaticBuffer asks the device for, with staging memory and a copy batch the way main.cpp has them
+	struct MockDevice {
+		struct Buffer {
+			Upload::BufferHeap heap;
+			Upload::BufferState initialState;
+			std::vector<uint8_t> contents;
+		};
+		struct Call {
+			enum Type { Create, Write, Stage, Copy, Barrier } type;
+			Buffer* buffer;
+			uint64_t offset;
+			uint64_t size;
+			Upload::BufferState before;
+			Upload::BufferState after;
+		};
+
+		std::vector<Buffer*> buffers;
+		std::vector<Call> calls;
+		std::vector<uint8_t> staging;
+		Upload::UploadRing ring;
+		Upload::UploadScheduler scheduler;
+
+		MockDevice() : staging(4096) {
+			Upload::InitUploadRing(&ring, staging.size());
+			Upload::InitUploadScheduler(&scheduler, 2, 1 << 20);
+		}
+		~MockDevice() {
+			for (Buffer* buffer : buffers) {
+				delete buffer;
+			}
+		}
+
+		Upload::StaticBufferDevice Device() {
+			Upload::StaticBufferDevice device;
+			device.createBuffer = [this](Upload::BufferHeap heap, uint64_t size, Upload::BufferState initialState) {
+				buffers.push_back(new Buffer{ heap, initialState, std::vector<uint8_t>(size) });
+				calls.push_back({ Call::Create, buffers.back(), 0, size });
+				return (void*)buffers.back();
+			};
+			device.writeBuffer = [this](void* buffer, const void* data, uint64_t size) {
+				memcpy(((Buffer*)buffer)->contents.data(), data, size);
+				calls.push_back({ Call::Write, (Buffer*)buffer, 0, size });
+			};
+			device.writeStaging = [this](uint64_t stagingOffset, const void* data, uint64_t size) {
+				memcpy(staging.data() + stagingOffset, data, size);
+				calls.push_back({ Call::Stage, nullptr, stagingOffset, size });
+			};
+			device.copyFromStaging = [this](void* buffer, uint64_t stagingOffset, uint64_t size) {
+				if (!Upload::BatchOpen(&scheduler)) {
+					uint64_t waitFenceValue;
+					Upload::BeginBatch(&scheduler, &waitFenceValue);
+				}
+				// The copy runs when the batch does, the data is taken from staging then; see Submit
+				calls.push_back({ Call::Copy, (Buffer*)buffer, stagingOffset, size });
+			};
+			device.barrier = [this](void* buffer, Upload::BufferState before, Upload::BufferState after) {
+				calls.push_back({ Call::Barrier, (Buffer*)buffer, 0, 0, before, after });
+			};
+			return device;
+		}
+
+		// Submits the open batch and runs its copies, as the copy queue would, then returns the batch's fence value
+		uint64_t Submit() {
+			for (const Call& call : calls) {
+				if (call.type == Call::Copy) {
+					memcpy(call.buffer->contents.data(), staging.data() + call.offset, call.size);
+				}
+			}
+			const uint64_t fenceValue = Upload::EndBatch(&scheduler);
+			Upload::FinishSubmission(&ring, fenceValue);
+			return fenceValue;
+		}
+	};
+}
+
+SBL_TEST(StaticBufferCopiesIntoTheDefaultHeap) {
+	MockDevice mock;
+	std::vector<uint8_t> data(1000);
+	for (size_t i = 0; i < data.size(); i++) {
+		data[i] = (uint8_t)(i * 7);
+	}
+	uint64_t readyFenceValue = 0;
+	MockDevice::Buffer* buffer = (MockDevice::Buffer*)Upload::CreateStaticBuffer(mock.Device(), Upload::BufferHeap::Default,
+		data.data(), data.size(), &mock.ring, &mock.scheduler, &readyFenceValue);
+
+	SBL_CHECK(buffer->heap == Upload::BufferHeap::Default);
+	SBL_CHECK(buffer->initialState == Upload::BufferState::Common);
+	SBL_CHECK(readyFenceValue == 1);
+
+	// Create, stage, copy, then the barrier out of COPY_DEST, in that order
+	SBL_CHECK(mock.calls.size() == 4);
+	SBL_CHECK(mock.calls[0].type == MockDevice::Call::Create);
+	SBL_CHECK(mock.calls[1].type == MockDevice::Call::Stage);
+	SBL_CHECK(mock.calls[2].type == MockDevice::Call::Copy);
+	SBL_CHECK(mock.calls[2].buffer == buffer);
+	SBL_CHECK(mock.calls[2].offset == mock.calls[1].offset);
+	SBL_CHECK(mock.calls[2].size == data.size());
+	SBL_CHECK(mock.calls[3].type == MockDevice::Call::Barrier);
+	SBL_CHECK(mock.calls[3].buffer == buffer);
+	SBL_CHECK(mock.calls[3].before == Upload::BufferState::CopyDest);
+	SBL_CHECK(mock.calls[3].after == Upload::BufferState::Common);
+
+	// The staging memory stays in use until the batch that copies out of it has completed
+	SBL_CHECK(Upload::BytesInUse(&mock.ring) == data.size());
+	const uint64_t fenceValue = mock.Submit();
+	SBL_CHECK(fenceValue == readyFenceValue);
+	SBL_CHECK(buffer->contents == data);
+	Upload::Retire(&mock.ring, fenceValue - 1);
+	SBL_CHECK(Upload::BytesInUse(&mock.ring) == data.size());
+	Upload::Retire(&mock.ring, fenceValue);
+	SBL_CHECK(Upload::BytesInUse(&mock.ring) == 0);
+}
+
+SBL_TEST(StaticBuffersShareTheOpenBatch) {
+	MockDevice mock;
+	const uint32_t vertices[] = { 1, 2, 3 };
+	const uint16_t indices[] = { 0, 1, 2 };
+	uint64_t readyFenceValue = 0;
+	Upload::CreateStaticBuffer(mock.Device(), Upload::BufferHeap::Default, vertices, sizeof(vertices), &mock.ring,
+		&mock.scheduler, &readyFenceValue);
+	Upload::CreateStaticBuffer(mock.Device(), Upload::BufferHeap::Default, indices, sizeof(indices), &mock.ring,
+		&mock.scheduler, &readyFenceValue);
+
+	SBL_CHECK(readyFenceValue == 1);
+	SBL_CHECK(mock.scheduler.recordedCount == 2);
+	SBL_CHECK(mock.calls[5].offset % Upload::STATIC_BUFFER_ALIGNMENT == 0);
+	SBL_CHECK(mock.calls[5].offset >= sizeof(vertices));
+
+	const uint64_t fenceValue = mock.Submit();
+	SBL_CHECK(memcmp(mock.buffers[0]->contents.data(), vertices, sizeof(vertices)) == 0);
+	SBL_CHECK(memcmp(mock.buffers[1]->contents.data(), indices, sizeof(indices)) == 0);
+	Upload::Retire(&mock.ring, fenceValue);
+	SBL_CHECK(Upload::BytesInUse(&mock.ring) == 0);
+
+	// A buffer in the next batch is ready one fence value later
+	Upload::CreateStaticBuffer(mock.Device(), Upload::BufferHeap::Default, vertices, sizeof(vertices), &mock.ring,
+		&mock.scheduler, &readyFenceValue);
+	SBL_CHECK(readyFenceValue == 2);
+}
+
+SBL_TEST(StaticBufferInTheUploadHeapIsWrittenDirectly) {
+	MockDevice mock;
+	const float data[] = { 1.0f, 2.0f, 3.0f, 4.0f };
+	uint64_t readyFenceValue = 5;
+	MockDevice::Buffer* buffer = (MockDevice::Buffer*)Upload::CreateStaticBuffer(mock.Device(), Upload::BufferHeap::Upload,
+		data, sizeof(data), &mock.ring, &mock.scheduler, &readyFenceValue);
+
+	SBL_CHECK(buffer->heap == Upload::BufferHeap::Upload);
+	SBL_CHECK(buffer->initialState == Upload::BufferState::GenericRead);
+	SBL_CHECK(memcmp(buffer->contents.data(), data, sizeof(data)) == 0);
+	SBL_CHECK(mock.calls.size() == 2);
+	SBL_CHECK(mock.calls[1].type == MockDevice::Call::Write);
+	// Nothing staged, copied or waited for
+	SBL_CHECK(Upload::BytesInUse(&mock.ring) == 0);
+	SBL_CHECK(!Upload::BatchOpen(&mock.scheduler));
+	SBL_CHECK(readyFenceValue == 5);
+}
+
+SBL_TEST(StaticBufferFailsWhenStagingIsFull) {
+	MockDevice mock;
+	std::vector<uint8_t> data(3000);
+	uint64_t readyFenceValue = 0;
+	SBL_CHECK(Upload::CreateStaticBuffer(mock.Device(), Upload::BufferHeap::Default, data.data(), data.size(), &mock.ring,
+		&mock.scheduler, &readyFenceValue) != nullptr);
+
+	// Another 3000 bytes do not fit the 4096 byte ring until the first copy retires. Nothing is created or recorded.
+	const size_t callCount = mock.calls.size();
+	SBL_CHECK(Upload::CreateStaticBuffer(mock.Device(), Upload::BufferHeap::Default, data.data(), data.size(), &mock.ring,
+		&mock.scheduler, &readyFenceValue) == nullptr);
+	SBL_CHECK(mock.calls.size() == callCount);
+	SBL_CHECK(mock.buffers.size() == 1);
+	SBL_CHECK(readyFenceValue == 1);
+
+	Upload::Retire(&mock.ring, mock.Submit());
+	SBL_CHECK(Upload::CreateStaticBuffer(mock.Device(), Upload::BufferHeap::Default, data.data(), data.size(), &mock.ring,
+		&mock.scheduler, &readyFenceValue) != nullptr);
+
+	// Larger than the ring never fits, the upload heap is the way out
+	std::vector<uint8_t> large(5000);
+	SBL_CHECK(Upload::CreateStaticBuffer(mock.Device(), Upload::BufferHeap::Default, large.data(), large.size(),
+		&mock.ring, &mock.scheduler, &readyFenceValue) == nullptr);
+	SBL_CHECK(Upload::CreateStaticBuffer(mock.Device(), Upload::BufferHeap::Upload, large.data(), large.size(),
+		&mock.ring, &mock.scheduler, &readyFenceValue) != nullptr);
+}
@@ -0,0 +1,155 @@
+#include "Test.hpp"
+
+#include "rce_block_compress.h"
+#include "rce_texture_cache.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+
+using namespace RCE;
+using TextureCache::LoadResult;
+
+namespace {
+	const char* TEST_CACHE_PATH = "rce_texture_cache_test.bin";
+	constexpr uint64_t SOURCE_KEY = 0xfeedfacecafebeefull;
+
+	// A 20x12 gradient, so the chain has odd sizes and levels narrower than a block: 20x12 down to 1x1 in 5 levels
+	TextureCache::TextureArrays BuildTestTexture(bool compressed) {
+		const int width = 20;
+		const int height = 12;
+		std::vector<uint8_t> rgba((size_t)width * height * 4);
+		for (int y = 0; y < height; y++) {
+			for (int x = 0; x < width; x++) {
+				uint8_t* pixel = &rgba[((size_t)y * width + x) * 4];
+				pixel[0] = (uint8_t)(x * 12);
+				pixel[1] = (uint8_t)(y * 20);
+				pixel[2] = (uint8_t)((x + y) * 7);
+				pixel[3] = 255;
+			}
+		}
+		Mip::MipChain mips;
+		Mip::GenerateMips(rgba.data(), width, height, { Mip::Filter::Box, Mip::ColorSpace::SRGB, false, false }, &mips);
+
+		TextureCache::TextureArrays arrays;
+		if (compressed) {
+			BlockCompress::CompressedMips blocks;
+			BlockCompress::CompressMips(mips, BlockCompress::BlockFormat::BC1, &blocks, 1);
+			TextureCache::PackLevels(TextureCache::PIXEL_FORMAT_BC1, blocks.levels.data(), blocks.levels.size(),
+				blocks.blocks.data(), &arrays);
+		}
+		else {
+			TextureCache::PackLevels(TextureCache::PIXEL_FORMAT_RGBA8, mips.levels.data(), mips.levels.size(),
+				mips.pixels.data(), &arrays);
+		}
+		return arrays;
+	}
+
+	// The bytes WriteTextureCache produces for arrays
+	std::vector<uint8_t> CacheBytes(const TextureCache::TextureArrays& arrays, uint64_t sourceKey = SOURCE_KEY) {
+		std::vector<uint8_t> bytes;
+		if (!TextureCache::WriteTextureCache(TEST_CACHE_PATH, TextureCache::ViewOf(arrays), sourceKey)) {
+			return bytes;
+		}
+		FILE* in = fopen(TEST_CACHE_PATH, "rb");
+		uint8_t buffer[4096];
+		size_t read;
+		while (in != nullptr && (read = fread(buffer, 1, sizeof(buffer), in)) > 0) {
+			bytes.insert(bytes.end(), buffer, buffer + read);
+		}
+		if (in != nullptr) {
+			fclose(in);
+		}
+		remove(TEST_CACHE_PATH);
+		return bytes;
+	}
+
+	// Loads bytes as if they were a mapped file, so tests can corrupt them in memory
+	LoadResult LoadBytes(const std::vector<uint8_t>& bytes, uint64_t sourceKey = SOURCE_KEY) {
+		File::MappedFile file = {};
+		file.data = bytes.data();
+		file.size = bytes.size();
+		TextureCache::TextureView view;
+		return TextureCache::LoadTextureCache(file, sourceKey, &view);
+	}
+}
+
+SBL_TEST(TextureCacheRoundTrip) {
+	for (bool compressed : { false, true }) {
+		const TextureCache::TextureArrays arrays = BuildTestTexture(compressed);
+		SBL_CHECK(arrays.levels.size() == 5);
+		SBL_CHECK(TextureCache::WriteTextureCache(TEST_CACHE_PATH, TextureCache::ViewOf(arrays), SOURCE_KEY));
+
+		File::MappedFile file;
+		SBL_CHECK(File::OpenMappedFile(TEST_CACHE_PATH, &file));
+		TextureCache::TextureView view = {};
+		SBL_CHECK(TextureCache::LoadTextureCache(file, SOURCE_KEY, &view) == LoadResult::Ok);
+		SBL_CHECK(view.pixelFormat == arrays.pixelFormat && view.width == 20 && view.height == 12);
+		SBL_CHECK(view.levelCount == arrays.levels.size());
+		SBL_CHECK(memcmp(view.levels, arrays.levels.data(), arrays.levels.size() * sizeof(TextureCache::LevelEntry)) == 0);
+		SBL_CHECK(view.dataSize == arrays.data.size() && memcmp(view.data, arrays.data.data(), arrays.data.size()) == 0);
+		// The data section is laid out for the GPU copy
+		SBL_CHECK((view.data - file.data) % TextureCache::LEVEL_ALIGNMENT == 0);
+		for (size_t i = 0; i < view.levelCount; i++) {
+			SBL_CHECK(view.levels[i].offset % TextureCache::LEVEL_ALIGNMENT == 0);
+			SBL_CHECK(view.levels[i].rowPitch % TextureCache::ROW_PITCH_ALIGNMENT == 0);
+		}
+
+		File::CloseMappedFile(&file);
+		remove(TEST_CACHE_PATH);
+	}
+}
+
+SBL_TEST(TextureCacheRejectsCorruptFiles) {
+	const std::vector<uint8_t> good = CacheBytes(BuildTestTexture(true));
+	SBL_CHECK(!good.empty());
+	SBL_CHECK(LoadBytes(good) == LoadResult::Ok);
+
+	// A flipped byte in the level table's reserved field and in the data
+	for (size_t offset : { sizeof(TextureCache::Header) + 4 * sizeof(TextureCache::LevelEntry) +
+		offsetof(TextureCache::LevelEntry, reserved), good.size() - 1 }) {
+		std::vector<uint8_t> flipped = good;
+		flipped[offset] ^= 0x01;
+		SBL_CHECK(LoadBytes(flipped) == LoadResult::ChecksumMismatch);
+	}
+
+	// Truncated inside the data, inside the level table and inside the header
+	for (size_t size : { good.size() - 1, sizeof(TextureCache::Header) + 8, sizeof(TextureCache::Header) - 1 }) {
+		const std::vector<uint8_t> truncated(good.begin(), good.begin() + size);
+		SBL_CHECK(LoadBytes(truncated) == LoadResult::Invalid);
+	}
+
+	std::vector<uint8_t> wrongVersion = good;
+	wrongVersion[offsetof(TextureCache::Header, version)]++;
+	SBL_CHECK(LoadBytes(wrongVersion) == LoadResult::WrongVersion);
+
+	SBL_CHECK(LoadBytes(good, SOURCE_KEY ^ 1) == LoadResult::Stale);
+}
+
+SBL_TEST(TextureCacheChecksTheMipChain) {
+	// Each of these is written with a valid checksum and in range offsets, only the level table is wrong
+	const TextureCache::TextureArrays good = BuildTestTexture(false);
+
+	// A level that claims the size of the level above it, with a matching row layout that fits the data
+	TextureCache::TextureArrays sameSize = good;
+	sameSize.levels[1] = sameSize.levels[0];
+	SBL_CHECK(LoadBytes(CacheBytes(sameSize)) == LoadResult::Invalid);
+
+	// Rounding up instead of down, 20x12 -> 10x6 -> 5x3 -> 3x2
+	TextureCache::TextureArrays roundedUp = good;
+	TextureCache::LevelEntry& level3 = roundedUp.levels[3];
+	level3.width = 3;
+	level3.rowBytes = TextureCache::RowBytes(roundedUp.pixelFormat, 3);
+	level3.size = (uint64_t)level3.rowPitch * (level3.rowCount - 1) + level3.rowBytes;
+	SBL_CHECK(LoadBytes(CacheBytes(roundedUp)) == LoadResult::Invalid);
+
+	// One 1x1 level more than the chain has
+	TextureCache::TextureArrays extraLevel = good;
+	extraLevel.levels.push_back(extraLevel.levels.back());
+	SBL_CHECK(LoadBytes(CacheBytes(extraLevel)) == LoadResult::Invalid);
+
+	// A shorter chain is still a valid texture
+	TextureCache::TextureArrays shortChain = good;
+	shortChain.levels.resize(2);
+	SBL_CHECK(LoadBytes(CacheBytes(shortChain)) == LoadResult::Ok);
+}
@@ -0,0 +1,144 @@
+#include "Test.hpp"
+
+#include "rce_upload_ring.h"
+
+#include <deque>
+#include <vector>
+
+using namespace RCE;
+
+SBL_TEST(UploadRingAlignsAllocations) {
+	Upload::UploadRing ring;
+	Upload::InitUploadRing(&ring, 1 << 20);
+	SBL::Test::Random random(7);
+	for (int i = 0; i < 200; i++) {
+		const uint64_t alignment = 1ull << (int)random.Range(0.0f, 10.0f);
+		const uint64_t size = 1 + (uint64_t)random.Range(0.0f, 3000.0f);
+		const uint64_t offset = Upload::Allocate(&ring, size, alignment);
+		SBL_CHECK(offset != Upload::INVALID_OFFSET);
+		SBL_CHECK(offset % alignment == 0);
+		SBL_CHECK(offset + size <= ring.capacity);
+	}
+}
+
+SBL_TEST(UploadRingFullUntilRetired) {
+	Upload::UploadRing ring;
+	Upload::InitUploadRing(&ring, 1024);
+	SBL_CHECK(Upload::Allocate(&ring, 2048, 16) == Upload::INVALID_OFFSET);
+
+	SBL_CHECK(Upload::Allocate(&ring, 512, 16) == 0);
+	Upload::FinishSubmission(&ring, 1);
+	SBL_CHECK(Upload::Allocate(&ring, 512, 16) == 512);
+	Upload::FinishSubmission(&ring, 2);
+	SBL_CHECK(Upload::BytesInUse(&ring) == 1024);
+	SBL_CHECK(Upload::Allocate(&ring, 1, 1) == Upload::INVALID_OFFSET);
+
+	// A fence value nothing waits on yet frees nothing
+	Upload::Retire(&ring, 0);
+	SBL_CHECK(Upload::Allocate(&ring, 1, 1) == Upload::INVALID_OFFSET);
+
+	Upload::Retire(&ring, 1);
+	SBL_CHECK(Upload::BytesInUse(&ring) == 512);
+	SBL_CHECK(Upload::Allocate(&ring, 512, 16) == 0);
+	SBL_CHECK(Upload::Allocate(&ring, 1, 1) == Upload::INVALID_OFFSET);
+}
+
+SBL_TEST(UploadRingWrapsWithoutSplitting) {
+	Upload::UploadRing ring;
+	Upload::InitUploadRing(&ring, 1000);
+	SBL_CHECK(Upload::Allocate(&ring, 600, 1) == 0);
+	Upload::FinishSubmission(&ring, 1);
+	SBL_CHECK(Upload::Allocate(&ring, 300, 1) == 600);
+	Upload::FinishSubmission(&ring, 2);
+	Upload::Retire(&ring, 1);
+
+	// 100 bytes are left before the end, the allocation skips them and starts at 0, where it may not reach the live
+	// bytes at 600
+	SBL_CHECK(Upload::Allocate(&ring, 601, 1) == Upload::INVALID_OFFSET);
+	SBL_CHECK(Upload::Allocate(&ring, 200, 1) == 0);
+	SBL_CHECK(Upload::BytesInUse(&ring) == 300 + 100 + 200);
+	SBL_CHECK(Upload::Allocate(&ring, 400, 1) == 200);
+	SBL_CHECK(Upload::Allocate(&ring, 1, 1) == Upload::INVALID_OFFSET);
+	Upload::FinishSubmission(&ring, 3);
+
+	// Once everything has retired the ring starts over at 0 without skipping
+	Upload::Retire(&ring, 3);
+	SBL_CHECK(Upload::BytesInUse(&ring) == 0);
+	SBL_CHECK(Upload::Allocate(&ring, 1000, 1) == 0);
+}
+
+SBL_TEST(UploadRingRetiresInFenceOrder) {
+	Upload::UploadRing ring;
+	Upload::InitUploadRing(&ring, 4096);
+	for (uint64_t fence = 1; fence <= 4; fence++) {
+		SBL_CHECK(Upload::Allocate(&ring, 256, 256) != Upload::INVALID_OFFSET);
+		Upload::FinishSubmission(&ring, fence);
+	}
+	// A submission without allocations is not recorded, its fence value retires nothing
+	Upload::FinishSubmission(&ring, 5);
+	SBL_CHECK(ring.submissions.size() == 4);
+
+	for (uint64_t fence = 1; fence <= 4; fence++) {
+		Upload::Retire(&ring, fence);
+		SBL_CHECK(Upload::BytesInUse(&ring) == (4 - fence) * 256);
+		SBL_CHECK(ring.submissions.size() == 4 - fence);
+	}
+
+	// Several submissions retire at once when the GPU has passed all of them
+	for (uint64_t fence = 6; fence <= 9; fence++) {
+		Upload::Allocate(&ring, 100, 4);
+		Upload::FinishSubmission(&ring, fence);
+	}
+	Upload::Retire(&ring, 7);
+	SBL_CHECK(ring.submissions.size() == 2);
+	Upload::Retire(&ring, 100);
+	SBL_CHECK(ring.submissions.empty());
+	SBL_CHECK(Upload::BytesInUse(&ring) == 0);
+}
+
+// Random allocations, submissions and out of step retirement, checked against every live range
+SBL_TEST(UploadRingNeverOverlapsLiveAllocations) {
+	struct Live {
+		uint64_t fenceValue;
+		uint64_t offset;
+		uint64_t size;
+	};
+	Upload::UploadRing ring;
+	Upload::InitUploadRing(&ring, 64 * 1024);
+	SBL::Test::Random random(2024);
+	std::deque<Live> live;
+	uint64_t fenceValue = 1;
+	uint64_t completed = 0;
+	int failed = 0;
+
+	for (int step = 0; step < 20000; step++) {
+		const uint64_t alignment = 1ull << (int)random.Range(0.0f, 10.0f);
+		const uint64_t size = 1 + (uint64_t)random.Range(0.0f, 8000.0f);
+		const uint64_t offset = Upload::Allocate(&ring, size, alignment);
+		if (offset == Upload::INVALID_OFFSET) {
+			failed++;
+		}
+		else {
+			SBL_CHECK(offset % alignment == 0);
+			SBL_CHECK(offset + size <= ring.capacity);
+			for (const Live& other : live) {
+				SBL_CHECK(offset + size <= other.offset || other.offset + other.size <= offset);
+			}
+			live.push_back({ fenceValue, offset, size });
+		}
+
+		if (random.Range(0.0f, 1.0f) < 0.3f) {
+			Upload::FinishSubmission(&ring, fenceValue++);
+		}
+		if (random.Range(0.0f, 1.0f) < 0.2f) {
+			completed = std::min(fenceValue - 1, completed + 1 + (uint64_t)random.Range(0.0f, 3.0f));
+			Upload::Retire(&ring, completed);
+			while (!live.empty() && live.front().fenceValue <= completed) {
+				live.pop_front();
+			}
+		}
+	}
+	// Both paths were exercised
+	SBL_CHECK(failed > 0);
+	SBL_CHECK(failed < 20000);
+}
@@ -0,0 +1,245 @@
+#include "Test.hpp"
+
+#include "rce_upload_ring.h"
+#include "rce_upload_scheduler.h"
+
+#include <deque>
+#include <vector>
+
+using namespace RCE;
+
+namespace {
+	// A copy queue that runs batches in submission order when told to, with the fence the scheduler's values are
+	// signalled on. Checks that an allocator is never reset while a batch recorded into it is still queued.
+	struct FakeCopyQueue {
+		struct Batch {
+			int allocator;
+			uint64_t fenceValue;
+		};
+		std::deque<Batch> queued;
+		std::vector<bool> allocatorBusy;
+		uint64_t completedFenceValue = 0;
+		bool allocatorResetWhileBusy = false;
+
+		explicit FakeCopyQueue(int allocatorCount) : allocatorBusy(allocatorCount, false) {}
+
+		// What OpenCopyBatch does: wait until the allocator is free, then reset it
+		int Open(Upload::UploadScheduler* scheduler) {
+			uint64_t waitFenceValue;
+			const int allocator = Upload::BeginBatch(scheduler, &waitFenceValue);
+			while (completedFenceValue < waitFenceValue) {
+				RunOne();
+			}
+			allocatorResetWhileBusy = allocatorResetWhileBusy || allocatorBusy[allocator];
+			return allocator;
+		}
+
+		// What SubmitCopyBatch does
+		uint64_t Submit(Upload::UploadScheduler* scheduler, int allocator) {
+			const uint64_t fenceValue = Upload::EndBatch(scheduler);
+			allocatorBusy[allocator] = true;
+			queued.push_back({ allocator, fenceValue });
+			return fenceValue;
+		}
+
+		void RunOne() {
+			const Batch batch = queued.front();
+			queued.pop_front();
+			allocatorBusy[batch.allocator] = false;
+			completedFenceValue = batch.fenceValue;
+		}
+	};
+}
+
+SBL_TEST(UploadSchedulerRotatesAllocators) {
+	Upload::UploadScheduler scheduler;
+	Upload::InitUploadScheduler(&scheduler, 3, 1000);
+	FakeCopyQueue queue(3);
+	SBL_CHECK(!Upload::BatchOpen(&scheduler));
+
+	for (uint64_t batch = 1; batch <= 10; batch++) {
+		const int allocator = queue.Open(&scheduler);
+		SBL_CHECK(Upload::BatchOpen(&scheduler));
+		SBL_CHECK(allocator == (int)((batch - 1) % 3));
+		// Every copy in the batch is done at the value the batch signals
+		SBL_CHECK(Upload::RecordCopy(&scheduler, 100) == batch);
+		SBL_CHECK(Upload::RecordCopy(&scheduler, 100) == batch);
+		SBL_CHECK(queue.Submit(&scheduler, allocator) == batch);
+		SBL_CHECK(!Upload::BatchOpen(&scheduler));
+		SBL_CHECK(scheduler.lastSubmitted == batch);
+	}
+	SBL_CHECK(!queue.allocatorResetWhileBusy);
+	SBL_CHECK(scheduler.totalBytes == 2000);
+	// Batches only ran when their allocator was needed back, so one per allocator is still queued
+	SBL_CHECK(queue.queued.size() == 3);
+	SBL_CHECK(queue.completedFenceValue == 7);
+}
+
+SBL_TEST(UploadSchedulerOpenBatchWaitsForItsAllocator) {
+	Upload::UploadScheduler scheduler;
+	Upload::InitUploadScheduler(&scheduler, 2, 1000);
+
+	uint64_t waitFenceValue;
+	SBL_CHECK(Upload::BeginBatch(&scheduler, &waitFenceValue) == 0);
+	SBL_CHECK(waitFenceValue == 0);
+	Upload::RecordCopy(&scheduler, 1);
+	Upload::EndBatch(&scheduler);
+	SBL_CHECK(Upload::BeginBatch(&scheduler, &waitFenceValue) == 1);
+	SBL_CHECK(waitFenceValue == 0);
+	Upload::RecordCopy(&scheduler, 1);
+	Upload::EndBatch(&scheduler);
+
+	// The third batch reuses allocator 0, which the first batch (fence value 1) used last
+	SBL_CHECK(Upload::BeginBatch(&scheduler, &waitFenceValue) == 0);
+	SBL_CHECK(waitFenceValue == 1);
+	Upload::EndBatch(&scheduler);
+	SBL_CHECK(Upload::BeginBatch(&scheduler, &waitFenceValue) == 1);
+	SBL_CHECK(waitFenceValue == 2);
+}
+
+// The render loop polls NextBatchReady instead of waiting in OpenCopyBatch
+SBL_TEST(UploadSchedulerNextBatchReadyPolls) {
+	Upload::UploadScheduler scheduler;
+	Upload::InitUploadScheduler(&scheduler, 2, 1000);
+	FakeCopyQueue queue(2);
+	SBL_CHECK(Upload::NextBatchReady(&scheduler, queue.completedFenceValue));
+
+	for (int batch = 0; batch < 2; batch++) {
+		const int allocator = queue.Open(&scheduler);
+		Upload::RecordCopy(&scheduler, 10);
+		queue.Submit(&scheduler, allocator);
+	}
+	// Both allocators are queued, the next batch is not ready until the first one has run
+	SBL_CHECK(!Upload::NextBatchReady(&scheduler, queue.completedFenceValue));
+	queue.RunOne();
+	SBL_CHECK(Upload::NextBatchReady(&scheduler, queue.completedFenceValue));
+
+	// Opening it now does not run anything else
+	const int allocator = queue.Open(&scheduler);
+	SBL_CHECK(allocator == 0);
+	SBL_CHECK(queue.queued.size() == 1);
+	SBL_CHECK(!queue.allocatorResetWhileBusy);
+	queue.Submit(&scheduler, allocator);
+	SBL_CHECK(!Upload::NextBatchReady(&scheduler, queue.completedFenceValue));
+	queue.RunOne();
+	SBL_CHECK(Upload::NextBatchReady(&scheduler, queue.completedFenceValue));
+}
+
+SBL_TEST(UploadSchedulerSubmitsFullOrFlushedBatches) {
+	Upload::UploadScheduler scheduler;
+	Upload::InitUploadScheduler(&scheduler, 2, 1000);
+	SBL_CHECK(!Upload::ShouldSubmit(&scheduler, true));
+
+	uint64_t waitFenceValue;
+	Upload::BeginBatch(&scheduler, &waitFenceValue);
+	// An empty batch is never worth submitting, not even when flushing
+	SBL_CHECK(!Upload::ShouldSubmit(&scheduler, true));
+
+	Upload::RecordCopy(&scheduler, 600);
+	SBL_CHECK(!Upload::ShouldSubmit(&scheduler, false));
+	SBL_CHECK(Upload::ShouldSubmit(&scheduler, true));
+	Upload::RecordCopy(&scheduler, 400);
+	SBL_CHECK(Upload::ShouldSubmit(&scheduler, false));
+
+	Upload::EndBatch(&scheduler);
+	SBL_CHECK(!Upload::ShouldSubmit(&scheduler, true));
+	// The byte count starts over with the next batch
+	Upload::BeginBatch(&scheduler, &waitFenceValue);
+	Upload::RecordCopy(&scheduler, 999);
+	SBL_CHECK(!Upload::ShouldSubmit(&scheduler, false));
+}
+
+SBL_TEST(UploadSchedulerWaitsOncePerFenceValue) {
+	Upload::UploadScheduler scheduler;
+	Upload::InitUploadScheduler(&scheduler, 2, 1000);
+	uint64_t waitFenceValue;
+	for (int batch = 0; batch < 3; batch++) {
+		Upload::BeginBatch(&scheduler, &waitFenceValue);
+		Upload::RecordCopy(&scheduler, 10);
+		Upload::EndBatch(&scheduler);
+	}
+
+	// Nothing to wait for before the first batch, or for a value already waited for
+	SBL_CHECK(!Upload::WaitNeeded(&scheduler, 0));
+	SBL_CHECK(Upload::WaitNeeded(&scheduler, 2));
+	SBL_CHECK(!Upload::WaitNeeded(&scheduler, 2));
+	// Waiting for 2 covered 1 as well
+	SBL_CHECK(!Upload::WaitNeeded(&scheduler, 1));
+	SBL_CHECK(Upload::WaitNeeded(&scheduler, 3));
+	SBL_CHECK(scheduler.lastWaited == 3);
+}
+
+// The render loop's texture uploads: a finished load that does not fit the staging ring waits for a later frame instead
+// of being staged at INVALID_OFFSET, and one larger than the whole ring is replaced by a placeholder
+SBL_TEST(UploadSchedulerDefersUploadsWhileTheRingIsFull) {
+	Upload::UploadScheduler scheduler;
+	Upload::InitUploadScheduler(&scheduler, 2, 1000);
+	Upload::UploadRing ring;
+	Upload::InitUploadRing(&ring, 1024);
+	FakeCopyQueue queue(2);
+
+	// Together three times the ring, in the order the loads finish; upload 4 can never fit
+	const uint64_t sizes[] = { 600, 300, 700, 200, 5000, 500, 800 };
+	const int uploadCount = (int)(sizeof(sizes) / sizeof(sizes[0]));
+	const uint64_t PLACEHOLDER_SIZE = 16;
+	int nextFinished = 0;
+	int deferred = -1;
+	int deferrals = 0;
+	std::vector<int> uploaded;
+	std::vector<uint64_t> uploadedSizes;
+	int allocator = -1;
+	auto submit = [&] {
+		Upload::FinishSubmission(&ring, queue.Submit(&scheduler, allocator));
+	};
+
+	for (int frame = 0; frame < 100 && (deferred >= 0 || nextFinished < uploadCount); frame++) {
+		while (Upload::BatchOpen(&scheduler) || Upload::NextBatchReady(&scheduler, queue.completedFenceValue)) {
+			int i = deferred;
+			if (i < 0) {
+				if (nextFinished == uploadCount) {
+					break;
+				}
+				i = nextFinished++;
+			}
+			uint64_t size = sizes[i];
+			uint64_t offset = Upload::Allocate(&ring, size, 256);
+			if (offset == Upload::INVALID_OFFSET && Upload::BytesInUse(&ring) == 0) {
+				size = PLACEHOLDER_SIZE;
+				offset = Upload::Allocate(&ring, size, 256);
+			}
+			if (offset == Upload::INVALID_OFFSET) {
+				deferred = i;
+				deferrals++;
+				break;
+			}
+			deferred = -1;
+			SBL_CHECK(offset + size <= ring.capacity);
+
+			if (!Upload::BatchOpen(&scheduler)) {
+				allocator = queue.Open(&scheduler);
+			}
+			Upload::RecordCopy(&scheduler, size);
+			uploaded.push_back(i);
+			uploadedSizes.push_back(size);
+			if (Upload::ShouldSubmit(&scheduler, false)) {
+				submit();
+			}
+		}
+		if (Upload::ShouldSubmit(&scheduler, true)) {
+			submit();
+		}
+
+		// The GPU gets through one batch a frame, the loop retires after recording like main.cpp
+		if (!queue.queued.empty()) {
+			queue.RunOne();
+		}
+		Upload::Retire(&ring, queue.completedFenceValue);
+	}
+
+	// Everything was uploaded once and in order, the oversized one as the placeholder
+	SBL_CHECK(deferred < 0 && nextFinished == uploadCount);
+	SBL_CHECK((uploaded == std::vector<int>{ 0, 1, 2, 3, 4, 5, 6 }));
+	SBL_CHECK(uploadedSizes[4] == PLACEHOLDER_SIZE);
+	SBL_CHECK(deferrals >= 3);
+	SBL_CHECK(!queue.allocatorResetWhileBusy);
+}
@@ -0,0 +1,87 @@
+#include "Test.hpp"
+
+#include "rce_mesh.h"
+#include "rce_vertex_cache.h"
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+using namespace RCE;
+
+namespace {
+	// Triangles rotated so the smallest index comes first, which keeps the winding, then sorted
+	std::vector<std::array<int, 3>> CanonicalTriangles(const std::vector<int>& indices) {
+		std::vector<std::array<int, 3>> triangles;
+		for (size_t i = 0; i < indices.size(); i += 3) {
+			std::array<int, 3> tri = { indices[i], indices[i + 1], indices[i + 2] };
+			std::rotate(tri.begin(), std::min_element(tri.begin(), tri.end()), tri.end());
+			triangles.push_back(tri);
+		}
+		std::sort(triangles.begin(), triangles.end());
+		return triangles;
+	}
+
+	std::vector<int> Optimized(const std::vector<int>& indices, int vertexCount) {
+		std::vector<int> out(indices.size());
+		VertexCache::OptimizeVertexCache(indices.data(), indices.size(), vertexCount, out.data());
+		return out;
+	}
+}
+
+SBL_TEST(ACMROfHandBuiltStrips) {
+	// A strip adds one vertex per triangle after the first: 6 misses for 4 triangles
+	const int strip[] = { 0, 1, 2, 1, 3, 2, 2, 3, 4, 3, 5, 4 };
+	SBL_CHECK_NEAR(VertexCache::ComputeACMR(strip, 12, 6, 3), 1.5f, 1e-6f);
+
+	// A fan around vertex 0. With a 3 entry FIFO, 0 is evicted by vertex 3 even though the second triangle hit it, so the
+	// third triangle misses it again: 3 + 1 + 2 misses. A 3 entry LRU, or a larger FIFO, would keep it.
+	const int fan[] = { 0, 1, 2, 0, 2, 3, 0, 3, 4 };
+	SBL_CHECK_NEAR(VertexCache::ComputeACMR(fan, 9, 5, 3), 2.0f, 1e-6f);
+	SBL_CHECK_NEAR(VertexCache::ComputeACMR(fan, 9, 5, 4), 5.0f / 3.0f, 1e-6f);
+
+	// Without a cache every vertex is transformed again
+	SBL_CHECK_NEAR(VertexCache::ComputeACMR(fan, 9, 5, 0), 3.0f, 1e-6f);
+	SBL_CHECK(VertexCache::ComputeACMR(fan, 2, 5) == 0.0f);
+}
+
+SBL_TEST(OptimizedSphereIsAPermutation) {
+	for (int segments : { 8, 64, 256 }) {
+		Mesh::MeshData mesh;
+		Mesh::GenerateMesh(Mesh::Primitive::Sphere, segments, segments / 2, &mesh);
+		const std::vector<int> optimized = Optimized(mesh.indices, (int)mesh.vertices.size());
+		SBL_CHECK(CanonicalTriangles(optimized) == CanonicalTriangles(mesh.indices));
+	}
+}
+
+SBL_TEST(OptimizedShuffleIsAPermutation) {
+	// Random triangles, including repeated ones, have no structure to exploit and hit the dead end scan
+	SBL::Test::Random random(3);
+	const int vertexCount = 200;
+	std::vector<int> indices;
+	for (int t = 0; t < 1000; t++) {
+		for (int k = 0; k < 3; k++) {
+			indices.push_back(std::min(vertexCount - 1, (int)random.Range(0, (float)vertexCount)));
+		}
+	}
+	indices.insert(indices.end(), indices.begin(), indices.begin() + 30);
+	const std::vector<int> optimized = Optimized(indices, vertexCount);
+	SBL_CHECK(CanonicalTriangles(optimized) == CanonicalTriangles(indices));
+}
+
+SBL_TEST(OptimizingDoesNotRaiseSphereACMR) {
+	std::vector<Mesh::MeshData> lods;
+	Mesh::GenerateLodChain(Mesh::Primitive::Sphere, 8, 512, &lods);
+	for (const Mesh::MeshData& lod : lods) {
+		const int vertexCount = (int)lod.vertices.size();
+		const std::vector<int> optimized = Optimized(lod.indices, vertexCount);
+		const float before = VertexCache::ComputeACMR(lod.indices.data(), lod.indices.size(), vertexCount);
+		const float after = VertexCache::ComputeACMR(optimized.data(), optimized.size(), vertexCount);
+		SBL_CHECK(after <= before);
+	}
+
+	// The finest level goes from 1.006 to 0.676, close to the 0.5 of an ideal grid order
+	const Mesh::MeshData& finest = lods.back();
+	const std::vector<int> optimized = Optimized(finest.indices, (int)finest.vertices.size());
+	SBL_CHECK(VertexCache::ComputeACMR(optimized.data(), optimized.size(), (int)finest.vertices.size()) < 0.7f);
+}
@@ -0,0 +1,215 @@
+#include "Test.hpp"
+
+#include "rce_vertex.h"
+
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+
+using namespace RCE::VertexFormat;
+
+namespace {
+	uint32_t FloatBits(float value) {
+		uint32_t bits;
+		memcpy(&bits, &value, sizeof(bits));
+		return bits;
+	}
+
+	float BitsFloat(uint32_t bits) {
+		float value;
+		memcpy(&value, &bits, sizeof(value));
+		return value;
+	}
+
+	uint32_t NextBits(uint32_t* state) {
+		*state ^= *state << 13;
+		*state ^= *state >> 17;
+		*state ^= *state << 5;
+		return *state;
+	}
+
+	Vector3 RandomUnit(SBL::Test::Random* random) {
+		for (;;) {
+			Vector3 v(random->Range(-1, 1), random->Range(-1, 1), random->Range(-1, 1));
+			if (LengthSquared(v) > 0.01f && LengthSquared(v) <= 1.0f) {
+				return Normalized(v);
+			}
+		}
+	}
+
+	// Includes texcoords outside [0, 1], which clamp, and normals on the octahedron's edges and the fold
+	// atan2 of the cross and dot products in double, acos of a float dot product can't resolve small angles
+	double NormalAngle(const Vector3& a, const Vector3& b) {
+		const double cx = (double)a.y * b.z - (double)a.z * b.y;
+		const double cy = (double)a.z * b.x - (double)a.x * b.z;
+		const double cz = (double)a.x * b.y - (double)a.y * b.x;
+		const double dot = (double)a.x * b.x + (double)a.y * b.y + (double)a.z * b.z;
+		return atan2(sqrt(cx * cx + cy * cy + cz * cz), dot);
+	}
+
+	std::vector<Vertex> TestVertices(size_t count) {
+		SBL::Test::Random random(17);
+		const Vector3 edgeNormals[] = { Vector3(0, 0, 1), Vector3(0, 0, -1), Vector3(1, 0, 0), Vector3(-1, 0, 0),
+			Vector3(0, -1, 0), Normalized(Vector3(1, -1, 0)), Normalized(Vector3(-1, 1, -1)) };
+		std::vector<Vertex> vertices(count);
+		for (size_t i = 0; i < count; i++) {
+			Vertex& v = vertices[i];
+			v.position = Vector3(random.Range(-100, 100), random.Range(-1, 1), random.Range(-1e-4f, 1e-4f));
+			v.u = random.Range(-0.2f, 1.2f);
+			v.v = random.Range(0, 1);
+			v.normals = i % 3 == 0 ? edgeNormals[i / 3 % 7] : RandomUnit(&random);
+		}
+		return vertices;
+	}
+}
+
+SBL_TEST(EncodeVerticesMatchesEncodeVertex) {
+	const std::vector<Vertex> vertices = TestVertices(64);
+	// Every tail length past the four-wide blocks
+	for (size_t count = 0; count <= 13; count++) {
+		std::vector<PackedVertex> batch(count);
+		EncodeVertices(vertices.data() + count, count, batch.data());
+		bool same = true;
+		for (size_t i = 0; i < count; i++) {
+			const PackedVertex single = EncodeVertex(vertices[count + i]);
+			same = same && memcmp(&single, &batch[i], sizeof(PackedVertex)) == 0;
+		}
+		SBL_CHECK(same);
+	}
+}
+
+SBL_TEST(DecodeVerticesMatchesDecodeVertex) {
+	// Every bit pattern is a valid packed vertex, including half infinities, NaNs and the -32768 normal
+	uint32_t state = 99;
+	std::vector<PackedVertex> packed(1003);
+	for (PackedVertex& p : packed) {
+		for (uint16_t& half : p.position) {
+			half = (uint16_t)NextBits(&state);
+		}
+		p.uv[0] = (uint16_t)NextBits(&state);
+		p.uv[1] = (uint16_t)NextBits(&state);
+		p.normal[0] = (int16_t)NextBits(&state);
+		p.normal[1] = (int16_t)NextBits(&state);
+	}
+	packed[0].normal[0] = -32768;
+	packed[1].normal[1] = -32768;
+	packed[2].uv[0] = 0xffff;
+
+	std::vector<Vertex> batch(packed.size());
+	DecodeVertices(packed.data(), packed.size(), batch.data());
+	bool same = true;
+	for (size_t i = 0; i < packed.size(); i++) {
+		const Vertex single = DecodeVertex(packed[i]);
+#ifdef SBL_MATH_FAST_MATH
+		// Only the normals differ, the batch normalizes precisely
+		same = same && memcmp(&single, &batch[i], offsetof(Vertex, normals)) == 0;
+#else
+		same = same && memcmp(&single, &batch[i], sizeof(Vertex)) == 0;
+#endif
+	}
+	SBL_CHECK(same);
+}
+
+SBL_TEST(HalfConversionRoundTrips) {
+	for (uint32_t half = 0; half < 0x10000; half++) {
+		const float value = HalfToFloat((uint16_t)half);
+		if (value != value) {
+			SBL_CHECK((FloatToHalf(value) & 0x7c00) == 0x7c00 && (FloatToHalf(value) & 0x3ff) != 0);
+			continue;
+		}
+		SBL_CHECK(FloatToHalf(value) == half);
+	}
+	// Halfway between two halves rounds to the even one
+	SBL_CHECK(FloatToHalf(1.0f + 1.0f / 2048.0f) == 0x3c00);
+	SBL_CHECK(FloatToHalf(1.0f + 3.0f / 2048.0f) == 0x3c02);
+	SBL_CHECK(FloatToHalf(65504.0f) == 0x7bff);
+	SBL_CHECK(FloatToHalf(65520.0f) == 0x7c00);
+	SBL_CHECK(FloatToHalf(-1e9f) == 0xfc00);
+}
+
+#if RCE_VERTEX_SSE2
+SBL_TEST(FloatToHalf4MatchesFloatToHalf) {
+	const float special[] = {
+		0.0f, -0.0f, 1.0f, -1.0f,
+		// Half denormals, the smallest half and values that round to zero or up into the normal range
+		5.96046448e-8f, 2.98023224e-8f, 2.98023252e-8f, 1.0e-5f, -3.0e-6f, 6.09755516e-5f, 6.10351562e-5f, 6.1e-5f,
+		1e-30f, BitsFloat(0x00000001u), BitsFloat(0x807fffffu),
+		// The largest half, values that round to it and values that overflow to infinity
+		65504.0f, 65519.0f, 65519.996f, 65520.0f, -65520.0f, 1e6f, 3.4e38f,
+		INFINITY, -INFINITY, NAN, -NAN, BitsFloat(0x7f800001u), BitsFloat(0xffc00000u), BitsFloat(0x7fffffffu),
+	};
+	bool same = true;
+	for (size_t i = 0; i < sizeof(special) / sizeof(special[0]); i += 4) {
+		float lanes[4] = { 0, 0, 0, 0 };
+		for (size_t j = 0; j < 4 && i + j < sizeof(special) / sizeof(special[0]); j++) {
+			lanes[j] = special[i + j];
+		}
+		uint32_t halves[4];
+		_mm_storeu_si128((__m128i*)halves, FloatToHalf4(_mm_loadu_ps(lanes)));
+		for (int j = 0; j < 4; j++) {
+			same = same && halves[j] == FloatToHalf(lanes[j]);
+		}
+	}
+	SBL_CHECK(same);
+
+	// And a sweep over random bit patterns, which covers every exponent
+	uint32_t state = 12345;
+	for (int i = 0; i < 250000; i++) {
+		uint32_t bits[4] = { NextBits(&state), NextBits(&state), NextBits(&state), NextBits(&state) };
+		uint32_t halves[4];
+		_mm_storeu_si128((__m128i*)halves, FloatToHalf4(_mm_loadu_ps((const float*)bits)));
+		for (int j = 0; j < 4; j++) {
+			same = same && halves[j] == FloatToHalf(BitsFloat(bits[j]));
+		}
+	}
+	SBL_CHECK(same);
+}
+
+SBL_TEST(HalfToFloat4MatchesHalfToFloat) {
+	bool same = true;
+	for (uint32_t half = 0; half < 0x10000; half += 4) {
+		uint32_t bits[4];
+		_mm_storeu_si128((__m128i*)bits, _mm_castps_si128(HalfToFloat4(_mm_setr_epi32(half, half + 1, half + 2, half + 3))));
+		for (uint32_t j = 0; j < 4; j++) {
+			same = same && bits[j] == FloatBits(HalfToFloat((uint16_t)(half + j)));
+		}
+	}
+	SBL_CHECK(same);
+}
+#endif
+
+SBL_TEST(OctahedralNormalsRoundTrip) {
+	SBL::Test::Random random(5);
+	double worst = 0.0;
+	for (int i = 0; i < 100000; i++) {
+		Vertex vertex = {};
+		vertex.normals = RandomUnit(&random);
+		const Vertex decoded = DecodeVertex(EncodeVertex(vertex));
+		worst = std::max(worst, NormalAngle(vertex.normals, decoded.normals));
+		SBL_CHECK_NEAR(Length(decoded.normals), 1.0f, 1e-5f);
+	}
+	// 16-bit octahedral normals measure 6.3e-5 radians worst case here, under 0.006 degrees
+	SBL_CHECK(worst < 1e-4);
+}
+
+SBL_TEST(SixteenBitIndicesAtTheLimit) {
+	SBL_CHECK(FitsSixteenBitIndices(0));
+	SBL_CHECK(FitsSixteenBitIndices(0xffff));
+	SBL_CHECK(FitsSixteenBitIndices(0x10000));
+	SBL_CHECK(!FitsSixteenBitIndices(0x10001));
+
+	// Values around the signed 16-bit bias of the SSE2 path, and counts past the eight-wide blocks
+	const int values[] = { 0, 1, 0x7ffe, 0x7fff, 0x8000, 0x8001, 0xfffe, 0xffff, 12345, 0xffff, 0, 0x8000, 0x7fff,
+		0xffff, 40000, 3, 0xffff };
+	const size_t valueCount = sizeof(values) / sizeof(values[0]);
+	for (size_t count = 0; count <= valueCount; count++) {
+		std::vector<uint16_t> packed(count + 1, 0xabcd);
+		PackIndices16(values, count, packed.data());
+		bool same = packed[count] == 0xabcd;
+		for (size_t i = 0; i < count; i++) {
+			same = same && packed[i] == (uint16_t)values[i];
+		}
+		SBL_CHECK(same);
+	}
+}
@@ -5,6 +5,7 @@
 #include <assert.h>
 #include <dxgi.h>
 #include <dxgi1_2.h>
+#include <dxgi1_3.h>
 #include <dxgi1_4.h>
 #include <dxcapi.h>
 #include <d3dcompiler.h>
@@ -15,11 +16,32 @@
 #pragma warning(pop)
 #include "d3dx12.h"
 #include "rce_camera.h"
+#include "rce_vertex.h"
+#include "rce_vertex_cache.h"
+#include "rce_mesh.h"
+#include "rce_lod.h"
+#include "rce_meshlet.h"
+#include "rce_mapped_file.h"
+#include "rce_mesh_cache.h"
+#include "rce_mip.h"
+#include "rce_block_compress.h"
+#include "rce_texture_cache.h"
+#include "rce_job_pool.h"
+#include "rce_upload_copy.h"
+#include "rce_upload_ring.h"
+#include "rce_upload_scheduler.h"
+#include "rce_static_buffer.h"
+#include "rce_frame_pacing.h"
+#include "rce_frame_allocator.h"
 
 #define _USE_MATH_DEFINES
 #include <math.h>
+#include <chrono>
+#include <sstream>
+#include <string>
 
 #include <SBLMath/Matrix44.hpp>
+#include <SBLMath/Transform.hpp>
 #include <SBLMath/Vector3.hpp>
 
 #pragma comment(lib,"d3d12.lib")
@@ -28,14 +50,64 @@
 #pragma comment(lib,"d3dcompiler.lib")
 
 bool Running;
+// Set by -frames and -measure-overlap. Per-frame and per-upload measurements only go to the console when it is, the
+// render path stays quiet otherwise.
+bool ReportStats;
 float ClearColor[4] = { 0, 0, 1.0f, 1.0f };
-const int BACKBUFFER_COUNT = 2;
-
-struct Vertex {
-	SBL::Math::Vector3 position;	// position
-	float u, v; // texcoord
-	SBL::Math::Vector3 normals; // normals
-};
+const int BACKBUFFER_COUNT = 3;
+// Frames the CPU may have submitted that the GPU has not finished, including the one being recorded, unless -frames N
+// says otherwise. Every frame in flight has its own command allocator and constant buffers, whatever the back buffer
+// count. SetMaximumFrameLatency takes up to 16.
+const int DEFAULT_FRAMES_IN_FLIGHT = 2;
+const int MAX_FRAMES_IN_FLIGHT = 16;
+// Frame pacing and CPU wait times are printed every this many frames when ReportStats is set
+const int PACING_REPORT_FRAMES = 300;
+// -measure-overlap renders with each of these frames-in-flight counts in turn, without vsync, and reports how much of the
+// CPU and GPU work overlapped. Measuring starts once the assets are resident and each count gets a warm up first.
+const int OVERLAP_FRAMES_IN_FLIGHT[] = { 1, 2, 3 };
+const int OVERLAP_WARMUP_FRAMES = 60;
+const int OVERLAP_MEASURE_FRAMES = 600;
+// Upload RCE::VertexFormat::PackedVertex (16 bytes) instead of the full float Vertex (32 bytes)
+const bool USE_PACKED_VERTICES = true;
+// Reorder mesh triangles for the post-transform vertex cache
+const bool OPTIMIZE_VERTEX_CACHE = true;
+// The sphere is generated as a LOD chain with 8, 16, ... 256 segments around the equator. 256 keeps every level within
+// 16-bit indices.
+const int SPHERE_MIN_SEGMENTS = 8;
+const int SPHERE_MAX_SEGMENTS = 256;
+// Largest tessellation error allowed on screen when picking a LOD level, in pixels
+const float LOD_PIXEL_ERROR = RCE::Lod::DEFAULT_PIXEL_ERROR;
+// Split the drawn LOD into meshlets and skip the ones that face away from the camera or are outside the frustum
+const bool USE_MESHLET_CULLING = true;
+// The built sphere is cached here, keyed by the settings above. Delete the file after changing the generator itself.
+const char* SPHERE_CACHE_PATH = "Assets/sphere.rcemesh";
+// Filter used to build texture mip chains
+const RCE::Mip::Filter MIP_FILTER = RCE::Mip::Filter::Kaiser;
+// Block compress textures on load. Single channel maps become BC4, color maps ALBEDO_BLOCK_FORMAT (BC1 is half the size of
+// BC7 but visibly blockier).
+const bool USE_BLOCK_COMPRESSION = true;
+const RCE::BlockCompress::BlockFormat ALBEDO_BLOCK_FORMAT = RCE::BlockCompress::BlockFormat::BC7;
+// Cooked textures are cached next to their source image with this suffix, keyed by the image bytes and the settings above.
+// Delete them after changing the mip or block compression code itself, or run with -cook.
+const char* TEXTURE_CACHE_SUFFIX = ".rcetex";
+// Copy into mapped upload buffers with non-temporal stores instead of memcpy
+const bool USE_STREAMING_UPLOADS = true;
+// Staging memory every upload goes through. It has to hold whatever is uploaded before the copy queue catches up.
+const uint64_t UPLOAD_RING_SIZE = 32 * 1024 * 1024;
+// Uploads are recorded on a copy queue in batches. A batch is submitted once it holds COPY_BATCH_SIZE bytes or nothing
+// else is ready to go into it. COPY_ALLOCATOR_COUNT batches can be in flight, further uploads are left for a later
+// frame until the oldest has completed.
+const uint64_t COPY_BATCH_SIZE = 8 * 1024 * 1024;
+const int COPY_ALLOCATOR_COUNT = 2;
+// Constant buffer memory for one frame, every frame in flight gets this much of one mapped upload buffer. Each object or
+// view takes a 256-byte aligned slice of it.
+const uint64_t FRAME_CONSTANTS_SIZE = 256 * 1024;
+// Debug mode: keep vertex and index buffers in the upload heap and draw straight from them, the way they used to be
+// created. Draws read the geometry across the bus, but the buffers stay CPU-visible and skip the copy.
+const bool USE_UPLOAD_HEAP_GEOMETRY = false;
+
+using RCE::VertexFormat::Vertex;
+using RCE::VertexFormat::PackedVertex;
 
 struct DirLight
 {
@@ -53,6 +125,16 @@ struct PointLight
 	float pad0;
 };
 
+// The point lights never move, so the whole table is built at compile time.
+constexpr PointLight POINT_LIGHTS[6] = {
+	{SBL::Math::Vector3(1, 0, 0), 0, SBL::Math::Vector3(5, 0, -5), 0},
+	{SBL::Math::Vector3(0, 1, 0), 0, SBL::Math::Vector3(0, 5, -5), 0},
+	{SBL::Math::Vector3(0, 0, 1), 0, SBL::Math::Vector3(0, 0, -5), 0},
+	{SBL::Math::Vector3(0, 1, 1), 0, SBL::Math::Vector3(5, 0, 5), 0},
+	{SBL::Math::Vector3(1, 0, 1), 0, SBL::Math::Vector3(0, 5, 5), 0},
+	{SBL::Math::Vector3(1, 1, 0), 0, SBL::Math::Vector3(5, 5, 5), 0},
+};
+
 struct CBView {
 	DirLight dirLight;
 	PointLight pointLight[6];
@@ -93,111 +175,452 @@ struct MyBitmap {
 	unsigned char* data;
 };
 
-MyBitmap MyLoadImage(const char* filepath) {
+// Decodes an image already in memory, free data with stbi_image_free
+MyBitmap MyLoadImage(const uint8_t* fileData, size_t fileSize) {
 	MyBitmap bitmap;
-	bitmap.data = stbi_load(filepath, &bitmap.width, &bitmap.height, &bitmap.channels, 4);
+	bitmap.data = stbi_load_from_memory(fileData, (int)fileSize, &bitmap.width, &bitmap.height, &bitmap.channels, 4);
 	bitmap.channels = 4;
 	return bitmap;
 }
 
-struct SphereDefinition {
-	Vertex* verts;
-	int* indices;
-	int vertCount;
-	int indexCount;
+struct TextureSource {
+	const char* path;
+	RCE::BlockCompress::TextureRole role;
+	uint8_t placeholder[4]; // RGBA drawn instead when the texture can't be loaded, neutral for how the shader uses it
 };
 
-void LoadImageIntoGPU(MyBitmap bm, ID3D12Device* device, ID3D12GraphicsCommandList* commandList, D3D12_CPU_DESCRIPTOR_HANDLE cpuDest) {
+// In descriptor heap order, t0 to t5 in SimpleShader.ps. The placeholders are mid grey for the surface, a flat bump, no
+// clouds (the shader draws clouds where the transparency map is dark), no city lights and no specular.
+const TextureSource TEXTURES[] = {
+	{ "Assets/earthmap1k.jpg", RCE::BlockCompress::TextureRole::Albedo, { 128, 128, 128, 255 } },
+	{ "Assets/earthbump1k.jpg", RCE::BlockCompress::TextureRole::SingleChannel, { 0, 0, 0, 255 } },
+	{ "Assets/earthcloudmap.jpg", RCE::BlockCompress::TextureRole::Albedo, { 255, 255, 255, 255 } },
+	{ "Assets/earthcloudmaptrans.jpg", RCE::BlockCompress::TextureRole::SingleChannel, { 255, 255, 255, 255 } },
+	{ "Assets/earthlights1k.jpg", RCE::BlockCompress::TextureRole::Albedo, { 0, 0, 0, 255 } },
+	{ "Assets/earthspec1k.jpg", RCE::BlockCompress::TextureRole::SingleChannel, { 0, 0, 0, 255 } },
+};
 
-	D3D12_HEAP_PROPERTIES defaultHeap = {};
-	defaultHeap.Type = D3D12_HEAP_TYPE_DEFAULT;
+DXGI_FORMAT PixelFormatToDxgi(uint32_t pixelFormat) {
+	switch (pixelFormat) {
+	case RCE::TextureCache::PIXEL_FORMAT_BC1: return DXGI_FORMAT_BC1_UNORM;
+	case RCE::TextureCache::PIXEL_FORMAT_BC3: return DXGI_FORMAT_BC3_UNORM;
+	case RCE::TextureCache::PIXEL_FORMAT_BC4: return DXGI_FORMAT_BC4_UNORM;
+	case RCE::TextureCache::PIXEL_FORMAT_BC5: return DXGI_FORMAT_BC5_UNORM;
+	case RCE::TextureCache::PIXEL_FORMAT_BC7: return DXGI_FORMAT_BC7_UNORM;
+	default: return DXGI_FORMAT_R8G8B8A8_UNORM;
+	}
+}
+
+// Identifies the source image and the settings a cooked texture was built with
+uint64_t TextureSourceKey(const RCE::File::MappedFile& source, RCE::BlockCompress::TextureRole role) {
+	int settings[] = { (int)role, (int)MIP_FILTER, USE_BLOCK_COMPRESSION, (int)ALBEDO_BLOCK_FORMAT };
+	return RCE::File::Checksum64(source.data, source.size, RCE::File::Checksum64(settings, sizeof(settings)));
+}
+
+// Builds the mip chain and compresses it into the texture cache layout, compressing on up to compressThreads threads (0
+// picks the hardware thread count)
+void CookTexture(MyBitmap bm, RCE::BlockCompress::TextureRole role, int compressThreads, RCE::TextureCache::TextureArrays* out,
+	std::ostream& log) {
+
+	// Color maps are filtered in linear light, data maps as they are
+	RCE::Mip::ColorSpace colorSpace = role == RCE::BlockCompress::TextureRole::Albedo ? RCE::Mip::ColorSpace::SRGB
+		: RCE::Mip::ColorSpace::Linear;
+
+	// The earth maps wrap around horizontally but not over the poles
+	RCE::Mip::Settings mipSettings = { MIP_FILTER, colorSpace, true, false };
+	RCE::Mip::MipChain mips;
+	auto mipStart = std::chrono::high_resolution_clock::now();
+	RCE::Mip::GenerateMips(bm.data, bm.width, bm.height, mipSettings, &mips);
+	auto mipEnd = std::chrono::high_resolution_clock::now();
+
+	double mipSeconds = std::chrono::duration<double>(mipEnd - mipStart).count();
+	double megapixels = (double)bm.width * bm.height / 1e6;
+	log << "Mips for " << bm.width << "x" << bm.height << (colorSpace == RCE::Mip::ColorSpace::SRGB ? " sRGB" : " linear")
+		<< " texture: " << mips.levels.size() << " levels in " << mipSeconds * 1000.0 << " ms ("
+		<< (mipSeconds > 0.0 ? megapixels / mipSeconds : 0.0) << " MP/s)\n";
+
+	// D3D12 only accepts block compressed textures whose top level is a whole number of blocks
+	if (!USE_BLOCK_COMPRESSION || bm.width % 4 != 0 || bm.height % 4 != 0) {
+		RCE::TextureCache::PackLevels(RCE::TextureCache::PIXEL_FORMAT_RGBA8, mips.levels.data(), mips.levels.size(),
+			mips.pixels.data(), out);
+		return;
+	}
+
+	RCE::BlockCompress::BlockFormat format = RCE::BlockCompress::FormatForRole(role, ALBEDO_BLOCK_FORMAT);
+	RCE::BlockCompress::CompressedMips blocks;
+	auto compressStart = std::chrono::high_resolution_clock::now();
+	RCE::BlockCompress::CompressMips(mips, format, &blocks, compressThreads);
+	auto compressEnd = std::chrono::high_resolution_clock::now();
+
+	// Quality is measured on the top level against the uncompressed pixels
+	std::vector<uint8_t> decoded((size_t)bm.width * bm.height * 4);
+	RCE::BlockCompress::DecompressImage(blocks.blocks.data(), bm.width, bm.height, format, decoded.data());
+	double psnr = RCE::BlockCompress::PeakSignalToNoise(mips.pixels.data(), decoded.data(), (size_t)bm.width * bm.height,
+		RCE::BlockCompress::ChannelCount(format));
+
+	double compressSeconds = std::chrono::duration<double>(compressEnd - compressStart).count();
+	double chainMegapixels = mips.pixels.size() / 4 / 1e6;
+	log << "  " << RCE::BlockCompress::FormatName(format) << ": " << compressSeconds * 1000.0 << " ms ("
+		<< (compressSeconds > 0.0 ? chainMegapixels / compressSeconds : 0.0) << " MP/s on "
+		<< (compressThreads > 0 ? compressThreads : (int)std::thread::hardware_concurrency()) << " threads), PSNR " << psnr
+		<< " dB, "
+		<< mips.pixels.size() / 1024 << " KB -> " << blocks.blocks.size() / 1024 << " KB\n";
+
+	RCE::TextureCache::PackLevels(RCE::TextureCache::PixelFormatOf(format), blocks.levels.data(), blocks.levels.size(),
+		blocks.blocks.data(), out);
+}
+
+// A 1x1 stand-in with source.placeholder for a texture that could not be loaded
+void MakePlaceholderTexture(const TextureSource& source, RCE::TextureCache::TextureArrays* out) {
+	const RCE::Mip::MipLevel level = { 1, 1, 0 };
+	RCE::TextureCache::PackLevels(RCE::TextureCache::PIXEL_FORMAT_RGBA8, &level, 1, source.placeholder, out);
+}
+
+// Maps the cooked texture cached next to source.path, or decodes, cooks and caches it when there is no cache built from the
+// current source and settings (always with forceCook), see CookTexture for compressThreads. cacheFile stays mapped for as
+// long as out is used, cooked holds the texture when it was not mapped. Returns false when the source image cannot be read.
+// Touches no global state, so several textures can load on different threads, each with its own log.
+bool LoadCookedTexture(const TextureSource& source, bool forceCook, int compressThreads, RCE::File::MappedFile* cacheFile,
+	RCE::TextureCache::TextureArrays* cooked, RCE::TextureCache::TextureView* out, std::ostream& log) {
+	auto loadStart = std::chrono::high_resolution_clock::now();
+	const std::string cachePath = std::string(source.path) + TEXTURE_CACHE_SUFFIX;
+
+	// Only hashed, the cache is checked before anything is decoded
+	RCE::File::MappedFile sourceFile;
+	if (!RCE::File::OpenMappedFile(source.path, &sourceFile)) {
+		log << "Texture " << source.path << ": cannot open\n";
+		return false;
+	}
+	const uint64_t sourceKey = TextureSourceKey(sourceFile, source.role);
+
+	RCE::TextureCache::LoadResult loadResult = RCE::TextureCache::LoadResult::Invalid;
+	bool cacheFound = !forceCook && RCE::File::OpenMappedFile(cachePath.c_str(), cacheFile);
+	if (cacheFound) {
+		loadResult = RCE::TextureCache::LoadTextureCache(*cacheFile, sourceKey, out);
+	}
+	if (loadResult == RCE::TextureCache::LoadResult::Ok) {
+		RCE::File::CloseMappedFile(&sourceFile);
+		auto loadEnd = std::chrono::high_resolution_clock::now();
+		log << "Texture " << source.path << ": mapped " << cacheFile->size << " bytes from " << cachePath << " in "
+			<< std::chrono::duration<double, std::milli>(loadEnd - loadStart).count() << " ms\n";
+		return true;
+	}
+	if (cacheFound) {
+		log << "Texture " << source.path << ": ignoring " << cachePath << " ("
+			<< RCE::TextureCache::LoadResultName(loadResult) << ")\n";
+	}
+	RCE::File::CloseMappedFile(cacheFile);
+
+	MyBitmap bitmap = MyLoadImage(sourceFile.data, sourceFile.size);
+	RCE::File::CloseMappedFile(&sourceFile);
+	if (bitmap.data == nullptr) {
+		log << "Texture " << source.path << ": cannot decode (" << stbi_failure_reason() << ")\n";
+		return false;
+	}
+	auto decodeEnd = std::chrono::high_resolution_clock::now();
+	CookTexture(bitmap, source.role, compressThreads, cooked, log);
+	stbi_image_free(bitmap.data);
+	*out = RCE::TextureCache::ViewOf(*cooked);
+	auto cookEnd = std::chrono::high_resolution_clock::now();
+
+	log << "Texture " << source.path << ": decoded in "
+		<< std::chrono::duration<double, std::milli>(decodeEnd - loadStart).count() << " ms, cooked in "
+		<< std::chrono::duration<double, std::milli>(cookEnd - decodeEnd).count() << " ms\n";
+	if (!RCE::TextureCache::WriteTextureCache(cachePath.c_str(), *out, sourceKey)) {
+		log << "Texture " << source.path << ": could not write " << cachePath << "\n";
+	}
+	return true;
+}
+
+// A texture loading on the texture job pool. Everything but the log is written by the worker and read once the job is
+// handed back by TryNextJob.
+struct TextureLoad {
+	RCE::File::MappedFile cacheFile;
+	RCE::TextureCache::TextureArrays cooked;
+	RCE::TextureCache::TextureView texture;
+	std::ostringstream log;
+	bool loaded;
+	double milliseconds;
+};
+
+// Loads every entry of TEXTURES on pool, loads[i] receives TEXTURES[i]. Take the finished ones with TryNextJob.
+void StartTextureLoads(RCE::Jobs::JobPool* pool, std::vector<TextureLoad>* loads) {
+	const int count = (int)(sizeof(TEXTURES) / sizeof(TEXTURES[0]));
+	loads->resize(count);
+
+	// Every worker may be cooking at once, so each compresses on its share of the cores instead of all of them
+	const int hardwareThreads = (int)std::max(1u, std::thread::hardware_concurrency());
+	const int compressThreads = std::max(1, hardwareThreads / std::min(count, hardwareThreads));
+	RCE::Jobs::StartJobs(pool, count, [loads, compressThreads](int i) {
+		TextureLoad& load = (*loads)[i];
+		auto loadStart = std::chrono::high_resolution_clock::now();
+		load.loaded = LoadCookedTexture(TEXTURES[i], false, compressThreads, &load.cacheFile, &load.cooked, &load.texture,
+			load.log);
+		auto loadEnd = std::chrono::high_resolution_clock::now();
+		load.milliseconds = std::chrono::duration<double, std::milli>(loadEnd - loadStart).count();
+	});
+}
+
+// Blocks until fence has reached value
+void WaitForFence(ID3D12Fence* fence, uint64_t value, HANDLE event) {
+	if (fence->GetCompletedValue() >= value) {
+		return;
+	}
+	HRESULT hr = fence->SetEventOnCompletion(value, event);
+	assert(SUCCEEDED(hr));
+	DWORD waitResult = WaitForSingleObject(event, INFINITE);
+	assert(waitResult == WAIT_OBJECT_0);
+}
 
+// Copies into a mapped upload heap buffer
+void CopyToUploadBuffer(void* dest, const void* source, size_t size) {
+	if (USE_STREAMING_UPLOADS) {
+		RCE::Upload::StreamCopy(dest, source, size);
+	}
+	else {
+		memcpy(dest, source, size);
+	}
+}
+
+// One upload heap buffer, mapped for its whole lifetime, that the ring hands out staging memory from
+struct UploadBuffer {
+	ID3D12Resource* resource;
+	uint8_t* mapped;
+	RCE::Upload::UploadRing ring;
+};
+
+// Creates an upload heap buffer and maps it for its whole lifetime
+void CreateMappedUploadBuffer(ID3D12Device* device, uint64_t size, ID3D12Resource** resource, uint8_t** mapped) {
 	D3D12_HEAP_PROPERTIES uploadHeap = {};
 	uploadHeap.Type = D3D12_HEAP_TYPE_UPLOAD;
+	D3D12_RESOURCE_DESC bufferDesc = CD3DX12_RESOURCE_DESC::Buffer(size);
+
+	HRESULT hr = device->CreateCommittedResource(
+		&uploadHeap,
+		D3D12_HEAP_FLAG_NONE,
+		&bufferDesc,
+		D3D12_RESOURCE_STATE_GENERIC_READ,
+		nullptr,
+		IID_PPV_ARGS(resource));
+	assert(SUCCEEDED(hr));
+
+	// No CPU reads will be done from the resource
+	D3D12_RANGE range = {};
+	hr = (*resource)->Map(0, &range, (void**)mapped);
+	assert(SUCCEEDED(hr));
+}
+
+void CreateUploadBuffer(ID3D12Device* device, uint64_t size, UploadBuffer* out) {
+	CreateMappedUploadBuffer(device, size, &out->resource, &out->mapped);
+	RCE::Upload::InitUploadRing(&out->ring, size);
+}
+
+// Constant buffers written by the CPU every frame, one FRAME_CONSTANTS_SIZE region per frame slot
+struct FrameConstants {
+	ID3D12Resource* resource;
+	uint8_t* mapped;
+	D3D12_GPU_VIRTUAL_ADDRESS gpuAddress;
+	RCE::Upload::FrameAllocator allocator;
+};
+
+void CreateFrameConstants(ID3D12Device* device, int slotCount, FrameConstants* out) {
+	CreateMappedUploadBuffer(device, FRAME_CONSTANTS_SIZE * slotCount, &out->resource, &out->mapped);
+	out->gpuAddress = out->resource->GetGPUVirtualAddress();
+	RCE::Upload::InitFrameAllocator(&out->allocator, FRAME_CONSTANTS_SIZE, slotCount);
+}
+
+// Copies data into the current frame's region and returns the address to bind it at
+D3D12_GPU_VIRTUAL_ADDRESS PushFrameConstants(FrameConstants* constants, const void* data, size_t size) {
+	const uint64_t offset = RCE::Upload::AllocateFrame(&constants->allocator, size);
+	assert(offset != RCE::Upload::INVALID_OFFSET && "FRAME_CONSTANTS_SIZE is too small for the frame");
+	memcpy(constants->mapped + offset, data, size);
+	return constants->gpuAddress + offset;
+}
+
+// The queue every upload is copied on, with the staging memory its batches read from. Its fence is signalled once per
+// batch: the staging memory retires against it, and the direct queue waits on it before drawing with what was uploaded.
+struct CopyQueue {
+	ID3D12CommandQueue* queue;
+	ID3D12CommandAllocator* allocators[COPY_ALLOCATOR_COUNT];
+	ID3D12GraphicsCommandList* commandList;
+	ID3D12Fence* fence;
+	UploadBuffer staging;
+	RCE::Upload::UploadScheduler scheduler;
+};
+
+void CreateCopyQueue(ID3D12Device* device, CopyQueue* out) {
+	D3D12_COMMAND_QUEUE_DESC queueDesc = {};
+	queueDesc.Type = D3D12_COMMAND_LIST_TYPE_COPY;
+	HRESULT hr = device->CreateCommandQueue(&queueDesc, IID_PPV_ARGS(&out->queue));
+	assert(SUCCEEDED(hr));
+
+	for (int i = 0; i < COPY_ALLOCATOR_COUNT; i++) {
+		hr = device->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_COPY, IID_PPV_ARGS(&out->allocators[i]));
+		assert(SUCCEEDED(hr));
+	}
+
+	// Command lists are created open, OpenCopyBatch resets it for every batch
+	hr = device->CreateCommandList(0, D3D12_COMMAND_LIST_TYPE_COPY, out->allocators[0], nullptr,
+		IID_PPV_ARGS(&out->commandList));
+	assert(SUCCEEDED(hr));
+	hr = out->commandList->Close();
+	assert(SUCCEEDED(hr));
+
+	hr = device->CreateFence(0, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&out->fence));
+	assert(SUCCEEDED(hr));
+
+	CreateUploadBuffer(device, UPLOAD_RING_SIZE, &out->staging);
+	RCE::Upload::InitUploadScheduler(&out->scheduler, COPY_ALLOCATOR_COUNT, COPY_BATCH_SIZE);
+}
+
+// True when copies can be recorded without waiting for the GPU: a batch is open, or the allocator the next one records
+// into has been released by the batch that used it last
+bool CopyBatchAvailable(CopyQueue* copy) {
+	return RCE::Upload::BatchOpen(&copy->scheduler) ||
+		RCE::Upload::NextBatchReady(&copy->scheduler, copy->fence->GetCompletedValue());
+}
+
+// Returns the copy command list, with a new batch opened on it if none is open. Never waits for the GPU, only call it
+// while CopyBatchAvailable; the render loop leaves its uploads for a later frame otherwise.
+ID3D12GraphicsCommandList* OpenCopyBatch(CopyQueue* copy) {
+	if (RCE::Upload::BatchOpen(&copy->scheduler)) {
+		return copy->commandList;
+	}
 
-	// Create buffer for the image to be placed into
+	assert(CopyBatchAvailable(copy) && "every copy allocator is still in use by the GPU");
+	uint64_t waitFenceValue;
+	int allocator = RCE::Upload::BeginBatch(&copy->scheduler, &waitFenceValue);
+	HRESULT hr = copy->allocators[allocator]->Reset();
+	assert(SUCCEEDED(hr));
+	hr = copy->commandList->Reset(copy->allocators[allocator], nullptr);
+	assert(SUCCEEDED(hr));
+	return copy->commandList;
+}
+
+// Submits the open batch, returns the fence value it signals
+uint64_t SubmitCopyBatch(CopyQueue* copy) {
+	HRESULT hr = copy->commandList->Close();
+	assert(SUCCEEDED(hr));
+	copy->queue->ExecuteCommandLists(1, (ID3D12CommandList**)&copy->commandList);
+
+	uint64_t fenceValue = RCE::Upload::EndBatch(&copy->scheduler);
+	hr = copy->queue->Signal(copy->fence, fenceValue);
+	assert(SUCCEEDED(hr));
+	RCE::Upload::FinishSubmission(&copy->staging.ring, fenceValue);
+	return fenceValue;
+}
+
+// Stages the texture and records its copy into copy's open batch. readyFenceValue is raised to the copy fence value the
+// texture is in place at. The texture is left in the common state, which the direct queue promotes it out of when it
+// is first sampled. Returns false without creating or recording anything when the staging ring has no room for the
+// texture until more batches retire.
+bool UploadTexture(const RCE::TextureCache::TextureView& texture, CopyQueue* copy, ID3D12Device* device,
+	D3D12_CPU_DESCRIPTOR_HANDLE cpuDest, uint64_t* readyFenceValue) {
+	const UINT mipCount = (UINT)texture.levelCount;
+
+	D3D12_HEAP_PROPERTIES defaultHeap = {};
+	defaultHeap.Type = D3D12_HEAP_TYPE_DEFAULT;
+
+	// Describe the buffer for the image to be placed into
 	HRESULT hr;
 	D3D12_RESOURCE_DESC textureBuffDesc = {};
-	ID3D12Resource* textureBuffer;
 	{
 		textureBuffDesc.Dimension = D3D12_RESOURCE_DIMENSION_TEXTURE2D;
 		textureBuffDesc.Alignment = D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT;
-		textureBuffDesc.Width = bm.width;
-		textureBuffDesc.Height = bm.height;
+		textureBuffDesc.Width = texture.width;
+		textureBuffDesc.Height = texture.height;
 		textureBuffDesc.DepthOrArraySize = 1;
-		textureBuffDesc.MipLevels = 1;
-		textureBuffDesc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
+		textureBuffDesc.MipLevels = (UINT16)mipCount;
+		// Stays UNORM for color maps too, the shaders expect the stored values. sRGB only changes how mips are filtered.
+		textureBuffDesc.Format = PixelFormatToDxgi(texture.pixelFormat);
 		textureBuffDesc.Layout = D3D12_TEXTURE_LAYOUT_UNKNOWN;
 		textureBuffDesc.SampleDesc.Quality = 0;
 		textureBuffDesc.SampleDesc.Count = 1;
-
-		hr = device->CreateCommittedResource(
-			&defaultHeap,
-			D3D12_HEAP_FLAG_NONE,
-			&textureBuffDesc,
-			D3D12_RESOURCE_STATE_COPY_DEST,
-			nullptr,
-			IID_PPV_ARGS(&textureBuffer));
-		assert(SUCCEEDED(hr));
 	}
 
 	// Deals with alignment issues and creates a footprint that was use to copy upload buffer to texture buffer
-	UINT64 textureUploadBufferSize;
-	D3D12_PLACED_SUBRESOURCE_FOOTPRINT footprint;
-	device->GetCopyableFootprints(&textureBuffDesc, 0, 1, 0, &footprint, nullptr, nullptr, &textureUploadBufferSize);
-
-	// Create upload buffer and copy resource to upload buffer
-	ID3D12Resource* textureUploadBuffer;
-	{
-		D3D12_RESOURCE_DESC uploadBuffDesc = CD3DX12_RESOURCE_DESC::Buffer(textureUploadBufferSize);
-
-		hr = device->CreateCommittedResource(
-			&uploadHeap,
-			D3D12_HEAP_FLAG_NONE,
-			&uploadBuffDesc,
-			D3D12_RESOURCE_STATE_GENERIC_READ,
-			nullptr,
-			IID_PPV_ARGS(&textureUploadBuffer));
-		assert(SUCCEEDED(hr));
+	UINT64 textureUploadSize;
+	std::vector<D3D12_PLACED_SUBRESOURCE_FOOTPRINT> footprints(mipCount);
+	std::vector<UINT> rowCounts(mipCount);
+	std::vector<UINT64> rowSizes(mipCount);
+	device->GetCopyableFootprints(&textureBuffDesc, 0, mipCount, 0, footprints.data(), rowCounts.data(), rowSizes.data(),
+		&textureUploadSize);
+
+	// The cache is written in the footprint layout, this only fails if a driver ever asks for a different one
+	bool sameLayout = textureUploadSize == texture.dataSize;
+	for (UINT mip = 0; mip < mipCount; mip++) {
+		const RCE::TextureCache::LevelEntry& level = texture.levels[mip];
+		sameLayout = sameLayout && footprints[mip].Offset == level.offset && footprints[mip].Footprint.RowPitch == level.rowPitch
+			&& rowCounts[mip] == level.rowCount && rowSizes[mip] == level.rowBytes;
+	}
 
-		void* gpuData;
-		D3D12_RANGE range = {};
-		hr = textureUploadBuffer->Map(0, &range, &gpuData);
-		assert(SUCCEEDED(hr));
+	// The footprints stay relative to the staging allocation, the copy commands below add its offset
+	const uint64_t uploadOffset = RCE::Upload::Allocate(&copy->staging.ring, textureUploadSize,
+		D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT);
+	if (uploadOffset == RCE::Upload::INVALID_OFFSET) {
+		return false;
+	}
 
-		const uint64_t k_channelCountDst = 4;
-		uint64_t rowPitch = footprint.Footprint.RowPitch;
-		uint64_t width = bm.width;
-		for (uint64_t h = 0; h < bm.height; ++h)
-		{
-			for (uint64_t w = 0; w < bm.width; ++w)
-			{
-				unsigned char* dst = ((unsigned char*)gpuData) + (h * rowPitch + k_channelCountDst * w);
+	ID3D12Resource* textureBuffer;
+	hr = device->CreateCommittedResource(
+		&defaultHeap,
+		D3D12_HEAP_FLAG_NONE,
+		&textureBuffDesc,
+		D3D12_RESOURCE_STATE_COMMON,
+		nullptr,
+		IID_PPV_ARGS(&textureBuffer));
+	assert(SUCCEEDED(hr));
 
-				unsigned char* src = bm.data + (k_channelCountDst * (h * width + w));
+	ID3D12GraphicsCommandList* commandList = OpenCopyBatch(copy);
+	{
+		uint8_t* gpuData = copy->staging.mapped + uploadOffset;
 
-				memcpy(dst, src, k_channelCountDst * sizeof(char));
+		// The cache already has the footprint layout, so everything goes in one copy. Otherwise every subresource is
+		// copied row by row into its footprint.
+		auto copyStart = std::chrono::high_resolution_clock::now();
+		if (sameLayout) {
+			CopyToUploadBuffer(gpuData, texture.data, texture.dataSize);
+		}
+		else {
+			std::vector<RCE::Upload::SubresourceCopy> copies(mipCount);
+			for (UINT mip = 0; mip < mipCount; mip++) {
+				const RCE::TextureCache::LevelEntry& level = texture.levels[mip];
+				copies[mip].destOffset = footprints[mip].Offset;
+				copies[mip].destRowPitch = footprints[mip].Footprint.RowPitch;
+				copies[mip].source = texture.data + level.offset;
+				copies[mip].sourceRowPitch = level.rowPitch;
+				copies[mip].sourceSlicePitch = level.size;
+				copies[mip].rowBytes = rowSizes[mip];
+				copies[mip].rowCount = rowCounts[mip];
+				copies[mip].depth = footprints[mip].Footprint.Depth;
 			}
+			RCE::Upload::CopySubresources(gpuData, copies.data(), copies.size(), USE_STREAMING_UPLOADS);
+		}
+		if (ReportStats) {
+			double copySeconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - copyStart).count();
+			std::cout << "  upload copy: " << textureUploadSize / 1024 << " KB in " << copySeconds * 1000.0 << " ms ("
+				<< (copySeconds > 0.0 ? textureUploadSize / copySeconds / 1e9 : 0.0) << " GB/s, "
+				<< (sameLayout ? "one copy" : "per row") << (USE_STREAMING_UPLOADS ? ", streaming" : ", memcpy") << ")\n";
 		}
-
-		textureUploadBuffer->Unmap(0, nullptr);
 	}
 
 	// Copy texture from upload heap to texture heap
 	{
-		D3D12_TEXTURE_COPY_LOCATION src = {};
-		src.pResource = textureUploadBuffer;
-		src.Type = D3D12_TEXTURE_COPY_TYPE_PLACED_FOOTPRINT;
-		src.PlacedFootprint = footprint;
-
-		D3D12_TEXTURE_COPY_LOCATION dest = {};
-		dest.pResource = textureBuffer;
-		dest.Type = D3D12_TEXTURE_COPY_TYPE_SUBRESOURCE_INDEX;
-
-		commandList->CopyTextureRegion(&dest, 0, 0, 0, &src, nullptr);
-
-		auto barrier = CD3DX12_RESOURCE_BARRIER::Transition(textureBuffer, D3D12_RESOURCE_STATE_COPY_DEST, D3D12_RESOURCE_STATE_GENERIC_READ);
-		commandList->ResourceBarrier(1, &barrier);
+		for (UINT mip = 0; mip < mipCount; mip++) {
+			D3D12_TEXTURE_COPY_LOCATION src = {};
+			src.pResource = copy->staging.resource;
+			src.Type = D3D12_TEXTURE_COPY_TYPE_PLACED_FOOTPRINT;
+			src.PlacedFootprint = footprints[mip];
+			src.PlacedFootprint.Offset += uploadOffset;
+
+			D3D12_TEXTURE_COPY_LOCATION dest = {};
+			dest.pResource = textureBuffer;
+			dest.Type = D3D12_TEXTURE_COPY_TYPE_SUBRESOURCE_INDEX;
+			dest.SubresourceIndex = mip;
+
+			commandList->CopyTextureRegion(&dest, 0, 0, 0, &src, nullptr);
+		}
+		*readyFenceValue = std::max(*readyFenceValue, RCE::Upload::RecordCopy(&copy->scheduler, textureUploadSize));
 	}
 
 
@@ -207,94 +630,195 @@ void LoadImageIntoGPU(MyBitmap bm, ID3D12Device* device, ID3D12GraphicsCommandLi
 		srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
 		srvDesc.Format = textureBuffDesc.Format;
 		srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
-		srvDesc.Texture2D.MipLevels = 1;
+		srvDesc.Texture2D.MipLevels = mipCount;
 		device->CreateShaderResourceView(textureBuffer, &srvDesc, cpuDest);
 	}
+	return true;
 }
 
-HRESULT CreateSphereMesh(int vertsPerLoop, int loopsPerHeight, SphereDefinition* out) {
-
-	long vertBufferSize = (vertsPerLoop+1) * (loopsPerHeight + 1) + 1; // extra loop to seam things together
-	Vertex* verts = new Vertex[vertBufferSize];//(Vertex*) malloc(sizeof(Vertex) * vertBufferSize);
-	if (verts == NULL) {
-		return -1;
+D3D12_RESOURCE_STATES ToD3D12(RCE::Upload::BufferState state) {
+	switch (state) {
+	case RCE::Upload::BufferState::CopyDest: return D3D12_RESOURCE_STATE_COPY_DEST;
+	case RCE::Upload::BufferState::GenericRead: return D3D12_RESOURCE_STATE_GENERIC_READ;
+	default: return D3D12_RESOURCE_STATE_COMMON;
 	}
+}
 
-	long indexBufferSize = vertBufferSize * 2L * 3L; // every vert has 2 triangles, and every triangle has 3 verts
-	int* indices = new int[indexBufferSize]; //(int*) malloc(sizeof(int) * indexBufferSize);
-	if (indices == NULL) {
-		return -1;
-	}
-
-	for (int y = 0; y <= loopsPerHeight; y++) {
-		float angleFromYAxis = (float) (y * M_PI / loopsPerHeight);
-		float yPos = cos(angleFromYAxis);
-		float radius = sin(angleFromYAxis);
-		float v = (float)(y) / loopsPerHeight;
-
-		for (int x = 0; x <= vertsPerLoop; x++) {
+// Records RCE::Upload::CreateStaticBuffer with device, staging through and copying on copy's open batch
+RCE::Upload::StaticBufferDevice MakeStaticBufferDevice(ID3D12Device* device, CopyQueue* copy) {
+	RCE::Upload::StaticBufferDevice out;
+	out.createBuffer = [device](RCE::Upload::BufferHeap heapType, uint64_t size, RCE::Upload::BufferState initialState) {
+		D3D12_HEAP_PROPERTIES heap = {};
+		heap.Type = heapType == RCE::Upload::BufferHeap::Upload ? D3D12_HEAP_TYPE_UPLOAD : D3D12_HEAP_TYPE_DEFAULT;
+		D3D12_RESOURCE_DESC bufferDesc = CD3DX12_RESOURCE_DESC::Buffer(size);
+		ID3D12Resource* buffer;
+		HRESULT hr = device->CreateCommittedResource(
+			&heap,
+			D3D12_HEAP_FLAG_NONE,
+			&bufferDesc,
+			ToD3D12(initialState),
+			nullptr,
+			IID_PPV_ARGS(&buffer));
+		assert(SUCCEEDED(hr));
+		return (void*)buffer;
+	};
+	out.writeBuffer = [](void* buffer, const void* data, uint64_t size) {
+		// No CPU reads will be done from the resource
+		void* gpuData;
+		D3D12_RANGE range = {};
+		HRESULT hr = ((ID3D12Resource*)buffer)->Map(0, &range, &gpuData);
+		assert(SUCCEEDED(hr));
+		CopyToUploadBuffer(gpuData, data, (size_t)size);
+		((ID3D12Resource*)buffer)->Unmap(0, nullptr);
+	};
+	out.writeStaging = [copy](uint64_t stagingOffset, const void* data, uint64_t size) {
+		CopyToUploadBuffer(copy->staging.mapped + stagingOffset, data, (size_t)size);
+	};
+	out.copyFromStaging = [copy](void* buffer, uint64_t stagingOffset, uint64_t size) {
+		OpenCopyBatch(copy)->CopyBufferRegion((ID3D12Resource*)buffer, 0, copy->staging.resource, stagingOffset, size);
+	};
+	out.barrier = [copy](void* buffer, RCE::Upload::BufferState before, RCE::Upload::BufferState after) {
+		D3D12_RESOURCE_BARRIER barrier = CD3DX12_RESOURCE_BARRIER::Transition((ID3D12Resource*)buffer, ToD3D12(before),
+			ToD3D12(after));
+		OpenCopyBatch(copy)->ResourceBarrier(1, &barrier);
+	};
+	return out;
+}
 
-			float angleAroundXAxis = (float) (x * 2.0 * M_PI / vertsPerLoop);
-			float xPos = radius * cos(angleAroundXAxis);
-			float zPos = radius * sin(angleAroundXAxis);
+// Creates a buffer the GPU only reads, for vertex and index data, in copy's open batch. readyFenceValue is raised to the
+// copy fence value it is in place at. With USE_UPLOAD_HEAP_GEOMETRY, or when the staging ring has no room for it, the
+// buffer is an upload heap buffer filled right away instead. See RCE::Upload::CreateStaticBuffer. Startup creates these
+// before any batch was submitted, so a batch is always available.
+ID3D12Resource* CreateStaticBuffer(const void* data, uint64_t size, CopyQueue* copy, ID3D12Device* device,
+	uint64_t* readyFenceValue) {
+	assert(USE_UPLOAD_HEAP_GEOMETRY || CopyBatchAvailable(copy));
+	const RCE::Upload::StaticBufferDevice staticDevice = MakeStaticBufferDevice(device, copy);
+	const RCE::Upload::BufferHeap heap = USE_UPLOAD_HEAP_GEOMETRY ? RCE::Upload::BufferHeap::Upload
+		: RCE::Upload::BufferHeap::Default;
+	ID3D12Resource* buffer = (ID3D12Resource*)RCE::Upload::CreateStaticBuffer(staticDevice, heap, data, size,
+		&copy->staging.ring, &copy->scheduler, readyFenceValue);
+	if (buffer == nullptr) {
+		std::cout << "Static buffer of " << size / 1024 << " KB does not fit UPLOAD_RING_SIZE, using the upload heap\n";
+		buffer = (ID3D12Resource*)RCE::Upload::CreateStaticBuffer(staticDevice, RCE::Upload::BufferHeap::Upload, data,
+			size, &copy->staging.ring, &copy->scheduler, readyFenceValue);
+	}
+	return buffer;
+}
 
-			float u = (float)(x) / vertsPerLoop;
+void CreateSphereLods(std::vector<RCE::Mesh::MeshData>* lods) {
+	auto generateStart = std::chrono::high_resolution_clock::now();
+	RCE::Mesh::GenerateLodChain(RCE::Mesh::Primitive::Sphere, SPHERE_MIN_SEGMENTS, SPHERE_MAX_SEGMENTS, lods);
+	auto generateEnd = std::chrono::high_resolution_clock::now();
 
-			SBL::Math::Vector3 position = SBL::Math::Vector3(xPos, yPos, zPos);
-			SBL::Math::Vector3 normal = SBL::Math::Normalized(position);
-			Vertex vert = { position, u, v, normal};
-			verts[y * (vertsPerLoop+1) + x] = vert;
+	size_t totalVerts = 0;
+	for (const RCE::Mesh::MeshData& lod : *lods) {
+		totalVerts += lod.vertices.size();
+	}
+	double generateMs = std::chrono::duration<double, std::milli>(generateEnd - generateStart).count();
+	std::cout << "Sphere LOD chain: " << lods->size() << " levels, " << totalVerts << " vertices in " << generateMs << " ms ("
+		<< (totalVerts > 0 ? generateMs / (totalVerts / 1e6) : 0.0) << " ms per million vertices, "
+		<< std::thread::hardware_concurrency() << " hardware threads)\n";
+
+	if (OPTIMIZE_VERTEX_CACHE) {
+		for (size_t level = 0; level < lods->size(); level++) {
+			RCE::Mesh::MeshData& lod = (*lods)[level];
+			int vertCount = (int)lod.vertices.size();
+			float acmrBefore = RCE::VertexCache::ComputeACMR(lod.indices.data(), lod.indices.size(), vertCount);
+
+			std::vector<int> optimizedIndices(lod.indices.size());
+			RCE::VertexCache::OptimizeVertexCache(lod.indices.data(), lod.indices.size(), vertCount, optimizedIndices.data());
+			lod.indices.swap(optimizedIndices);
+
+			float acmrAfter = RCE::VertexCache::ComputeACMR(lod.indices.data(), lod.indices.size(), vertCount);
+			std::cout << "Sphere LOD " << level << " ACMR (" << RCE::VertexCache::ACMR_CACHE_SIZE << " entry FIFO): "
+				<< acmrBefore << " -> " << acmrAfter << "\n";
 		}
 	}
+}
 
-	int index = 0;
-	for (int y = 0; y < loopsPerHeight; y++) {
-		for (int x = 0; x <= vertsPerLoop; x++) {
+// Builds the sphere in the layout it is uploaded and cached in
+void BuildSphereMesh(RCE::MeshCache::MeshArrays* out) {
+	std::vector<RCE::Mesh::MeshData> lods;
+	CreateSphereLods(&lods);
+
+	// Every level goes into one vertex and index buffer, draws pick one with baseVertex and startIndex. Indices stay local
+	// to their level.
+	std::vector<Vertex> verts;
+	std::vector<int> indices;
+	int largestLodVertCount = 0;
+	for (const RCE::Mesh::MeshData& lod : lods) {
+		RCE::MeshCache::LodEntry entry = { (int)verts.size(), (int)indices.size(), (int)lod.indices.size(), lod.geometricError,
+			(int)out->meshlets.size(), 0 };
+		if (USE_MESHLET_CULLING) {
+			RCE::Meshlet::MeshletData meshlets;
+			RCE::Meshlet::BuildMeshlets(lod.vertices.data(), (int)lod.vertices.size(), lod.indices.data(), lod.indices.size(),
+				&meshlets);
+			int meshletVertexBase = (int)out->meshletVertices.size();
+			for (RCE::Meshlet::Meshlet meshlet : meshlets.meshlets) {
+				meshlet.vertexOffset += meshletVertexBase;
+				out->meshlets.push_back(meshlet);
+			}
+			out->meshletBounds.insert(out->meshletBounds.end(), meshlets.bounds.begin(), meshlets.bounds.end());
+			out->meshletVertices.insert(out->meshletVertices.end(), meshlets.vertices.begin(), meshlets.vertices.end());
+			out->meshletTriangles.insert(out->meshletTriangles.end(), meshlets.triangles.begin(), meshlets.triangles.end());
+			entry.meshletCount = (int)meshlets.meshlets.size();
+		}
+		out->lods.push_back(entry);
 
-			/*
-			   TL   A
-				*---*
-				 \  | \
-                  \ |  \ 
-				    *---*
-					I    R
+		largestLodVertCount = std::max(largestLodVertCount, (int)lod.vertices.size());
+		verts.insert(verts.end(), lod.vertices.begin(), lod.vertices.end());
+		indices.insert(indices.end(), lod.indices.begin(), lod.indices.end());
+	}
 
-				I = index
-				R = right
-				TL = top left
-				A = across
-			*/
+	out->bounds.center = SBL::Math::Vector3(0, 0, 0);
+	out->bounds.radius = 0.0f;
+	for (const Vertex& vert : verts) {
+		out->bounds.radius = std::max(out->bounds.radius, SBL::Math::Length(vert.position));
+	}
 
-			int vertIndex = y * (vertsPerLoop+1) + x;
-			int vertAcross = vertIndex + (vertsPerLoop+1);
-			int vertTopLeft = vertIndex + (vertsPerLoop+1) - 1;
-			if (x == 0) {
-				vertTopLeft = vertIndex + (vertsPerLoop+1) * 2 - 1;
-			}
-			int vertRight = vertIndex + 1;
-			if (x == vertsPerLoop) {
-				vertRight = vertIndex - vertsPerLoop;
-			}
+	// Pick the vertex format uploaded to the GPU
+	if (USE_PACKED_VERTICES) {
+		out->vertexFormat = RCE::MeshCache::VERTEX_FORMAT_PACKED;
+		out->vertexStride = sizeof(PackedVertex);
+		out->vertices.resize(verts.size() * sizeof(PackedVertex));
 
-			indices[index++] = vertIndex;
-			indices[index++] = vertTopLeft;
-			indices[index++] = vertAcross;
+		auto encodeStart = std::chrono::high_resolution_clock::now();
+		RCE::VertexFormat::EncodeVertices(verts.data(), verts.size(), (PackedVertex*)out->vertices.data());
+		auto encodeEnd = std::chrono::high_resolution_clock::now();
 
-			indices[index++] = vertIndex;
-			indices[index++] = vertAcross;
-			indices[index++] = vertRight;
-		}
+		double encodeSeconds = std::chrono::duration<double>(encodeEnd - encodeStart).count();
+		std::cout << "Packed vertices: " << sizeof(PackedVertex) << " bytes per vertex (was " << sizeof(Vertex) << "), encoded "
+			<< verts.size() << " in " << encodeSeconds * 1000.0 << " ms ("
+			<< (encodeSeconds > 0.0 ? verts.size() / encodeSeconds / 1e6 : 0.0) << " Mverts/s)\n";
+	}
+	else {
+		out->vertexFormat = RCE::MeshCache::VERTEX_FORMAT_FULL;
+		out->vertexStride = sizeof(Vertex);
+		out->vertices.resize(verts.size() * sizeof(Vertex));
+		memcpy(out->vertices.data(), verts.data(), out->vertices.size());
 	}
 
-	out->verts = verts;
-	out->indices = indices;
-	out->indexCount = indexBufferSize;
-	out->vertCount = vertBufferSize;
+	// 16-bit indices whenever every vertex of a level can be addressed with them
+	if (RCE::VertexFormat::FitsSixteenBitIndices(largestLodVertCount)) {
+		out->indexStride = sizeof(uint16_t);
+		out->indices.resize(indices.size() * sizeof(uint16_t));
+		RCE::VertexFormat::PackIndices16(indices.data(), indices.size(), (uint16_t*)out->indices.data());
+	}
+	else {
+		out->indexStride = sizeof(int);
+		out->indices.resize(indices.size() * sizeof(int));
+		memcpy(out->indices.data(), indices.data(), out->indices.size());
+	}
+}
 
-	return 1;
+// Identifies the settings a cached sphere was built with
+uint64_t SphereSourceKey() {
+	int settings[] = { SPHERE_MIN_SEGMENTS, SPHERE_MAX_SEGMENTS, USE_PACKED_VERTICES, OPTIMIZE_VERTEX_CACHE, USE_MESHLET_CULLING,
+		RCE::Meshlet::MAX_VERTICES, RCE::Meshlet::MAX_TRIANGLES };
+	return RCE::File::Checksum64(settings, sizeof(settings));
 }
 
-HRESULT CompileShader(LPCWSTR filePath, LPCSTR entryFunction, LPCSTR profile, ID3DBlob** blob) {
+HRESULT CompileShader(LPCWSTR filePath, LPCSTR entryFunction, LPCSTR profile, ID3DBlob** blob, const D3D_SHADER_MACRO* defines = nullptr) {
 
 	// Shamelessly stolen from https://docs.microsoft.com/en-us/windows/win32/direct3d11/how-to--compile-a-shader
 
@@ -305,7 +829,7 @@ HRESULT CompileShader(LPCWSTR filePath, LPCSTR entryFunction, LPCSTR profile, ID
 
 	ID3DBlob* shaderBlob = nullptr;
 	ID3DBlob* errorBlob = nullptr;
-	HRESULT hr = D3DCompileFromFile(filePath, nullptr, D3D_COMPILE_STANDARD_FILE_INCLUDE, entryFunction, profile, shaderFlags, 0, &shaderBlob, &errorBlob);
+	HRESULT hr = D3DCompileFromFile(filePath, defines, D3D_COMPILE_STANDARD_FILE_INCLUDE, entryFunction, profile, shaderFlags, 0, &shaderBlob, &errorBlob);
 
 	if (FAILED(hr))
 	{
@@ -359,7 +883,46 @@ LRESULT win32mainwindowcallback(HWND window, unsigned int message, WPARAM wParam
 }
 
 int main(int argc, char* argv[]) {
-	
+
+	// -cook rebuilds every texture cache and exits without opening a window. -frames N sets the frames in flight,
+	// -measure-overlap measures the OVERLAP_FRAMES_IN_FLIGHT counts and exits. Both also turn on ReportStats.
+	int framesInFlight = DEFAULT_FRAMES_IN_FLIGHT;
+	bool measureOverlap = false;
+	for (int i = 1; i < argc; i++) {
+		if (strcmp(argv[i], "-cook") == 0) {
+			bool cooked = true;
+			for (const TextureSource& source : TEXTURES) {
+				RCE::File::MappedFile cacheFile;
+				RCE::TextureCache::TextureArrays arrays;
+				RCE::TextureCache::TextureView texture;
+				cooked = LoadCookedTexture(source, true, 0, &cacheFile, &arrays, &texture, std::cout) && cooked;
+				RCE::File::CloseMappedFile(&cacheFile);
+			}
+			return cooked ? 0 : 1;
+		}
+		else if (strcmp(argv[i], "-frames") == 0 && i + 1 < argc) {
+			framesInFlight = std::min(std::max(atoi(argv[++i]), 1), MAX_FRAMES_IN_FLIGHT);
+			ReportStats = true;
+		}
+		else if (strcmp(argv[i], "-measure-overlap") == 0) {
+			measureOverlap = true;
+			ReportStats = true;
+		}
+	}
+
+	// Per-frame resources are made for every count the measurement goes through
+	int frameSlotCount = framesInFlight;
+	int overlapStep = 0;
+	if (measureOverlap) {
+		framesInFlight = OVERLAP_FRAMES_IN_FLIGHT[0];
+		frameSlotCount = *std::max_element(std::begin(OVERLAP_FRAMES_IN_FLIGHT), std::end(OVERLAP_FRAMES_IN_FLIGHT));
+	}
+
+	// Texture decoding and cooking runs on the job pool while the window, device and pipeline are set up
+	auto textureLoadStart = std::chrono::high_resolution_clock::now();
+	RCE::Jobs::JobPool texturePool;
+	std::vector<TextureLoad> textureLoads;
+	StartTextureLoads(&texturePool, &textureLoads);
 
 	HINSTANCE instance = GetModuleHandle(nullptr);
 	
@@ -434,6 +997,7 @@ int main(int argc, char* argv[]) {
 		swapChainDesc.BufferCount = BACKBUFFER_COUNT;
 		swapChainDesc.BufferUsage = DXGI_USAGE_RENDER_TARGET_OUTPUT;
 		swapChainDesc.SwapEffect = DXGI_SWAP_EFFECT_FLIP_DISCARD;
+		swapChainDesc.Flags = DXGI_SWAP_CHAIN_FLAG_FRAME_LATENCY_WAITABLE_OBJECT;
 
 		UINT createFactoryFlags = 0;
 #if defined(_DEBUG)
@@ -454,6 +1018,18 @@ int main(int argc, char* argv[]) {
 		assert(SUCCEEDED(hr));
 	}
 
+	// Signalled whenever the swap chain can queue another frame without going over framesInFlight, the render loop
+	// waits on it instead of finding out inside Present
+	IDXGISwapChain3* swapChain3;
+	HANDLE frameLatencyWaitable;
+	{
+		hr = swapChain->QueryInterface(IID_PPV_ARGS(&swapChain3));
+		assert(SUCCEEDED(hr));
+		hr = swapChain3->SetMaximumFrameLatency(framesInFlight);
+		assert(SUCCEEDED(hr));
+		frameLatencyWaitable = swapChain3->GetFrameLatencyWaitableObject();
+	}
+
 	// Types of descriptors: 
 	// Render target view (RTV), 
 	// Depth Stencil view (DSV), 
@@ -487,9 +1063,9 @@ int main(int argc, char* argv[]) {
 		}
 	}
 	
-	ID3D12CommandAllocator* commandAllocator[BACKBUFFER_COUNT];
+	std::vector<ID3D12CommandAllocator*> commandAllocator(frameSlotCount);
 	{
-		for (int i = 0; i < BACKBUFFER_COUNT; i++) {
+		for (int i = 0; i < frameSlotCount; i++) {
 			hr = device->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_DIRECT, IID_PPV_ARGS(&commandAllocator[i]));
 			assert(SUCCEEDED(hr));
 		}
@@ -507,89 +1083,83 @@ int main(int argc, char* argv[]) {
 		assert(SUCCEEDED(hr));
 	}
 
-	D3D12_HEAP_PROPERTIES defaultHeap = {};
-	defaultHeap.Type = D3D12_HEAP_TYPE_DEFAULT;
+	CopyQueue copyQueue;
+	CreateCopyQueue(device, &copyQueue);
+	// Copy fence value at which the geometry and every texture are in place
+	uint64_t assetsFenceValue = 0;
 
-	D3D12_HEAP_PROPERTIES uploadHeap = {};
-	uploadHeap.Type = D3D12_HEAP_TYPE_UPLOAD;
+	// The sphere is mapped from the mesh cache when it was built with the current settings, otherwise it is built and
+	// cached for the next launch. sphereFile stays mapped for as long as sphereMesh is used.
+	RCE::File::MappedFile sphereFile;
+	RCE::MeshCache::MeshArrays sphereArrays;
+	RCE::MeshCache::MeshView sphereMesh;
+	{
+		auto loadStart = std::chrono::high_resolution_clock::now();
+		RCE::MeshCache::LoadResult loadResult = RCE::MeshCache::LoadResult::Invalid;
+		bool cacheFound = RCE::File::OpenMappedFile(SPHERE_CACHE_PATH, &sphereFile);
+		if (cacheFound) {
+			loadResult = RCE::MeshCache::LoadMeshCache(sphereFile, SphereSourceKey(), &sphereMesh);
+		}
+		auto loadEnd = std::chrono::high_resolution_clock::now();
 
-	SphereDefinition sphere;
-	hr = CreateSphereMesh(40, 40, &sphere);
-	assert(SUCCEEDED(hr));
+		if (loadResult == RCE::MeshCache::LoadResult::Ok) {
+			std::cout << "Sphere mesh: mapped " << sphereFile.size << " bytes from " << SPHERE_CACHE_PATH << " in "
+				<< std::chrono::duration<double, std::milli>(loadEnd - loadStart).count() << " ms\n";
+		}
+		else {
+			if (cacheFound) {
+				std::cout << "Sphere mesh: ignoring " << SPHERE_CACHE_PATH << " (" << RCE::MeshCache::LoadResultName(loadResult) << ")\n";
+			}
+			RCE::File::CloseMappedFile(&sphereFile);
+
+			BuildSphereMesh(&sphereArrays);
+			sphereMesh = RCE::MeshCache::ViewOf(sphereArrays);
+			auto buildEnd = std::chrono::high_resolution_clock::now();
+			std::cout << "Sphere mesh: built in " << std::chrono::duration<double, std::milli>(buildEnd - loadEnd).count() << " ms\n";
+
+			if (!RCE::MeshCache::WriteMeshCache(SPHERE_CACHE_PATH, sphereMesh, SphereSourceKey())) {
+				std::cout << "Sphere mesh: could not write " << SPHERE_CACHE_PATH << "\n";
+			}
+		}
+	}
+	assert(sphereMesh.vertexFormat == (USE_PACKED_VERTICES ? RCE::MeshCache::VERTEX_FORMAT_PACKED : RCE::MeshCache::VERTEX_FORMAT_FULL));
+
+	std::vector<float> sphereLodErrors;
+	for (size_t level = 0; level < sphereMesh.lodCount; level++) {
+		sphereLodErrors.push_back(sphereMesh.lods[level].geometricError);
+	}
+
+	// Staged straight from the mapped file or the built arrays
+	const void* vertData = sphereMesh.vertices;
+	int vertStride = sphereMesh.vertexStride;
 
 	D3D12_VERTEX_BUFFER_VIEW vbView = {};
 	{
-		int vertSize = sizeof(Vertex) * sphere.vertCount;
-
-		D3D12_RESOURCE_DESC vertexUploadBuffDesc = {};
-		vertexUploadBuffDesc.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
-		vertexUploadBuffDesc.Alignment = D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT;
-		vertexUploadBuffDesc.Width = vertSize;
-		vertexUploadBuffDesc.Height = 1;
-		vertexUploadBuffDesc.DepthOrArraySize = 1;
-		vertexUploadBuffDesc.MipLevels = 1;
-		vertexUploadBuffDesc.Format = DXGI_FORMAT_UNKNOWN;
-		vertexUploadBuffDesc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
-		vertexUploadBuffDesc.SampleDesc = multiSampleDesc;
-
-		ID3D12Resource* vertexUploadBuff;
-		hr = device->CreateCommittedResource(
-			&uploadHeap,
-			D3D12_HEAP_FLAG_NONE,
-			&vertexUploadBuffDesc,
-			D3D12_RESOURCE_STATE_GENERIC_READ,
-			nullptr,
-			IID_PPV_ARGS(&vertexUploadBuff));
-		assert(SUCCEEDED(hr));
-
-		void* gpuData;
-		D3D12_RANGE range = {};
-		vertexUploadBuff->Map(0, &range, &gpuData);
-		memcpy(gpuData, sphere.verts, vertSize);
-		vertexUploadBuff->Unmap(0, nullptr);
+		int vertSize = vertStride * (int)sphereMesh.vertexCount;
+		ID3D12Resource* vertexBuffer = CreateStaticBuffer(vertData, vertSize, &copyQueue, device, &assetsFenceValue);
 
-		vbView.BufferLocation = vertexUploadBuff->GetGPUVirtualAddress();
+		vbView.BufferLocation = vertexBuffer->GetGPUVirtualAddress();
 		vbView.SizeInBytes = vertSize;
-		vbView.StrideInBytes = sizeof(Vertex);
+		vbView.StrideInBytes = vertStride;
 	}
 
+	const void* idxData = sphereMesh.indices;
+	int idxStride = sphereMesh.indexStride;
+	DXGI_FORMAT idxFormat = idxStride == sizeof(uint16_t) ? DXGI_FORMAT_R16_UINT : DXGI_FORMAT_R32_UINT;
+
 	D3D12_INDEX_BUFFER_VIEW ibView = {};
 	{
-		int idxSize = sizeof(int) * sphere.indexCount;
-
-		D3D12_RESOURCE_DESC indexUploadBuffDesc = {};
-		indexUploadBuffDesc.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
-		indexUploadBuffDesc.Alignment = D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT;
-		indexUploadBuffDesc.Width = idxSize;
-		indexUploadBuffDesc.Height = 1;
-		indexUploadBuffDesc.DepthOrArraySize = 1;
-		indexUploadBuffDesc.MipLevels = 1;
-		indexUploadBuffDesc.Format = DXGI_FORMAT_UNKNOWN;
-		indexUploadBuffDesc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
-		indexUploadBuffDesc.SampleDesc = multiSampleDesc;
-
-		ID3D12Resource* indexUploadBuff;
-		hr = device->CreateCommittedResource(
-			&uploadHeap,
-			D3D12_HEAP_FLAG_NONE,
-			&indexUploadBuffDesc,
-			D3D12_RESOURCE_STATE_GENERIC_READ,
-			nullptr,
-			IID_PPV_ARGS(&indexUploadBuff));
-		assert(SUCCEEDED(hr));
+		int idxSize = idxStride * (int)sphereMesh.indexCount;
+		ID3D12Resource* indexBuffer = CreateStaticBuffer(idxData, idxSize, &copyQueue, device, &assetsFenceValue);
 
-		void* gpuData;
-		D3D12_RANGE range = {};
-		//
-		// No CPU reads will be done from the resource.
-		//
-		indexUploadBuff->Map(0, &range, &gpuData);
-		memcpy(gpuData, sphere.indices, idxSize);
-		indexUploadBuff->Unmap(0, nullptr);
-
-		ibView.BufferLocation = indexUploadBuff->GetGPUVirtualAddress();
+		ibView.BufferLocation = indexBuffer->GetGPUVirtualAddress();
 		ibView.SizeInBytes = idxSize;
-		ibView.Format = DXGI_FORMAT_R32_UINT;
+		ibView.Format = idxFormat;
+	}
+
+	// The geometry goes out on its own, the textures follow in the render loop as their loads finish
+	if (RCE::Upload::ShouldSubmit(&copyQueue.scheduler, true)) {
+		SubmitCopyBatch(&copyQueue);
 	}
 
 	ID3D12RootSignature* rootSignature;
@@ -618,7 +1188,7 @@ int main(int argc, char* argv[]) {
 		rootParams[2].ShaderVisibility = D3D12_SHADER_VISIBILITY_ALL;
 
 		D3D12_STATIC_SAMPLER_DESC staticSamplers[1] = {};
-		staticSamplers[0].Filter = D3D12_FILTER_MIN_MAG_MIP_POINT;
+		staticSamplers[0].Filter = D3D12_FILTER_MIN_MAG_MIP_LINEAR;
 		staticSamplers[0].AddressU = D3D12_TEXTURE_ADDRESS_MODE_WRAP;
 		staticSamplers[0].AddressV = D3D12_TEXTURE_ADDRESS_MODE_WRAP;
 		staticSamplers[0].AddressW = D3D12_TEXTURE_ADDRESS_MODE_WRAP;
@@ -659,7 +1229,8 @@ int main(int argc, char* argv[]) {
 		D3D12_SHADER_BYTECODE vertexShaderByteCode = {};
 		{
 			ID3DBlob* vertexShader; // TODO: Free this
-			hr = CompileShader(L"SimpleShader.vs", "main", "vs_5_0", &vertexShader);
+			D3D_SHADER_MACRO packedDefines[] = { { "PACKED_VERTEX", "1" }, { nullptr, nullptr } };
+			hr = CompileShader(L"SimpleShader.vs", "main", "vs_5_0", &vertexShader, USE_PACKED_VERTICES ? packedDefines : nullptr);
 			assert(SUCCEEDED(hr));
 			vertexShaderByteCode.pShaderBytecode = vertexShader->GetBufferPointer();
 			vertexShaderByteCode.BytecodeLength = vertexShader->GetBufferSize();
@@ -679,19 +1250,19 @@ int main(int argc, char* argv[]) {
 			D3D12_INPUT_ELEMENT_DESC shaderInputs[3] = {};
 			shaderInputs[0] = {};
 			shaderInputs[0].SemanticName = "Position";
-			shaderInputs[0].Format = DXGI_FORMAT_R32G32B32_FLOAT;
+			shaderInputs[0].Format = USE_PACKED_VERTICES ? DXGI_FORMAT_R16G16B16A16_FLOAT : DXGI_FORMAT_R32G32B32_FLOAT;
 			shaderInputs[0].InputSlotClass = D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA;
 
 			shaderInputs[1] = {};
 			shaderInputs[1].SemanticName = "TEXCOORD";
 			shaderInputs[1].AlignedByteOffset = D3D12_APPEND_ALIGNED_ELEMENT;
-			shaderInputs[1].Format = DXGI_FORMAT_R32G32_FLOAT;
+			shaderInputs[1].Format = USE_PACKED_VERTICES ? DXGI_FORMAT_R16G16_UNORM : DXGI_FORMAT_R32G32_FLOAT;
 			shaderInputs[1].InputSlotClass = D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA;
 
 			shaderInputs[2] = {};
 			shaderInputs[2].SemanticName = "Normal";
 			shaderInputs[2].AlignedByteOffset = D3D12_APPEND_ALIGNED_ELEMENT;
-			shaderInputs[2].Format = DXGI_FORMAT_R32G32B32_FLOAT;
+			shaderInputs[2].Format = USE_PACKED_VERTICES ? DXGI_FORMAT_R16G16_SNORM : DXGI_FORMAT_R32G32B32_FLOAT;
 			shaderInputs[2].InputSlotClass = D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA;
 
 			inputLayout.NumElements = 3;
@@ -755,79 +1326,67 @@ int main(int argc, char* argv[]) {
 		assert(SUCCEEDED(hr));
 	}
 
-	ID3D12Resource* cbObjectUploadHeap[BACKBUFFER_COUNT];
+	// Root constant buffer views point into this, the descriptor heap only holds the textures
+	FrameConstants frameConstants;
+	CreateFrameConstants(device, frameSlotCount, &frameConstants);
+
+	// Textures are uploaded in the render loop, each into its own descriptor, in the order their loads finish
+	const D3D12_CPU_DESCRIPTOR_HANDLE textureDescriptorStart = cbvSrvUavHeap->GetCPUDescriptorHandleForHeapStart();
+	const UINT textureDescriptorSize = device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+	bool texturesQueued = false;
+	// A finished load that did not fit the staging ring, uploaded before any other once earlier copies have retired
+	int deferredTexture = -1;
+	bool assetsResident = false;
+	double textureRecordMs = 0.0;
+	int framesWithoutAssets = 0;
+
+	// Every frame signals the next fence value and records into slot fenceValue % framesInFlight. frameFenceValue holds
+	// the value signalled by the last frame recorded into each slot's allocator and constant buffers.
+	uint64_t lastExecutedFenceValue = 0;
+	std::vector<uint64_t> frameFenceValue(frameSlotCount, 0);
+	ID3D12Fence* fence;
+	HANDLE fenceEvent;
 	{
-		for (int i = 0; i < BACKBUFFER_COUNT; i++) {
-			D3D12_RESOURCE_DESC buffer = CD3DX12_RESOURCE_DESC::Buffer(1024 * 64);
-			hr = device->CreateCommittedResource(
-				&uploadHeap,
-				D3D12_HEAP_FLAG_NONE,
-				&buffer,
-				D3D12_RESOURCE_STATE_GENERIC_READ,
-				nullptr,
-				IID_PPV_ARGS(&cbObjectUploadHeap[i]));
-			assert(SUCCEEDED(hr));
-
-			int size = sizeof(CBObject);
-
-			D3D12_CONSTANT_BUFFER_VIEW_DESC cbvDesc = {};
-			cbvDesc.BufferLocation = cbObjectUploadHeap[i]->GetGPUVirtualAddress();
-			cbvDesc.SizeInBytes = (size + 255) & ~255;    // CB size is required to be 256-byte aligned.
-			device->CreateConstantBufferView(&cbvDesc, cbvSrvUavHeap->GetCPUDescriptorHandleForHeapStart());
-		}
+		hr = device->CreateFence(0, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&fence));
+		assert(SUCCEEDED(hr));
+		fenceEvent = CreateEventW(nullptr, FALSE, FALSE, nullptr);
+		assert(fenceEvent != nullptr);
 	}
 
-	ID3D12Resource* cbViewUploadHeap[BACKBUFFER_COUNT];
+	// Two timestamps per slot, at the start and the end of its command list. They are resolved into the readback buffer
+	// and read when the slot comes around again, after its fence has passed.
+	ID3D12QueryHeap* timestampHeap;
+	const uint64_t* timestamps;
+	ID3D12Resource* timestampReadback;
+	double timestampTicksPerMs;
+	std::vector<bool> slotTimed(frameSlotCount, false);
 	{
-		for (int i = 0; i < BACKBUFFER_COUNT; i++) {
-			D3D12_RESOURCE_DESC buffer = CD3DX12_RESOURCE_DESC::Buffer(1024 * 64);
-			hr = device->CreateCommittedResource(
-				&uploadHeap,
-				D3D12_HEAP_FLAG_NONE,
-				&buffer,
-				D3D12_RESOURCE_STATE_GENERIC_READ,
-				nullptr,
-				IID_PPV_ARGS(&cbViewUploadHeap[i]));
-			assert(SUCCEEDED(hr));
-
-			int size = sizeof(CBView);
+		D3D12_QUERY_HEAP_DESC queryHeapDesc = {};
+		queryHeapDesc.Type = D3D12_QUERY_HEAP_TYPE_TIMESTAMP;
+		queryHeapDesc.Count = 2 * frameSlotCount;
+		hr = device->CreateQueryHeap(&queryHeapDesc, IID_PPV_ARGS(&timestampHeap));
+		assert(SUCCEEDED(hr));
 
-			D3D12_CONSTANT_BUFFER_VIEW_DESC cbvDesc = {};
-			cbvDesc.BufferLocation = cbViewUploadHeap[i]->GetGPUVirtualAddress();
-			cbvDesc.SizeInBytes = (size + 255) & ~255;    // CB size is required to be 256-byte aligned.
-			device->CreateConstantBufferView(&cbvDesc, cbvSrvUavHeap->GetCPUDescriptorHandleForHeapStart());
-		}
-	}
+		D3D12_HEAP_PROPERTIES readbackHeap = {};
+		readbackHeap.Type = D3D12_HEAP_TYPE_READBACK;
+		D3D12_RESOURCE_DESC bufferDesc = CD3DX12_RESOURCE_DESC::Buffer(queryHeapDesc.Count * sizeof(uint64_t));
+		hr = device->CreateCommittedResource(
+			&readbackHeap,
+			D3D12_HEAP_FLAG_NONE,
+			&bufferDesc,
+			D3D12_RESOURCE_STATE_COPY_DEST,
+			nullptr,
+			IID_PPV_ARGS(&timestampReadback));
+		assert(SUCCEEDED(hr));
 
-	// Load textures
-	MyBitmap image = MyLoadImage("Assets/earthmap1k.jpg"); // TODO: Free
-	MyBitmap cloudTrans = MyLoadImage("Assets/earthcloudmaptrans.jpg"); // TODO: Free
-	MyBitmap lights = MyLoadImage("Assets/earthlights1k.jpg"); // TODO: Free
-	MyBitmap bump = MyLoadImage("Assets/earthbump1k.jpg"); // TODO: Free
-	MyBitmap clouds = MyLoadImage("Assets/earthcloudmap.jpg"); // TODO: Free
-	MyBitmap spec = MyLoadImage("Assets/earthspec1k.jpg"); // TODO: Free
-	{
-		auto descriptor = cbvSrvUavHeap->GetCPUDescriptorHandleForHeapStart();
-		auto incSize = device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
-
-		LoadImageIntoGPU(image, device, commandList, descriptor);
-		descriptor.ptr += incSize;
-		LoadImageIntoGPU(bump, device, commandList, descriptor);
-		descriptor.ptr += incSize;
-		LoadImageIntoGPU(clouds, device, commandList, descriptor);
-		descriptor.ptr += incSize;
-		LoadImageIntoGPU(cloudTrans, device, commandList, descriptor);
-		descriptor.ptr += incSize;
-		LoadImageIntoGPU(lights, device, commandList, descriptor);
-		descriptor.ptr += incSize;
-		LoadImageIntoGPU(spec, device, commandList, descriptor);
-	}
+		// Stays mapped, the CPU only reads slots whose resolve has completed
+		hr = timestampReadback->Map(0, nullptr, (void**)&timestamps);
+		assert(SUCCEEDED(hr));
 
-	uint64_t lastExecutedFenceValue = 0;
-	ID3D12Fence* fence;
-	{
-		hr = device->CreateFence(0, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&fence));
+		UINT64 frequency;
+		hr = commandQueue->GetTimestampFrequency(&frequency);
 		assert(SUCCEEDED(hr));
+		timestampTicksPerMs = frequency / 1000.0;
 	}
 
 	D3D12_RESOURCE_BARRIER transitionToWriteBarrier[BACKBUFFER_COUNT] = {};
@@ -862,14 +1421,20 @@ int main(int argc, char* argv[]) {
 	}
 
 
+	// Nothing goes on the direct queue before the first frame, the uploads are on the copy queue
 	hr = commandList->Close();
 	assert(SUCCEEDED(hr));
 
-	commandQueue->ExecuteCommandLists(1, (ID3D12CommandList**)&commandList);
-	lastExecutedFenceValue++;
-	hr = commandQueue->Signal(fence, lastExecutedFenceValue);
-	assert(SUCCEEDED(hr));
 
+	int sphereLodLevel = -1;
+	int drawnSphereLodLevel = -1;
+	std::vector<int> visibleMeshlets;
+
+	RCE::Pacing::WaitStats waitStats = {};
+	RCE::Pacing::OverlapStats overlapStats = {};
+	RCE::Pacing::OverlapStats measuredOverlap = {};
+	int measuredFrames = 0;
+	auto lastFrameStart = std::chrono::high_resolution_clock::now();
 
 	MSG message;
 	Running = true;
@@ -879,77 +1444,225 @@ int main(int argc, char* argv[]) {
 			DispatchMessageW(&message);
 		}
 
-		uint64_t lastCompletedFenceValue = fence->GetCompletedValue();
-		if (lastExecutedFenceValue - lastCompletedFenceValue > BACKBUFFER_COUNT-1) {
-			Sleep(1);
-			continue;
+		// Record the textures whose loads finished since the last frame. Whatever was recorded is submitted before the
+		// frame, so a texture never waits for the next one to finish loading.
+		if (!texturesQueued) {
+			auto recordStart = std::chrono::high_resolution_clock::now();
+			// While every copy allocator is still in use by the GPU, or the staging ring is full, the finished loads wait
+			// and are picked up in a later frame, the render thread does not wait for the copy queue
+			while (CopyBatchAvailable(&copyQueue)) {
+				int i = deferredTexture;
+				if (i < 0) {
+					i = RCE::Jobs::TryNextJob(&texturePool);
+					if (i < 0) {
+						break;
+					}
+					std::cout << textureLoads[i].log.str();
+					// A missing or corrupt texture leaves texture unset. The placeholder keeps the descriptor valid, the
+					// sphere still draws with the other textures.
+					if (!textureLoads[i].loaded) {
+						std::cout << "Texture " << TEXTURES[i].path << ": not loaded, using a placeholder\n";
+						MakePlaceholderTexture(TEXTURES[i], &textureLoads[i].cooked);
+						textureLoads[i].texture = RCE::TextureCache::ViewOf(textureLoads[i].cooked);
+					}
+				}
+				TextureLoad& load = textureLoads[i];
+
+				D3D12_CPU_DESCRIPTOR_HANDLE slot = textureDescriptorStart;
+				slot.ptr += i * textureDescriptorSize;
+				bool uploaded = UploadTexture(load.texture, &copyQueue, device, slot, &assetsFenceValue);
+				if (!uploaded && RCE::Upload::BytesInUse(&copyQueue.staging.ring) == 0) {
+					// Nothing left to retire, the texture is larger than the whole ring and would never fit
+					std::cout << "Texture " << TEXTURES[i].path << ": larger than UPLOAD_RING_SIZE, using a placeholder\n";
+					MakePlaceholderTexture(TEXTURES[i], &load.cooked);
+					load.texture = RCE::TextureCache::ViewOf(load.cooked);
+					uploaded = UploadTexture(load.texture, &copyQueue, device, slot, &assetsFenceValue);
+				}
+				if (!uploaded) {
+					deferredTexture = i;
+					break;
+				}
+				deferredTexture = -1;
+				RCE::File::CloseMappedFile(&load.cacheFile);
+				load.cooked = RCE::TextureCache::TextureArrays();
+				if (RCE::Upload::ShouldSubmit(&copyQueue.scheduler, false)) {
+					SubmitCopyBatch(&copyQueue);
+				}
+			}
+			if (RCE::Upload::ShouldSubmit(&copyQueue.scheduler, true)) {
+				SubmitCopyBatch(&copyQueue);
+			}
+			auto recordEnd = std::chrono::high_resolution_clock::now();
+			textureRecordMs += std::chrono::duration<double, std::milli>(recordEnd - recordStart).count();
+
+			if (deferredTexture < 0 && RCE::Jobs::AllJobsTaken(&texturePool)) {
+				const size_t workerCount = texturePool.workers.size();
+				RCE::Jobs::JoinJobs(&texturePool);
+				texturesQueued = true;
+
+				// Load time is summed over the workers, wall time runs from the start of the loads until the last one
+				// was recorded
+				double loadMs = 0.0;
+				for (const TextureLoad& load : textureLoads) {
+					loadMs += load.milliseconds;
+				}
+				std::cout << "Textures: " << textureLoads.size() << " loaded on " << workerCount << " workers in "
+					<< loadMs << " ms of work, " << std::chrono::duration<double, std::milli>(recordEnd - textureLoadStart).count()
+					<< " ms wall; recording the copies took " << textureRecordMs << " ms\n";
+			}
+		}
+
+		const uint64_t completedCopyFenceValue = copyQueue.fence->GetCompletedValue();
+		RCE::Upload::Retire(&copyQueue.staging.ring, completedCopyFenceValue);
+		if (texturesQueued && !assetsResident && completedCopyFenceValue >= assetsFenceValue) {
+			assetsResident = true;
+			std::cout << "Assets resident " << std::chrono::duration<double, std::milli>(
+				std::chrono::high_resolution_clock::now() - textureLoadStart).count() << " ms after the loads started, "
+				<< copyQueue.scheduler.lastSubmitted << " copy batches with " << copyQueue.scheduler.totalBytes / 1024
+				<< " KB; " << framesWithoutAssets << " frames were presented without them\n";
 		}
 
-		int frame = ((IDXGISwapChain3*)swapChain)->GetCurrentBackBufferIndex();
+		// -measure-overlap: once a frames-in-flight count has been measured, report it, let the GPU drain and go on
+		// with the next one
+		if (measureOverlap && assetsResident) {
+			measuredFrames++;
+			if (measuredFrames == OVERLAP_WARMUP_FRAMES) {
+				measuredOverlap = {};
+			}
+			else if (measuredFrames == OVERLAP_WARMUP_FRAMES + OVERLAP_MEASURE_FRAMES) {
+				std::cout << "Overlap with " << framesInFlight << " frames in flight: "
+					<< measuredOverlap.wallMs / measuredOverlap.frames << " ms per frame, CPU busy "
+					<< measuredOverlap.cpuMs / measuredOverlap.frames << " ms, GPU busy "
+					<< (measuredOverlap.gpuFrames > 0 ? measuredOverlap.gpuMs / measuredOverlap.gpuFrames : 0.0) << " ms, "
+					<< RCE::Pacing::OverlapFraction(measuredOverlap) * 100.0 << "% of the frame both busy\n";
+
+				overlapStep++;
+				if (overlapStep == (int)_countof(OVERLAP_FRAMES_IN_FLIGHT)) {
+					break;
+				}
+				WaitForFence(fence, lastExecutedFenceValue, fenceEvent);
+				framesInFlight = OVERLAP_FRAMES_IN_FLIGHT[overlapStep];
+				hr = swapChain3->SetMaximumFrameLatency(framesInFlight);
+				assert(SUCCEEDED(hr));
+				slotTimed.assign(frameSlotCount, false);
+				measuredFrames = 0;
+				lastFrameStart = std::chrono::high_resolution_clock::now();
+			}
+		}
 
-		hr = commandAllocator[frame]->Reset();
+		// Sleep until the swap chain takes another frame, then until the GPU is done with the last frame that used this
+		// slot's resources. Both are usually signalled already when the GPU keeps up.
+		auto waitStart = std::chrono::high_resolution_clock::now();
+		// Times out instead of hanging when presentation stalls. Without the swap chain's go-ahead the frame is paced by
+		// the fence instead, waiting until the GPU has finished everything submitted so far. A handle that cannot be
+		// waited on is dropped and every later frame is paced that way.
+		if (frameLatencyWaitable != nullptr) {
+			DWORD waitResult = WaitForSingleObject(frameLatencyWaitable, 1000);
+			if (waitResult != WAIT_OBJECT_0) {
+				if (waitResult == WAIT_TIMEOUT) {
+					std::cout << "Swap chain wait timed out after 1000 ms, waiting on the fence\n";
+				}
+				else {
+					std::cout << "Swap chain wait failed (" << waitResult << ", error " << GetLastError()
+						<< "), pacing on the fence from now on\n";
+					frameLatencyWaitable = nullptr;
+				}
+				WaitForFence(fence, lastExecutedFenceValue, fenceEvent);
+			}
+		}
+		else {
+			WaitForFence(fence, lastExecutedFenceValue, fenceEvent);
+		}
+		auto swapChainWaitEnd = std::chrono::high_resolution_clock::now();
+
+		int backBuffer = swapChain3->GetCurrentBackBufferIndex();
+		int slot = (int)((lastExecutedFenceValue + 1) % framesInFlight);
+		WaitForFence(fence, RCE::Pacing::FrameWaitValue(lastExecutedFenceValue, frameFenceValue[slot], framesInFlight),
+			fenceEvent);
+		auto frameStart = std::chrono::high_resolution_clock::now();
+
+		const double swapChainWaitMs = std::chrono::duration<double, std::milli>(swapChainWaitEnd - waitStart).count();
+		const double fenceWaitMs = std::chrono::duration<double, std::milli>(frameStart - swapChainWaitEnd).count();
+		const double frameMs = std::chrono::duration<double, std::milli>(frameStart - lastFrameStart).count();
+		lastFrameStart = frameStart;
+		RCE::Pacing::RecordFrame(&waitStats, swapChainWaitMs, fenceWaitMs, frameMs);
+		RCE::Pacing::RecordCpuFrame(&overlapStats, frameMs, swapChainWaitMs + fenceWaitMs);
+		RCE::Pacing::RecordCpuFrame(&measuredOverlap, frameMs, swapChainWaitMs + fenceWaitMs);
+		if (slotTimed[slot]) {
+			double gpuMs = (timestamps[2 * slot + 1] - timestamps[2 * slot]) / timestampTicksPerMs;
+			RCE::Pacing::RecordGpuFrame(&overlapStats, gpuMs);
+			RCE::Pacing::RecordGpuFrame(&measuredOverlap, gpuMs);
+		}
+
+		if (waitStats.frames == PACING_REPORT_FRAMES) {
+			if (ReportStats) {
+				std::cout << "Frames: " << waitStats.frameMs / waitStats.frames << " ms average, " << waitStats.maxFrameMs
+					<< " ms longest; CPU waited " << waitStats.swapChainMs / waitStats.frames << " ms on the swap chain and "
+					<< waitStats.fenceMs / waitStats.frames << " ms on the fence per frame, " << waitStats.maxWaitMs
+					<< " ms longest; CPU busy " << overlapStats.cpuMs / overlapStats.frames << " ms, GPU busy "
+					<< (overlapStats.gpuFrames > 0 ? overlapStats.gpuMs / overlapStats.gpuFrames : 0.0) << " ms ("
+					<< framesInFlight << " frames in flight)\n";
+			}
+			waitStats = {};
+			overlapStats = {};
+		}
+
+		hr = commandAllocator[slot]->Reset();
 		assert(SUCCEEDED(hr));
 
-		hr = commandList->Reset(commandAllocator[frame], pipelineStateObject);
+		hr = commandList->Reset(commandAllocator[slot], pipelineStateObject);
 		assert(SUCCEEDED(hr));
+		commandList->EndQuery(timestampHeap, D3D12_QUERY_TYPE_TIMESTAMP, 2 * slot);
 
-		commandList->ResourceBarrier(1, &transitionToWriteBarrier[frame]);
+		commandList->ResourceBarrier(1, &transitionToWriteBarrier[backBuffer]);
 
 		auto cameraTransform = RCE::Camera::MakeCameraTransform(RCE::Camera::camPosition, RCE::Camera::camForward, RCE::Camera::camUp);
-		auto projectionTransform = RCE::Camera::MakeCameraCanonicalView(RCE::Camera::fov, ((float)width) / height, 0.1, 10);
+		const float nearPlane = 0.1f;
+		const float farPlane = 10.0f;
+		auto projectionTransform = RCE::Camera::MakeCameraCanonicalView(RCE::Camera::fov, ((float)width) / height, nearPlane, farPlane);
 		auto worldToView = projectionTransform * cameraTransform;
 
-		SBL::Math::Vector3 earthPosition = SBL::Math::Vector3(0, 0, 0);
-		SBL::Math::Vector3 earthScale = SBL::Math::Vector3(1, 1, 1);
-		//SBL::Math::Matrix44 earthRotation = SBL::Math::Matrix44::RotationZ(cbView.frameNum / 300.0);
-		SBL::Math::Matrix44 earthRotation = SBL::Math::Matrix44::Identity;
-		SBL::Math::Matrix44 earthObjTransform = SBL::Math::Matrix44::Translation(earthPosition) * earthRotation * SBL::Math::Matrix44::Scale(earthScale);
+		SBL::Math::UniformTransform earthTransform = {};
+		earthTransform.m_translation = SBL::Math::Vector3(0, 0, 0);
+		//earthTransform.m_rotation = SBL::Math::Quaternion::AxisAngle(SBL::Math::Vector3::Out, cbView.frameNum / 300.0f);
+		earthTransform.m_rotation = SBL::Math::Quaternion::Identity;
+		earthTransform.m_uniformScale = 1;
+		SBL::Math::Vector3 earthScale = SBL::Math::Vector3(earthTransform.m_uniformScale, earthTransform.m_uniformScale, earthTransform.m_uniformScale);
+		SBL::Math::Matrix44 earthRotation = SBL::Math::Matrix44::Rotation(earthTransform.m_rotation);
+		SBL::Math::Matrix44 earthObjTransform = SBL::Math::BuildWorldTransformMatrix(earthTransform);
 		cbObject.transform.objectToView = SBL::Math::Transpose(worldToView * earthObjTransform);
 		cbObject.transform.objectToWorld = SBL::Math::Transpose(earthObjTransform);
 
 		SBL::Math::Matrix44 earthobjectToWorldNormal = earthRotation * SBL::Math::InverseScale(earthScale);
 		cbObject.transform.normalToView = SBL::Math::Transpose(earthobjectToWorldNormal);
 		cbObject.transform.normalToWorld = SBL::Math::Transpose(earthobjectToWorldNormal);
+		// The unit sphere scales with the transform, and so does its tessellation error
+		RCE::Lod::Bounds earthBounds = { earthTransform.m_translation, earthTransform.m_uniformScale };
+		float pixelsPerUnit = RCE::Lod::PixelsPerUnit(earthBounds, RCE::Camera::camPosition,
+			RCE::Lod::ProjectionScale(RCE::Camera::fov, height), nearPlane) * earthTransform.m_uniformScale;
+		sphereLodLevel = RCE::Lod::SelectLevel(sphereLodErrors.data(), (int)sphereLodErrors.size(), pixelsPerUnit,
+			sphereLodLevel, LOD_PIXEL_ERROR);
+		const RCE::MeshCache::LodEntry& sphereLod = sphereMesh.lods[sphereLodLevel];
+
 		cbObject.surface.roughness = 0.6f;
 		cbObject.surface.specularF0 = {0.7f, 0.7f, 0.7f};
 
 		cbView.worldToView = SBL::Math::Transpose(worldToView);
 		cbView.eyePosition = RCE::Camera::camPosition;
 
-		cbView.pointLight[0].position = SBL::Math::Vector3(5, 0, -5);
-		cbView.pointLight[0].color = SBL::Math::Vector3(1, 0, 0);
-		cbView.pointLight[1].position = SBL::Math::Vector3(0, 5, -5);
-		cbView.pointLight[1].color = SBL::Math::Vector3(0, 1, 0);
-		cbView.pointLight[2].position = SBL::Math::Vector3(0, 0, -5);
-		cbView.pointLight[2].color = SBL::Math::Vector3(0, 0, 1);
-		cbView.pointLight[3].position = SBL::Math::Vector3(5, 0, 5);
-		cbView.pointLight[3].color = SBL::Math::Vector3(0, 1, 1);
-		cbView.pointLight[4].position = SBL::Math::Vector3(0, 5, 5);
-		cbView.pointLight[4].color = SBL::Math::Vector3(1, 0, 1);
-		cbView.pointLight[5].position = SBL::Math::Vector3(5, 5, 5);
-		cbView.pointLight[5].color = SBL::Math::Vector3(1, 1, 0);
+		for (int i = 0; i < _countof(POINT_LIGHTS); i++) {
+			cbView.pointLight[i] = POINT_LIGHTS[i];
+		}
 
 		cbView.frameNum = cbView.frameNum+1;
 
-		// Copy constant buffer
-		{
-			void* gpuData;
-			D3D12_RANGE range = {};
-			cbObjectUploadHeap[frame]->Map(0, &range, &gpuData);
-			memcpy(gpuData, &cbObject, sizeof(CBObject));
-			cbObjectUploadHeap[frame]->Unmap(0, nullptr);
-		}
-
-		{
-			void* gpuData;
-			D3D12_RANGE range = {};
-			cbViewUploadHeap[frame]->Map(0, &range, &gpuData);
-			memcpy(gpuData, &cbView, sizeof(CBView));
-			cbViewUploadHeap[frame]->Unmap(0, nullptr);
-		}
+		// The slot's fence has passed, so its constants from the last time around are free
+		RCE::Upload::BeginFrame(&frameConstants.allocator, slot);
+		const D3D12_GPU_VIRTUAL_ADDRESS cbObjectAddress = PushFrameConstants(&frameConstants, &cbObject, sizeof(CBObject));
+		const D3D12_GPU_VIRTUAL_ADDRESS cbViewAddress = PushFrameConstants(&frameConstants, &cbView, sizeof(CBView));
 
 		auto renderViewDescriptor = rtvDescriptorStart;
-		renderViewDescriptor.ptr += (size_t)rtvDescriptorSize * frame; // rtvDescriptorStart points to beginning of heap, then there's the two back buffers at the start
+		renderViewDescriptor.ptr += (size_t)rtvDescriptorSize * backBuffer; // rtvDescriptorStart points to beginning of heap, one descriptor per back buffer
 		commandList->ClearRenderTargetView(renderViewDescriptor, ClearColor, 0, nullptr);
 		
 		commandList->OMSetRenderTargets(1, &renderViewDescriptor, FALSE, nullptr);
@@ -958,37 +1671,102 @@ int main(int argc, char* argv[]) {
 
 		commandList->SetGraphicsRootSignature(rootSignature);
 
-		commandList->SetGraphicsRootConstantBufferView(0, cbObjectUploadHeap[frame]->GetGPUVirtualAddress());
-		commandList->SetGraphicsRootConstantBufferView(1, cbViewUploadHeap[frame]->GetGPUVirtualAddress());
-		
-		ID3D12DescriptorHeap* descriptorHeaps[] = { cbvSrvUavHeap };
-		commandList->SetDescriptorHeaps(_countof(descriptorHeaps), descriptorHeaps);
-		commandList->SetGraphicsRootDescriptorTable(2, cbvSrvUavHeap->GetGPUDescriptorHandleForHeapStart());
-
-		commandList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST); // Shouldn't this be done with pipeline state object?
-		commandList->SetPipelineState(pipelineStateObject);
-		commandList->IASetVertexBuffers(0, 1, &vbView);
-		commandList->IASetIndexBuffer(&ibView);
-		commandList->DrawIndexedInstanced(sphere.indexCount, 1, 0, 0, 0);
+		commandList->SetGraphicsRootConstantBufferView(0, cbObjectAddress);
+		commandList->SetGraphicsRootConstantBufferView(1, cbViewAddress);
 		
-		commandList->ResourceBarrier(1, &transitionToPresentBarrier[frame]);
+		// Until the copy queue is done the frame is only cleared, the textures and the geometry are not in place yet
+		if (assetsResident) {
+			ID3D12DescriptorHeap* descriptorHeaps[] = { cbvSrvUavHeap };
+			commandList->SetDescriptorHeaps(_countof(descriptorHeaps), descriptorHeaps);
+			commandList->SetGraphicsRootDescriptorTable(2, cbvSrvUavHeap->GetGPUDescriptorHandleForHeapStart());
+
+			commandList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST); // Shouldn't this be done with pipeline state object?
+			commandList->SetPipelineState(pipelineStateObject);
+			commandList->IASetVertexBuffers(0, 1, &vbView);
+			commandList->IASetIndexBuffer(&ibView);
+			RCE::Lod::FrameStats frameStats = {};
+			if (USE_MESHLET_CULLING) {
+				const RCE::Meshlet::Meshlet* meshlets = sphereMesh.meshlets + sphereLod.meshletOffset;
+				RCE::Camera::Frustum frustum = RCE::Camera::MakeFrustum(RCE::Camera::camPosition, RCE::Camera::camForward,
+					RCE::Camera::camUp, RCE::Camera::fov, ((float)width) / height, nearPlane, farPlane);
+				RCE::Meshlet::CullMeshlets(sphereMesh.meshletBounds + sphereLod.meshletOffset, sphereLod.meshletCount, earthObjTransform,
+					earthTransform.m_uniformScale, RCE::Camera::camPosition, frustum, &visibleMeshlets);
+
+				// Meshlets are consecutive index ranges, so runs of visible meshlets go out as one draw
+				for (size_t i = 0; i < visibleMeshlets.size();) {
+					const RCE::Meshlet::Meshlet& first = meshlets[visibleMeshlets[i]];
+					int triangleCount = first.triangleCount;
+					size_t next = i + 1;
+					while (next < visibleMeshlets.size() && visibleMeshlets[next] == visibleMeshlets[next - 1] + 1) {
+						triangleCount += meshlets[visibleMeshlets[next]].triangleCount;
+						next++;
+					}
+					commandList->DrawIndexedInstanced(triangleCount * 3, 1, sphereLod.startIndex + first.triangleOffset * 3,
+						sphereLod.baseVertex, 0);
+					RCE::Lod::RecordDraw(&frameStats, triangleCount * 3);
+					i = next;
+				}
+			}
+			else {
+				commandList->DrawIndexedInstanced(sphereLod.indexCount, 1, sphereLod.startIndex, sphereLod.baseVertex, 0);
+				RCE::Lod::RecordDraw(&frameStats, sphereLod.indexCount);
+			}
+
+			if (ReportStats && sphereLodLevel != drawnSphereLodLevel) {
+				std::cout << "Sphere LOD " << drawnSphereLodLevel << " -> " << sphereLodLevel << ": " << frameStats.trianglesSubmitted
+					<< " triangles in " << frameStats.drawCalls << " draws per frame (level has " << sphereLod.indexCount / 3
+					<< ", full detail would be " << sphereMesh.lods[sphereMesh.lodCount - 1].indexCount / 3 << ")\n";
+				drawnSphereLodLevel = sphereLodLevel;
+			}
+		}
+		else {
+			framesWithoutAssets++;
+		}
+
+		commandList->ResourceBarrier(1, &transitionToPresentBarrier[backBuffer]);
+		commandList->EndQuery(timestampHeap, D3D12_QUERY_TYPE_TIMESTAMP, 2 * slot + 1);
+		commandList->ResolveQueryData(timestampHeap, D3D12_QUERY_TYPE_TIMESTAMP, 2 * slot, 2, timestampReadback,
+			2 * slot * sizeof(uint64_t));
+		slotTimed[slot] = true;
 			
 		hr = commandList->Close();
 		assert(SUCCEEDED(hr));
 		
+		// The first frame drawing with the uploads makes the direct queue wait for them. The copy fence has already passed
+		// on the CPU, so the wait never stalls, it only orders the two queues.
+		if (assetsResident && RCE::Upload::WaitNeeded(&copyQueue.scheduler, assetsFenceValue)) {
+			hr = commandQueue->Wait(copyQueue.fence, assetsFenceValue);
+			assert(SUCCEEDED(hr));
+		}
 		commandQueue->ExecuteCommandLists(1, (ID3D12CommandList**) &commandList);
 
 		lastExecutedFenceValue++;
 		hr = commandQueue->Signal(fence, lastExecutedFenceValue);
 		assert(SUCCEEDED(hr));
+		frameFenceValue[slot] = lastExecutedFenceValue;
 
 		// ... What do here?
 
-		hr = swapChain->Present(1, 0);
+		// Measuring runs unthrottled so the CPU and the GPU are never both waiting for vsync
+		hr = swapChain->Present(measureOverlap ? 0 : 1, 0);
 		assert(SUCCEEDED(hr));
 
 		// ... What do here?
 	}
 
+	// Whether the window was closed or -measure-overlap is done, the GPU may still be running frames and copies. Both
+	// queues are drained before anything they use goes away: the direct queue through a final signal, the copy queue up
+	// to its last submitted batch.
+	lastExecutedFenceValue++;
+	hr = commandQueue->Signal(fence, lastExecutedFenceValue);
+	assert(SUCCEEDED(hr));
+	WaitForFence(fence, lastExecutedFenceValue, fenceEvent);
+	WaitForFence(copyQueue.fence, copyQueue.scheduler.lastSubmitted, fenceEvent);
+
+	// Closing while textures are still loading: loads that have not started are dropped, the running ones finish before
+	// textureLoads they write to goes away
+	RCE::Jobs::CancelJobs(&texturePool);
+	RCE::Jobs::JoinJobs(&texturePool);
+
 	return (0);
 } 
\ No newline at end of file
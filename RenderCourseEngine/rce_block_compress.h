@@ -0,0 +1,773 @@
+#pragma once
+#include "rce_mip.h"
+
+#include <algorithm>
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <thread>
+#include <vector>
+
+namespace RCE {
+	namespace BlockCompress {
+		// Every format stores 4x4 pixel blocks. Images whose size is not a multiple of 4 repeat their last row and column
+		// into the partial blocks.
+		enum class BlockFormat {
+			BC1, // RGB, two 5:6:5 endpoints and 2-bit indices, 8 bytes per block
+			BC3, // BC1 color plus a BC4 block for alpha, 16 bytes
+			BC4, // R only, two 8-bit endpoints and 3-bit indices, 8 bytes
+			BC5, // R and G as two BC4 blocks, 16 bytes
+			BC7, // RGBA, only mode 6 is written: 7.7.7.7 endpoints with a p-bit each and 4-bit indices, 16 bytes
+		};
+
+		// What a texture holds, which decides the channels that have to survive compression
+		enum class TextureRole {
+			Albedo,        // RGB color
+			SingleChannel, // height, mask or transparency in R
+			Normal,        // tangent space X and Y, the shader rebuilds Z
+		};
+
+		// Images smaller than this are compressed on the calling thread
+		constexpr int MIN_BLOCKS_PER_THREAD = 1024;
+
+		// Least squares passes over the endpoints after the initial fit, each one stops early once it stops helping
+		constexpr int REFINE_ITERATIONS = 2;
+
+		inline BlockFormat FormatForRole(TextureRole role, BlockFormat albedoFormat) {
+			switch (role) {
+			case TextureRole::SingleChannel: return BlockFormat::BC4;
+			case TextureRole::Normal: return BlockFormat::BC5;
+			default: return albedoFormat;
+			}
+		}
+
+		inline int BlockBytes(BlockFormat format) {
+			return format == BlockFormat::BC1 || format == BlockFormat::BC4 ? 8 : 16;
+		}
+
+		// Leading RGBA channels the format keeps, the rest decode to constants
+		inline int ChannelCount(BlockFormat format) {
+			switch (format) {
+			case BlockFormat::BC1: return 3;
+			case BlockFormat::BC4: return 1;
+			case BlockFormat::BC5: return 2;
+			default: return 4;
+			}
+		}
+
+		inline const char* FormatName(BlockFormat format) {
+			const char* names[] = { "BC1", "BC3", "BC4", "BC5", "BC7" };
+			return names[(int)format];
+		}
+
+		inline int BlocksAcross(int pixels) {
+			return (pixels + 3) / 4;
+		}
+
+		// Bytes in one row of blocks
+		inline size_t RowPitch(BlockFormat format, int width) {
+			return (size_t)BlocksAcross(width) * BlockBytes(format);
+		}
+
+		inline size_t CompressedSize(BlockFormat format, int width, int height) {
+			return RowPitch(format, width) * BlocksAcross(height);
+		}
+
+		// Copies the 4x4 RGBA block at (blockX, blockY), clamping reads to the image
+		inline void LoadBlock(const uint8_t* rgba, int width, int height, int blockX, int blockY, uint8_t block[64]) {
+			for (int y = 0; y < 4; y++) {
+				int sy = std::min(blockY * 4 + y, height - 1);
+				for (int x = 0; x < 4; x++) {
+					int sx = std::min(blockX * 4 + x, width - 1);
+					memcpy(block + (y * 4 + x) * 4, rgba + ((size_t)sy * width + sx) * 4, 4);
+				}
+			}
+		}
+
+		inline int SquaredDistance(const uint8_t* a, const int* b, int channels) {
+			int sum = 0;
+			for (int c = 0; c < channels; c++) {
+				int d = a[c] - b[c];
+				sum += d * d;
+			}
+			return sum;
+		}
+
+		// Endpoints for the first channels of a block: the extent of its pixels along their principal axis
+		inline void FitEndpoints(const uint8_t block[64], int channels, float lo[4], float hi[4]) {
+			float mean[4] = {};
+			for (int i = 0; i < 16; i++) {
+				for (int c = 0; c < channels; c++) {
+					mean[c] += block[i * 4 + c];
+				}
+			}
+			for (int c = 0; c < channels; c++) {
+				mean[c] /= 16.0f;
+			}
+
+			float covariance[4][4] = {};
+			for (int i = 0; i < 16; i++) {
+				float d[4];
+				for (int c = 0; c < channels; c++) {
+					d[c] = block[i * 4 + c] - mean[c];
+				}
+				for (int a = 0; a < channels; a++) {
+					for (int b = a; b < channels; b++) {
+						covariance[a][b] += d[a] * d[b];
+					}
+				}
+			}
+			for (int a = 0; a < channels; a++) {
+				for (int b = 0; b < a; b++) {
+					covariance[a][b] = covariance[b][a];
+				}
+			}
+
+			// Squaring the covariance three times gives C^8, whose columns all lean towards the principal axis. Taking the
+			// longest column rather than iterating from a fixed start keeps axes orthogonal to that start, such as red
+			// against blue, from collapsing to nothing. Each step is rescaled by its largest entry to stay finite.
+			float power[4][4];
+			memcpy(power, covariance, sizeof(power));
+			for (int step = 0; step < 3; step++) {
+				float squared[4][4] = {};
+				float largest = 0.0f;
+				for (int a = 0; a < channels; a++) {
+					for (int b = 0; b < channels; b++) {
+						for (int k = 0; k < channels; k++) {
+							squared[a][b] += power[a][k] * power[k][b];
+						}
+						largest = std::max(largest, fabsf(squared[a][b]));
+					}
+				}
+				if (largest == 0.0f) {
+					break;
+				}
+				for (int a = 0; a < channels; a++) {
+					for (int b = 0; b < channels; b++) {
+						power[a][b] = squared[a][b] / largest;
+					}
+				}
+			}
+			float axis[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+			float longest = 0.0f;
+			for (int b = 0; b < channels; b++) {
+				float columnLength = 0.0f;
+				for (int a = 0; a < channels; a++) {
+					columnLength += power[a][b] * power[a][b];
+				}
+				if (columnLength > longest) {
+					longest = columnLength;
+					for (int a = 0; a < channels; a++) {
+						axis[a] = power[a][b];
+					}
+				}
+			}
+			float length = 0.0f;
+			for (int c = 0; c < channels; c++) {
+				length += axis[c] * axis[c];
+			}
+			length = sqrtf(length);
+			for (int c = 0; c < channels; c++) {
+				axis[c] /= length;
+			}
+
+			float minT = 0.0f;
+			float maxT = 0.0f;
+			for (int i = 0; i < 16; i++) {
+				float t = 0.0f;
+				for (int c = 0; c < channels; c++) {
+					t += (block[i * 4 + c] - mean[c]) * axis[c];
+				}
+				minT = std::min(minT, t);
+				maxT = std::max(maxT, t);
+			}
+			for (int c = 0; c < channels; c++) {
+				lo[c] = std::min(std::max(mean[c] + axis[c] * minT, 0.0f), 255.0f);
+				hi[c] = std::min(std::max(mean[c] + axis[c] * maxT, 0.0f), 255.0f);
+			}
+		}
+
+		// Least squares endpoints for fixed indices, weights[i] is how far pixel i sits from e0 towards e1. Returns false
+		// when every pixel uses the same weight, which leaves the endpoints undetermined.
+		inline bool RefineEndpoints(const uint8_t block[64], int channels, const float weights[16], float e0[4], float e1[4]) {
+			float aa = 0.0f, ab = 0.0f, bb = 0.0f;
+			float ax[4] = {}, bx[4] = {};
+			for (int i = 0; i < 16; i++) {
+				float b = weights[i];
+				float a = 1.0f - b;
+				aa += a * a;
+				ab += a * b;
+				bb += b * b;
+				for (int c = 0; c < channels; c++) {
+					ax[c] += a * block[i * 4 + c];
+					bx[c] += b * block[i * 4 + c];
+				}
+			}
+			float det = aa * bb - ab * ab;
+			if (fabsf(det) < 1e-6f) {
+				return false;
+			}
+			for (int c = 0; c < channels; c++) {
+				e0[c] = std::min(std::max((ax[c] * bb - bx[c] * ab) / det, 0.0f), 255.0f);
+				e1[c] = std::min(std::max((bx[c] * aa - ax[c] * ab) / det, 0.0f), 255.0f);
+			}
+			return true;
+		}
+
+		// BC1
+
+		inline uint16_t PackRGB565(const float rgb[3]) {
+			int r = (int)(rgb[0] * 31.0f / 255.0f + 0.5f);
+			int g = (int)(rgb[1] * 63.0f / 255.0f + 0.5f);
+			int b = (int)(rgb[2] * 31.0f / 255.0f + 0.5f);
+			return (uint16_t)((r << 11) | (g << 5) | b);
+		}
+
+		// Four colors in stored index order. BC1 blocks with color0 <= color1 use the three color mode, which has black in
+		// index 3. The color part of BC3 is always four color.
+		inline void BC1Palette(uint16_t color0, uint16_t color1, bool fourColor, int palette[4][4]) {
+			const uint16_t colors[2] = { color0, color1 };
+			for (int e = 0; e < 2; e++) {
+				int r = (colors[e] >> 11) & 31;
+				int g = (colors[e] >> 5) & 63;
+				int b = colors[e] & 31;
+				palette[e][0] = (r << 3) | (r >> 2);
+				palette[e][1] = (g << 2) | (g >> 4);
+				palette[e][2] = (b << 3) | (b >> 2);
+				palette[e][3] = 255;
+			}
+			for (int c = 0; c < 3; c++) {
+				if (fourColor) {
+					palette[2][c] = (2 * palette[0][c] + palette[1][c] + 1) / 3;
+					palette[3][c] = (palette[0][c] + 2 * palette[1][c] + 1) / 3;
+				}
+				else {
+					palette[2][c] = (palette[0][c] + palette[1][c] + 1) / 2;
+					palette[3][c] = 0;
+				}
+			}
+			palette[2][3] = 255;
+			palette[3][3] = fourColor ? 255 : 0;
+		}
+
+		// Picks the closest four color mode entry for every pixel, returns the total squared error
+		inline int SelectBC1Indices(const uint8_t block[64], uint16_t color0, uint16_t color1, uint32_t* indices) {
+			int palette[4][4];
+			BC1Palette(color0, color1, true, palette);
+			int total = 0;
+			*indices = 0;
+			for (int i = 0; i < 16; i++) {
+				int best = 0;
+				int bestError = SquaredDistance(block + i * 4, palette[0], 3);
+				for (int p = 1; p < 4; p++) {
+					int error = SquaredDistance(block + i * 4, palette[p], 3);
+					if (error < bestError) {
+						best = p;
+						bestError = error;
+					}
+				}
+				*indices |= (uint32_t)best << (i * 2);
+				total += bestError;
+			}
+			return total;
+		}
+
+		// Always writes the four color mode. Swapping the endpoints keeps the palette, only the index order changes.
+		inline void WriteBC1(uint16_t color0, uint16_t color1, uint32_t indices, uint8_t out[8]) {
+			if (color0 < color1) {
+				std::swap(color0, color1);
+				indices ^= 0x55555555; // 0 <-> 1, 2 <-> 3
+			}
+			else if (color0 == color1) {
+				indices = 0;
+			}
+			memcpy(out, &color0, 2);
+			memcpy(out + 2, &color1, 2);
+			memcpy(out + 4, &indices, 4);
+		}
+
+		inline void EncodeBC1(const uint8_t block[64], uint8_t out[8]) {
+			float lo[4], hi[4];
+			FitEndpoints(block, 3, lo, hi);
+			uint16_t color0 = PackRGB565(hi);
+			uint16_t color1 = PackRGB565(lo);
+			uint32_t indices;
+			int error = SelectBC1Indices(block, color0, color1, &indices);
+
+			// Stored index to position along the color0 -> color1 line
+			const float weights[4] = { 0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f };
+			for (int iteration = 0; iteration < REFINE_ITERATIONS && error > 0; iteration++) {
+				float pixelWeights[16];
+				for (int i = 0; i < 16; i++) {
+					pixelWeights[i] = weights[(indices >> (i * 2)) & 3];
+				}
+				float e0[4], e1[4];
+				if (!RefineEndpoints(block, 3, pixelWeights, e0, e1)) {
+					break;
+				}
+				uint16_t refined0 = PackRGB565(e0);
+				uint16_t refined1 = PackRGB565(e1);
+				uint32_t refinedIndices;
+				int refinedError = SelectBC1Indices(block, refined0, refined1, &refinedIndices);
+				if (refinedError >= error) {
+					break;
+				}
+				color0 = refined0;
+				color1 = refined1;
+				indices = refinedIndices;
+				error = refinedError;
+			}
+			WriteBC1(color0, color1, indices, out);
+		}
+
+		inline void DecodeBC1(const uint8_t block[8], bool forceFourColor, uint8_t rgba[64]) {
+			uint16_t color0, color1;
+			uint32_t indices;
+			memcpy(&color0, block, 2);
+			memcpy(&color1, block + 2, 2);
+			memcpy(&indices, block + 4, 4);
+			int palette[4][4];
+			BC1Palette(color0, color1, forceFourColor || color0 > color1, palette);
+			for (int i = 0; i < 16; i++) {
+				const int* color = palette[(indices >> (i * 2)) & 3];
+				for (int c = 0; c < 4; c++) {
+					rgba[i * 4 + c] = (uint8_t)color[c];
+				}
+			}
+		}
+
+		// BC4, the 16 values of one channel are stride bytes apart
+
+		inline void BC4Palette(int value0, int value1, int palette[8]) {
+			palette[0] = value0;
+			palette[1] = value1;
+			if (value0 > value1) {
+				for (int i = 1; i < 7; i++) {
+					palette[i + 1] = ((7 - i) * value0 + i * value1 + 3) / 7;
+				}
+			}
+			else {
+				for (int i = 1; i < 5; i++) {
+					palette[i + 1] = ((5 - i) * value0 + i * value1 + 2) / 5;
+				}
+				palette[6] = 0;
+				palette[7] = 255;
+			}
+		}
+
+		// Eight value mode between the block's minimum and maximum
+		inline void EncodeBC4(const uint8_t* values, int stride, uint8_t out[8]) {
+			int lo = 255, hi = 0;
+			for (int i = 0; i < 16; i++) {
+				lo = std::min(lo, (int)values[i * stride]);
+				hi = std::max(hi, (int)values[i * stride]);
+			}
+			int palette[8];
+			BC4Palette(hi, lo, palette);
+			uint64_t indices = 0;
+			if (hi > lo) {
+				for (int i = 0; i < 16; i++) {
+					int v = values[i * stride];
+					int best = 0;
+					int bestError = abs(v - palette[0]);
+					for (int p = 1; p < 8; p++) {
+						int error = abs(v - palette[p]);
+						if (error < bestError) {
+							best = p;
+							bestError = error;
+						}
+					}
+					indices |= (uint64_t)best << (i * 3);
+				}
+			}
+			out[0] = (uint8_t)hi;
+			out[1] = (uint8_t)lo;
+			for (int b = 0; b < 6; b++) {
+				out[2 + b] = (uint8_t)(indices >> (b * 8));
+			}
+		}
+
+		inline void DecodeBC4(const uint8_t block[8], uint8_t* values, int stride) {
+			int palette[8];
+			BC4Palette(block[0], block[1], palette);
+			uint64_t indices = 0;
+			for (int b = 0; b < 6; b++) {
+				indices |= (uint64_t)block[2 + b] << (b * 8);
+			}
+			for (int i = 0; i < 16; i++) {
+				values[i * stride] = (uint8_t)palette[(indices >> (i * 3)) & 7];
+			}
+		}
+
+		// BC7 mode 6
+
+		constexpr int BC7_WEIGHTS[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+		// 7-bit RGBA plus the p-bit that becomes the low bit of all four channels
+		struct Mode6Endpoint {
+			int value[4];
+			int pBit;
+		};
+
+		inline Mode6Endpoint QuantizeMode6(const float color[4]) {
+			Mode6Endpoint best = {};
+			float bestError = 1e30f;
+			for (int p = 0; p < 2; p++) {
+				Mode6Endpoint candidate = {};
+				candidate.pBit = p;
+				float error = 0.0f;
+				for (int c = 0; c < 4; c++) {
+					int q = (int)((color[c] - p) / 2.0f + 0.5f);
+					candidate.value[c] = std::min(std::max(q, 0), 127);
+					float d = (candidate.value[c] * 2 + p) - color[c];
+					error += d * d;
+				}
+				if (error < bestError) {
+					best = candidate;
+					bestError = error;
+				}
+			}
+			return best;
+		}
+
+		inline void Mode6Palette(const Mode6Endpoint& e0, const Mode6Endpoint& e1, int palette[16][4]) {
+			for (int c = 0; c < 4; c++) {
+				int a = e0.value[c] * 2 + e0.pBit;
+				int b = e1.value[c] * 2 + e1.pBit;
+				for (int i = 0; i < 16; i++) {
+					palette[i][c] = ((64 - BC7_WEIGHTS[i]) * a + BC7_WEIGHTS[i] * b + 32) >> 6;
+				}
+			}
+		}
+
+		// The palette lies on a line, so each pixel is projected onto it and only the entries next to the projection are
+		// compared. The weights are within a third of a step of i * 64 / 15, which keeps the best one among them.
+		inline int SelectMode6Indices(const uint8_t block[64], const Mode6Endpoint& e0, const Mode6Endpoint& e1, uint8_t indices[16]) {
+			int palette[16][4];
+			Mode6Palette(e0, e1, palette);
+			int direction[4];
+			int lengthSquared = 0;
+			for (int c = 0; c < 4; c++) {
+				direction[c] = palette[15][c] - palette[0][c];
+				lengthSquared += direction[c] * direction[c];
+			}
+			const float scale = lengthSquared > 0 ? 15.0f / lengthSquared : 0.0f;
+
+			int total = 0;
+			for (int i = 0; i < 16; i++) {
+				const uint8_t* pixel = block + i * 4;
+				int dot = 0;
+				for (int c = 0; c < 4; c++) {
+					dot += (pixel[c] - palette[0][c]) * direction[c];
+				}
+				int center = std::min(std::max((int)(dot * scale + 0.5f), 0), 15);
+				int best = center;
+				int bestError = SquaredDistance(pixel, palette[center], 4);
+				for (int p = std::max(center - 1, 0); p <= std::min(center + 1, 15); p++) {
+					int error = SquaredDistance(pixel, palette[p], 4);
+					if (error < bestError) {
+						best = p;
+						bestError = error;
+					}
+				}
+				indices[i] = (uint8_t)best;
+				total += bestError;
+			}
+			return total;
+		}
+
+		// Endpoints and an index below 8 that reproduce one color exactly. Quantizing the color itself fails for channels
+		// whose parity differs from the shared p-bit; interpolating between endpoints with different p-bits reaches
+		// every value, except that no pair reaches both 0 and 255. Returns false for colors holding both.
+		inline bool FitMode6SingleColor(const uint8_t color[4], Mode6Endpoint* e0, Mode6Endpoint* e1, int* index) {
+			for (int i = 0; i < 8; i++) {
+				const int w = BC7_WEIGHTS[i];
+				for (int pBits = 0; pBits < 4; pBits++) {
+					Mode6Endpoint a = {};
+					Mode6Endpoint b = {};
+					a.pBit = pBits & 1;
+					b.pBit = pBits >> 1;
+					bool fits = true;
+					for (int c = 0; c < 4 && fits; c++) {
+						const int t = color[c];
+						const int first = std::max(t / 2 - 1, 0);
+						const int last = std::min(t / 2 + 1, 127);
+						fits = false;
+						for (int x = first; x <= last && !fits; x++) {
+							for (int y = first; y <= last && !fits; y++) {
+								if ((((64 - w) * (x * 2 + a.pBit) + w * (y * 2 + b.pBit) + 32) >> 6) == t) {
+									a.value[c] = x;
+									b.value[c] = y;
+									fits = true;
+								}
+							}
+						}
+					}
+					if (fits) {
+						*e0 = a;
+						*e1 = b;
+						*index = i;
+						return true;
+					}
+				}
+			}
+			return false;
+		}
+
+		// Appends bits to a 128-bit block, least significant bit first
+		struct BitWriter {
+			uint8_t* out;
+			int position;
+
+			void Write(uint32_t value, int bits) {
+				for (int b = 0; b < bits; b++, position++) {
+					out[position >> 3] |= (uint8_t)(((value >> b) & 1) << (position & 7));
+				}
+			}
+		};
+
+		struct BitReader {
+			const uint8_t* data;
+			int position;
+
+			uint32_t Read(int bits) {
+				uint32_t value = 0;
+				for (int b = 0; b < bits; b++, position++) {
+					value |= (uint32_t)((data[position >> 3] >> (position & 7)) & 1) << b;
+				}
+				return value;
+			}
+		};
+
+		inline bool IsSingleColor(const uint8_t block[64]) {
+			for (int i = 1; i < 16; i++) {
+				if (memcmp(block, block + i * 4, 4) != 0) {
+					return false;
+				}
+			}
+			return true;
+		}
+
+		inline void EncodeBC7(const uint8_t block[64], uint8_t out[16]) {
+			Mode6Endpoint e0, e1;
+			uint8_t indices[16];
+			int error = 0;
+			int singleIndex = 0;
+			if (IsSingleColor(block) && FitMode6SingleColor(block, &e0, &e1, &singleIndex)) {
+				memset(indices, singleIndex, 16);
+			} else {
+				float lo[4], hi[4];
+				FitEndpoints(block, 4, lo, hi);
+				e0 = QuantizeMode6(lo);
+				e1 = QuantizeMode6(hi);
+				error = SelectMode6Indices(block, e0, e1, indices);
+			}
+
+			for (int iteration = 0; iteration < REFINE_ITERATIONS && error > 0; iteration++) {
+				float weights[16];
+				for (int i = 0; i < 16; i++) {
+					weights[i] = BC7_WEIGHTS[indices[i]] / 64.0f;
+				}
+				float refinedLo[4], refinedHi[4];
+				if (!RefineEndpoints(block, 4, weights, refinedLo, refinedHi)) {
+					break;
+				}
+				Mode6Endpoint refined0 = QuantizeMode6(refinedLo);
+				Mode6Endpoint refined1 = QuantizeMode6(refinedHi);
+				uint8_t refinedIndices[16];
+				int refinedError = SelectMode6Indices(block, refined0, refined1, refinedIndices);
+				if (refinedError >= error) {
+					break;
+				}
+				e0 = refined0;
+				e1 = refined1;
+				memcpy(indices, refinedIndices, 16);
+				error = refinedError;
+			}
+
+			// The first pixel's index is stored without its top bit, so it has to be below 8
+			if (indices[0] >= 8) {
+				std::swap(e0, e1);
+				for (int i = 0; i < 16; i++) {
+					indices[i] = (uint8_t)(15 - indices[i]);
+				}
+			}
+
+			memset(out, 0, 16);
+			BitWriter writer = { out, 0 };
+			writer.Write(1 << 6, 7);
+			for (int c = 0; c < 4; c++) {
+				writer.Write(e0.value[c], 7);
+				writer.Write(e1.value[c], 7);
+			}
+			writer.Write(e0.pBit, 1);
+			writer.Write(e1.pBit, 1);
+			writer.Write(indices[0], 3);
+			for (int i = 1; i < 16; i++) {
+				writer.Write(indices[i], 4);
+			}
+		}
+
+		// Decodes mode 6 blocks only, anything else comes out as the error color the specification asks for (all zero)
+		inline void DecodeBC7(const uint8_t block[16], uint8_t rgba[64]) {
+			if ((block[0] & 0x7F) != 0x40) {
+				memset(rgba, 0, 64);
+				return;
+			}
+			BitReader reader = { block, 7 };
+			Mode6Endpoint e0, e1;
+			for (int c = 0; c < 4; c++) {
+				e0.value[c] = (int)reader.Read(7);
+				e1.value[c] = (int)reader.Read(7);
+			}
+			e0.pBit = (int)reader.Read(1);
+			e1.pBit = (int)reader.Read(1);
+			int palette[16][4];
+			Mode6Palette(e0, e1, palette);
+			for (int i = 0; i < 16; i++) {
+				const int* color = palette[reader.Read(i == 0 ? 3 : 4)];
+				for (int c = 0; c < 4; c++) {
+					rgba[i * 4 + c] = (uint8_t)color[c];
+				}
+			}
+		}
+
+		inline void EncodeBlock(BlockFormat format, const uint8_t block[64], uint8_t* out) {
+			switch (format) {
+			case BlockFormat::BC1:
+				EncodeBC1(block, out);
+				break;
+			case BlockFormat::BC3:
+				EncodeBC4(block + 3, 4, out);
+				EncodeBC1(block, out + 8);
+				break;
+			case BlockFormat::BC4:
+				EncodeBC4(block, 4, out);
+				break;
+			case BlockFormat::BC5:
+				EncodeBC4(block, 4, out);
+				EncodeBC4(block + 1, 4, out + 8);
+				break;
+			case BlockFormat::BC7:
+				EncodeBC7(block, out);
+				break;
+			}
+		}
+
+		// Channels the format does not store decode to 0, alpha to 255, the same as a GPU sampling the texture
+		inline void DecodeBlock(BlockFormat format, const uint8_t* data, uint8_t rgba[64]) {
+			switch (format) {
+			case BlockFormat::BC1:
+				DecodeBC1(data, false, rgba);
+				break;
+			case BlockFormat::BC3:
+				DecodeBC1(data + 8, true, rgba);
+				DecodeBC4(data, rgba + 3, 4);
+				break;
+			case BlockFormat::BC4:
+			case BlockFormat::BC5:
+				for (int i = 0; i < 16; i++) {
+					rgba[i * 4 + 1] = 0;
+					rgba[i * 4 + 2] = 0;
+					rgba[i * 4 + 3] = 255;
+				}
+				DecodeBC4(data, rgba, 4);
+				if (format == BlockFormat::BC5) {
+					DecodeBC4(data + 8, rgba + 1, 4);
+				}
+				break;
+			case BlockFormat::BC7:
+				DecodeBC7(data, rgba);
+				break;
+			}
+		}
+
+		// Every level of a block compressed mip chain, largest first. Rows of blocks are tightly packed, RowPitch apart.
+		struct CompressedMips {
+			BlockFormat format;
+			std::vector<uint8_t> blocks;
+			std::vector<Mip::MipLevel> levels; // offsets index into blocks
+		};
+
+		// Compresses every level of an RGBA8 mip chain. All rows of blocks, whatever their level, are split into
+		// threadCount contiguous ranges (0 picks the hardware thread count), so the small levels never get threads of
+		// their own.
+		inline void CompressMips(const Mip::MipChain& mips, BlockFormat format, CompressedMips* out, int threadCount = 0) {
+			out->format = format;
+			out->levels.resize(mips.levels.size());
+			size_t totalBytes = 0;
+			int totalBlocks = 0;
+			std::vector<int> rowLevel; // level of every row of blocks
+			std::vector<int> rowIndex; // row of blocks within that level
+			for (size_t level = 0; level < mips.levels.size(); level++) {
+				const Mip::MipLevel& mip = mips.levels[level];
+				out->levels[level] = { mip.width, mip.height, totalBytes };
+				totalBytes += CompressedSize(format, mip.width, mip.height);
+				totalBlocks += BlocksAcross(mip.width) * BlocksAcross(mip.height);
+				for (int row = 0; row < BlocksAcross(mip.height); row++) {
+					rowLevel.push_back((int)level);
+					rowIndex.push_back(row);
+				}
+			}
+			out->blocks.resize(totalBytes);
+
+			if (threadCount <= 0) {
+				threadCount = (int)std::max(1u, std::thread::hardware_concurrency());
+			}
+			const int rowCount = (int)rowLevel.size();
+			threadCount = std::min(threadCount, std::max(1, totalBlocks / MIN_BLOCKS_PER_THREAD));
+			threadCount = std::min(threadCount, std::max(1, rowCount));
+
+			auto work = [&](int t) {
+				uint8_t block[64];
+				for (int r = rowCount * t / threadCount; r < rowCount * (t + 1) / threadCount; r++) {
+					const Mip::MipLevel& source = mips.levels[rowLevel[r]];
+					const Mip::MipLevel& dest = out->levels[rowLevel[r]];
+					uint8_t* row = out->blocks.data() + dest.offset + rowIndex[r] * RowPitch(format, dest.width);
+					for (int x = 0; x < BlocksAcross(source.width); x++) {
+						LoadBlock(mips.pixels.data() + source.offset, source.width, source.height, x, rowIndex[r], block);
+						EncodeBlock(format, block, row + x * BlockBytes(format));
+					}
+				}
+			};
+
+			std::vector<std::thread> workers;
+			for (int t = 1; t < threadCount; t++) {
+				workers.emplace_back(work, t);
+			}
+			work(0);
+			for (std::thread& worker : workers) {
+				worker.join();
+			}
+		}
+
+		inline void DecompressImage(const uint8_t* blocks, int width, int height, BlockFormat format, uint8_t* rgba) {
+			uint8_t block[64];
+			for (int by = 0; by < BlocksAcross(height); by++) {
+				for (int bx = 0; bx < BlocksAcross(width); bx++) {
+					DecodeBlock(format, blocks + by * RowPitch(format, width) + bx * BlockBytes(format), block);
+					for (int y = 0; y < 4 && by * 4 + y < height; y++) {
+						for (int x = 0; x < 4 && bx * 4 + x < width; x++) {
+							memcpy(rgba + ((size_t)(by * 4 + y) * width + bx * 4 + x) * 4, block + (y * 4 + x) * 4, 4);
+						}
+					}
+				}
+			}
+		}
+
+		// PSNR in dB over the first channels of two RGBA8 images, infinite when they match
+		inline double PeakSignalToNoise(const uint8_t* reference, const uint8_t* test, size_t pixelCount, int channels) {
+			double sum = 0.0;
+			for (size_t i = 0; i < pixelCount; i++) {
+				for (int c = 0; c < channels; c++) {
+					int d = reference[i * 4 + c] - test[i * 4 + c];
+					sum += d * d;
+				}
+			}
+			double mse = sum / ((double)pixelCount * channels);
+			return mse > 0.0 ? 10.0 * log10(255.0 * 255.0 / mse) : INFINITY;
+		}
+	}
+}
@@ -6,25 +6,25 @@ namespace RCE {
 	namespace Camera {
 		using namespace SBL::Math;
 
-		Vector3 DEFAULT_FORWARD = Vector3(0, 0, 1);
-		Vector3 DEFAULT_UP = Vector3(0, 1, 0);
+		constexpr Vector3 DEFAULT_FORWARD = Vector3(0, 0, 1);
+		constexpr Vector3 DEFAULT_UP = Vector3(0, 1, 0);
 
 
-		Vector3 camPosition = Vector3(0, 0, -2);
-		Vector3 camForward = Vector3(0, 0, 1);
-		Vector3 camUp = Vector3(0, 1, 0);
-		float fov = PI / 2;
+		inline Vector3 camPosition = Vector3(0, 0, -2);
+		inline Vector3 camForward = Vector3(0, 0, 1);
+		inline Vector3 camUp = Vector3(0, 1, 0);
+		inline float fov = PI / 2;
 
-		bool leftMouseWasDown = false;
-		int32_t startX = 0;
-		int32_t startY = 0;
+		inline bool leftMouseWasDown = false;
+		inline int32_t startX = 0;
+		inline int32_t startY = 0;
 
-		float cameraYaw;
-		float cameraPitch;
+		inline float cameraYaw;
+		inline float cameraPitch;
 
 
-		float mouseYaw;
-		float mousePitch;
+		inline float mouseYaw;
+		inline float mousePitch;
 
 		inline void EventUpdate(char keycode, bool leftMouseDown, int32_t mouseX, int32_t mouseY) {
 			constexpr float moveStep = 0.1f;
@@ -108,7 +108,7 @@ namespace RCE {
 			// Implicitly assumes height = 1
 
 			// Create a projection that takes points from (x,y,z) to (x/z, y/z, ~z)
-			auto proj = Matrix44(
+			constexpr auto proj = Matrix44(
 				1, 0, 0, 0,
 				0, 1, 0, 0,
 				0, 0, 1, 1, // z = z + w
@@ -129,5 +129,53 @@ namespace RCE {
 
 			return fov_scale * proj;
 		}
+
+		// Plane points are those with DotProduct(normal, p) + distance >= 0, the normals point into the frustum
+		struct Plane {
+			Vector3 normal;
+			float distance;
+		};
+
+		struct Frustum {
+			Plane planes[6]; // near, far, left, right, bottom, top
+		};
+
+		// World space frustum of the view built by MakeCameraTransform and MakeCameraCanonicalView with the same arguments
+		inline Frustum MakeFrustum(Vector3 camPosition, Vector3 camDirection, Vector3 camUp, float fovVert, float widthOverHeight,
+			float nearPlane, float farPlane) {
+			auto w = Normalized(camDirection);
+			auto u = Normalized(CrossProduct(camUp, w));
+			auto v = CrossProduct(w, u);
+
+			float halfHeight = fovVert / 2;
+			float halfWidth = atan(tan(halfHeight) * widthOverHeight);
+
+			Vector3 normals[6] = {
+				w,
+				-w,
+				w * sin(halfWidth) + u * cos(halfWidth),
+				w * sin(halfWidth) - u * cos(halfWidth),
+				w * sin(halfHeight) + v * cos(halfHeight),
+				w * sin(halfHeight) - v * cos(halfHeight),
+			};
+
+			Frustum frustum;
+			for (int i = 0; i < 6; i++) {
+				frustum.planes[i].normal = normals[i];
+				frustum.planes[i].distance = -DotProduct(normals[i], camPosition);
+			}
+			frustum.planes[0].distance -= nearPlane;
+			frustum.planes[1].distance += farPlane;
+			return frustum;
+		}
+
+		inline bool SphereInFrustum(const Frustum& frustum, Vector3 center, float radius) {
+			for (int i = 0; i < 6; i++) {
+				if (DotProduct(frustum.planes[i].normal, center) + frustum.planes[i].distance < -radius) {
+					return false;
+				}
+			}
+			return true;
+		}
 	}
 }
@@ -0,0 +1,54 @@
+#pragma once
+#include "rce_upload_ring.h"
+
+#include <assert.h>
+#include <stdint.h>
+
+namespace RCE {
+	namespace Upload {
+		// D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT
+		constexpr uint64_t CONSTANT_ALIGNMENT = 256;
+
+		// Linear allocator for memory the GPU reads during one frame only, such as constant buffers. The buffer is split
+		// into one region per frame slot. A frame bumps through its slot's region, and BeginFrame starts the region over
+		// once the fence of the frame that used the slot last has passed. Only offsets are handed out, like UploadRing.
+		// Not thread safe, allocate from the thread that records the frame.
+		struct FrameAllocator {
+			uint64_t regionSize;
+			int regionCount;
+			int region; // -1 outside a frame
+			uint64_t used;
+			uint64_t peak; // most any frame has used
+		};
+
+		inline void InitFrameAllocator(FrameAllocator* allocator, uint64_t regionSize, int regionCount) {
+			allocator->regionSize = regionSize & ~(CONSTANT_ALIGNMENT - 1);
+			allocator->regionCount = regionCount;
+			allocator->region = -1;
+			allocator->used = 0;
+			allocator->peak = 0;
+		}
+
+		// Everything allocated from region in an earlier frame must no longer be in use by the GPU
+		inline void BeginFrame(FrameAllocator* allocator, int region) {
+			assert(region >= 0 && region < allocator->regionCount);
+			allocator->region = region;
+			allocator->used = 0;
+		}
+
+		// Returns the offset of size bytes aligned to CONSTANT_ALIGNMENT, or INVALID_OFFSET when the region is full
+		inline uint64_t AllocateFrame(FrameAllocator* allocator, uint64_t size) {
+			assert(allocator->region >= 0);
+			uint64_t alignedSize = (size + CONSTANT_ALIGNMENT - 1) & ~(CONSTANT_ALIGNMENT - 1);
+			if (alignedSize > allocator->regionSize - allocator->used) {
+				return INVALID_OFFSET;
+			}
+			uint64_t offset = allocator->region * allocator->regionSize + allocator->used;
+			allocator->used += alignedSize;
+			if (allocator->used > allocator->peak) {
+				allocator->peak = allocator->used;
+			}
+			return offset;
+		}
+	}
+}
@@ -0,0 +1,67 @@
+#pragma once
+#include <algorithm>
+#include <stdint.h>
+
+namespace RCE {
+	namespace Pacing {
+		// The fence value the GPU has to reach before the CPU records a frame into a slot. slotFenceValue is what the last
+		// frame recorded into the slot signalled, its allocator and buffers are free once that has completed. The newest
+		// submitted frame signalled lastSubmitted, and at most framesInFlight - 1 of the submitted frames may still be
+		// running when recording starts, so framesInFlight with this one.
+		inline uint64_t FrameWaitValue(uint64_t lastSubmitted, uint64_t slotFenceValue, int framesInFlight) {
+			uint64_t inFlightLimit = lastSubmitted >= (uint64_t)framesInFlight ? lastSubmitted + 1 - framesInFlight : 0;
+			return std::max(slotFenceValue, inFlightLimit);
+		}
+
+		// Where the CPU spent its time between frames, accumulated over a reporting interval
+		struct WaitStats {
+			int frames;
+			double swapChainMs;    // waiting for the swap chain to accept another frame
+			double fenceMs;        // waiting for the GPU to free the frame's slot
+			double maxWaitMs;      // longest total wait of a single frame
+			double frameMs;        // from one frame's start to the next
+			double maxFrameMs;
+		};
+
+		inline void RecordFrame(WaitStats* stats, double swapChainMs, double fenceMs, double frameMs) {
+			stats->frames++;
+			stats->swapChainMs += swapChainMs;
+			stats->fenceMs += fenceMs;
+			stats->maxWaitMs = std::max(stats->maxWaitMs, swapChainMs + fenceMs);
+			stats->frameMs += frameMs;
+			stats->maxFrameMs = std::max(stats->maxFrameMs, frameMs);
+		}
+
+		// CPU and GPU busy time over a stretch of frames. GPU times arrive a few frames late, once the frame has finished,
+		// so they are counted separately.
+		struct OverlapStats {
+			int frames;
+			double wallMs;
+			double cpuMs;   // the frame time without the waits
+			int gpuFrames;
+			double gpuMs;   // from the first to the last command of each frame
+		};
+
+		inline void RecordCpuFrame(OverlapStats* stats, double frameMs, double waitMs) {
+			stats->frames++;
+			stats->wallMs += frameMs;
+			stats->cpuMs += std::max(0.0, frameMs - waitMs);
+		}
+
+		inline void RecordGpuFrame(OverlapStats* stats, double gpuMs) {
+			stats->gpuFrames++;
+			stats->gpuMs += gpuMs;
+		}
+
+		// Share of the frame time the CPU and the GPU were both busy: 0 when they take turns, 1 when each of them works the
+		// whole frame. Assumes they are never idle at the same time, which holds without vsync.
+		inline double OverlapFraction(const OverlapStats& stats) {
+			if (stats.frames == 0 || stats.gpuFrames == 0 || stats.wallMs <= 0.0) {
+				return 0.0;
+			}
+			double frameMs = stats.wallMs / stats.frames;
+			double busyMs = stats.cpuMs / stats.frames + stats.gpuMs / stats.gpuFrames;
+			return std::min(1.0, std::max(0.0, (busyMs - frameMs) / frameMs));
+		}
+	}
+}
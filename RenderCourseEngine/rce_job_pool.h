@@ -0,0 +1,83 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace RCE {
+	namespace Jobs {
+		// Runs job(0) ... job(count - 1) on worker threads and hands the indices back to one consumer thread in the order
+		// the jobs finish. Workers pull the next index themselves, so a slow job never holds up the others.
+		struct JobPool {
+			std::function<void(int)> job;
+			int count = 0;
+			std::atomic<int> next{ 0 };
+			std::vector<std::thread> workers;
+
+			std::mutex mutex;
+			std::vector<int> completed; // guarded by mutex
+			int taken = 0;              // consumer only
+
+			// Cancels and joins whatever is still running, see CancelJobs
+			~JobPool();
+		};
+
+		// Starts the workers and returns right away. threadCount 0 picks the hardware thread count, never more threads
+		// than jobs are started.
+		inline void StartJobs(JobPool* pool, int count, std::function<void(int)> job, int threadCount = 0) {
+			pool->job = std::move(job);
+			pool->count = count;
+			pool->next = 0;
+			pool->completed.clear();
+			pool->completed.reserve(count);
+			pool->taken = 0;
+
+			if (threadCount <= 0) {
+				threadCount = (int)std::max(1u, std::thread::hardware_concurrency());
+			}
+			threadCount = std::min(threadCount, count);
+			for (int t = 0; t < threadCount; t++) {
+				pool->workers.emplace_back([pool] {
+					for (int i = pool->next++; i < pool->count; i = pool->next++) {
+						pool->job(i);
+						std::lock_guard<std::mutex> lock(pool->mutex);
+						pool->completed.push_back(i);
+					}
+				});
+			}
+		}
+
+		// Returns the index of a finished job that has not been handed out yet, -1 when there is none right now
+		inline int TryNextJob(JobPool* pool) {
+			std::lock_guard<std::mutex> lock(pool->mutex);
+			if ((int)pool->completed.size() == pool->taken) {
+				return -1;
+			}
+			return pool->completed[pool->taken++];
+		}
+
+		inline bool AllJobsTaken(const JobPool* pool) {
+			return pool->taken == pool->count;
+		}
+
+		inline void JoinJobs(JobPool* pool) {
+			for (std::thread& worker : pool->workers) {
+				worker.join();
+			}
+			pool->workers.clear();
+		}
+
+		// Stops the workers from starting any further jobs, the ones already running still finish. Jobs that never
+		// started are never handed back, JoinJobs afterwards returns once the running ones are done.
+		inline void CancelJobs(JobPool* pool) {
+			pool->next = pool->count;
+		}
+
+		inline JobPool::~JobPool() {
+			CancelJobs(this);
+			JoinJobs(this);
+		}
+	}
+}
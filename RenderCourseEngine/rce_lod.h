@@ -0,0 +1,74 @@
+#pragma once
+#include <SBLMath/Vector3.hpp>
+
+#include <math.h>
+#include <stdint.h>
+
+namespace RCE {
+	namespace Lod {
+		using namespace SBL::Math;
+
+		// Largest error a level may show on screen, in pixels
+		constexpr float DEFAULT_PIXEL_ERROR = 1.0f;
+
+		// A coarser level is only picked once its error drops below this fraction of the threshold. Without the gap an
+		// object sitting right at a switch distance would flip between two levels every frame.
+		constexpr float HYSTERESIS = 0.75f;
+
+		struct Bounds {
+			Vector3 center;
+			float radius;
+		};
+
+		// Pixels covered by one world unit at distance 1 from the camera
+		inline float ProjectionScale(float fovVert, int viewportHeight) {
+			return viewportHeight / (2.0f * tanf(fovVert / 2.0f));
+		}
+
+		// Pixels covered by one world unit at the point of the bounds closest to the camera. Anything closer than the near
+		// plane, including a camera inside the bounds, is treated as sitting on it.
+		inline float PixelsPerUnit(const Bounds& bounds, Vector3 camPosition, float projectionScale, float nearPlane) {
+			float distance = Length(bounds.center - camPosition) - bounds.radius;
+			if (distance < nearPlane) {
+				distance = nearPlane;
+			}
+			return projectionScale / distance;
+		}
+
+		// Picks the coarsest level whose error stays under pixelError. levelErrors holds the world space error of every
+		// level, coarsest first, so it must be decreasing. previousLevel is the level picked last frame, or -1 when there is
+		// none. Finer levels are picked right away, coarser ones only with HYSTERESIS applied.
+		inline int SelectLevel(const float* levelErrors, int levelCount, float pixelsPerUnit, int previousLevel,
+			float pixelError = DEFAULT_PIXEL_ERROR) {
+			int wanted = levelCount - 1;
+			for (int level = 0; level < levelCount; level++) {
+				if (levelErrors[level] * pixelsPerUnit <= pixelError) {
+					wanted = level;
+					break;
+				}
+			}
+
+			if (previousLevel < 0 || previousLevel >= levelCount || wanted >= previousLevel) {
+				return wanted;
+			}
+
+			for (int level = wanted; level < previousLevel; level++) {
+				if (levelErrors[level] * pixelsPerUnit <= pixelError * HYSTERESIS) {
+					return level;
+				}
+			}
+			return previousLevel;
+		}
+
+		// Geometry submitted in one frame
+		struct FrameStats {
+			int drawCalls;
+			int64_t trianglesSubmitted;
+		};
+
+		inline void RecordDraw(FrameStats* stats, int indexCount, int instanceCount = 1) {
+			stats->drawCalls++;
+			stats->trianglesSubmitted += (int64_t)(indexCount / 3) * instanceCount;
+		}
+	}
+}
@@ -0,0 +1,169 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace RCE {
+	namespace File {
+		// 64-bit content hash for detecting truncated or corrupted files. Uses xxHash64's round and avalanche steps on four
+		// independent lanes, which keeps it well above disk speed, but the output is not compatible with xxHash.
+		inline uint64_t Checksum64(const void* data, size_t size, uint64_t seed = 0) {
+			constexpr uint64_t PRIME1 = 0x9E3779B185EBCA87ull;
+			constexpr uint64_t PRIME2 = 0xC2B2AE3D27D4EB4Full;
+			constexpr uint64_t PRIME3 = 0x165667B19E3779F9ull;
+
+			auto rotl = [](uint64_t x, int r) { return (x << r) | (x >> (64 - r)); };
+			auto mix = [&](uint64_t acc, uint64_t word) { return rotl(acc + word * PRIME2, 31) * PRIME1; };
+
+			const uint8_t* bytes = (const uint8_t*)data;
+			uint64_t lanes[4] = { seed + PRIME1 + PRIME2, seed + PRIME2, seed, seed - PRIME1 };
+			size_t i = 0;
+			for (; i + 32 <= size; i += 32) {
+				for (int lane = 0; lane < 4; lane++) {
+					uint64_t word;
+					memcpy(&word, bytes + i + lane * 8, 8);
+					lanes[lane] = mix(lanes[lane], word);
+				}
+			}
+
+			uint64_t hash = rotl(lanes[0], 1) + rotl(lanes[1], 7) + rotl(lanes[2], 12) + rotl(lanes[3], 18) + size;
+			for (; i + 8 <= size; i += 8) {
+				uint64_t word;
+				memcpy(&word, bytes + i, 8);
+				hash = rotl(hash ^ mix(0, word), 27) * PRIME1 + PRIME3;
+			}
+			for (; i < size; i++) {
+				hash = rotl(hash ^ (bytes[i] * PRIME3), 11) * PRIME1;
+			}
+
+			hash ^= hash >> 33;
+			hash *= PRIME2;
+			hash ^= hash >> 29;
+			hash *= PRIME3;
+			hash ^= hash >> 32;
+			return hash;
+		}
+
+		// Outcome of loading one of the cache containers
+		enum class LoadResult {
+			Ok,
+			Invalid,          // not the expected container, or ranges that do not fit the file
+			WrongVersion,
+			Stale,            // sourceKey does not match
+			ChecksumMismatch,
+		};
+
+		inline const char* LoadResultName(LoadResult result) {
+			switch (result) {
+			case LoadResult::Ok: return "ok";
+			case LoadResult::Invalid: return "invalid file";
+			case LoadResult::WrongVersion: return "wrong version";
+			case LoadResult::Stale: return "stale";
+			case LoadResult::ChecksumMismatch: return "checksum mismatch";
+			}
+			return "unknown";
+		}
+
+		// Read only view of a whole file. Pages are loaded by the OS on first touch, so opening is cheap whatever the size.
+		struct MappedFile {
+			const uint8_t* data;
+			size_t size;
+#ifdef _WIN32
+			HANDLE file;
+			HANDLE mapping;
+#else
+			int file;
+#endif
+		};
+
+		inline void CloseMappedFile(MappedFile* mapped) {
+#ifdef _WIN32
+			if (mapped->data != nullptr) {
+				UnmapViewOfFile(mapped->data);
+			}
+			if (mapped->mapping != nullptr) {
+				CloseHandle(mapped->mapping);
+			}
+			if (mapped->file != INVALID_HANDLE_VALUE) {
+				CloseHandle(mapped->file);
+			}
+			mapped->file = INVALID_HANDLE_VALUE;
+			mapped->mapping = nullptr;
+#else
+			if (mapped->data != nullptr) {
+				munmap((void*)mapped->data, mapped->size);
+			}
+			if (mapped->file >= 0) {
+				close(mapped->file);
+			}
+			mapped->file = -1;
+#endif
+			mapped->data = nullptr;
+			mapped->size = 0;
+		}
+
+		// Returns false if the file is missing, empty or cannot be mapped. out is always safe to pass to CloseMappedFile.
+		inline bool OpenMappedFile(const char* path, MappedFile* out) {
+			out->data = nullptr;
+			out->size = 0;
+#ifdef _WIN32
+			out->mapping = nullptr;
+			out->file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+			if (out->file == INVALID_HANDLE_VALUE) {
+				return false;
+			}
+
+			LARGE_INTEGER size;
+			if (!GetFileSizeEx(out->file, &size) || size.QuadPart == 0) {
+				CloseMappedFile(out);
+				return false;
+			}
+
+			out->mapping = CreateFileMappingA(out->file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+			if (out->mapping == nullptr) {
+				CloseMappedFile(out);
+				return false;
+			}
+
+			out->data = (const uint8_t*)MapViewOfFile(out->mapping, FILE_MAP_READ, 0, 0, 0);
+			if (out->data == nullptr) {
+				CloseMappedFile(out);
+				return false;
+			}
+			out->size = (size_t)size.QuadPart;
+#else
+			out->file = open(path, O_RDONLY);
+			if (out->file < 0) {
+				return false;
+			}
+
+			struct stat info;
+			if (fstat(out->file, &info) != 0 || info.st_size == 0) {
+				CloseMappedFile(out);
+				return false;
+			}
+
+			void* data = mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, out->file, 0);
+			if (data == MAP_FAILED) {
+				CloseMappedFile(out);
+				return false;
+			}
+			out->data = (const uint8_t*)data;
+			out->size = (size_t)info.st_size;
+#endif
+			return true;
+		}
+	}
+}
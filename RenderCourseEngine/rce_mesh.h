@@ -0,0 +1,300 @@
+#pragma once
+#include <SBLMath/Vector3.hpp>
+
+#include "rce_vertex.h"
+
+#include <algorithm>
+#include <atomic>
+#include <math.h>
+#include <thread>
+#include <vector>
+
+namespace RCE {
+	namespace Mesh {
+		using namespace SBL::Math;
+		using RCE::VertexFormat::Vertex;
+
+		struct MeshData {
+			std::vector<Vertex> vertices;
+			std::vector<int> indices;
+			// Largest distance between the triangles and the surface they approximate, in object units
+			float geometricError = 0.0f;
+		};
+
+		// Every primitive is a (segments + 1) x (rings + 1) grid of vertices. The last column repeats the first one so the
+		// texture seam gets its own u = 1 vertices.
+		enum class Primitive {
+			Sphere, // rings go from the top pole to the bottom pole
+			Torus,  // rings go around the tube
+			Plane,  // unit square in XZ facing +Y
+		};
+
+		// Each worker gets at least this many vertices, spawning one for less costs more than it saves
+		constexpr int MIN_VERTICES_PER_THREAD = 4 * 1024;
+
+		// Rows are handed out to workers in blocks of about this many vertices, so the levels of a chain spread evenly
+		// over the workers whatever their sizes
+		constexpr int VERTICES_PER_BLOCK = 4 * 1024;
+
+		constexpr double HALF_TURN = 3.14159265358979323846;
+
+		constexpr float TORUS_MAJOR_RADIUS = 0.7f;
+		constexpr float TORUS_MINOR_RADIUS = 0.3f;
+
+		// cos/sin of i * stepAngle for i in [0, steps], built by repeatedly rotating (1, 0) by stepAngle instead of calling
+		// libm per entry. The accumulation is done in double so 512 steps stay well within float precision.
+		inline void BuildRotationTable(int steps, double stepAngle, std::vector<float>* cosOut, std::vector<float>* sinOut) {
+			cosOut->resize(steps + 1);
+			sinOut->resize(steps + 1);
+			const double stepCos = cos(stepAngle);
+			const double stepSin = sin(stepAngle);
+			double c = 1.0;
+			double s = 0.0;
+			for (int i = 0; i <= steps; i++) {
+				(*cosOut)[i] = (float)c;
+				(*sinOut)[i] = (float)s;
+				double rotatedC = c * stepCos - s * stepSin;
+				s = s * stepCos + c * stepSin;
+				c = rotatedC;
+			}
+		}
+
+		inline bool CollapsesToPoles(Primitive primitive) {
+			return primitive == Primitive::Sphere;
+		}
+
+		inline int VertexCount(int segments, int rings) {
+			return (segments + 1) * (rings + 1);
+		}
+
+		// Poles drop the triangle that collapses onto them, see GenerateIndexRows
+		inline int IndexCount(Primitive primitive, int segments, int rings) {
+			int triangleRows = CollapsesToPoles(primitive) ? 2 * rings - 2 : 2 * rings;
+			return segments * triangleRows * 3;
+		}
+
+		// First index written by quad row y
+		inline int IndexRowStart(Primitive primitive, int segments, int y) {
+			if (CollapsesToPoles(primitive) && y > 0) {
+				return (2 * y - 1) * segments * 3;
+			}
+			return 2 * y * segments * 3;
+		}
+
+		// Second order estimate of the tessellation error. Over a quad with sides X and Y along the principal directions
+		// the surface bulges by X^2 / (8 * r1) + Y^2 / (8 * r2) from the middle of the quad's diagonal, where r1 and r2 are
+		// the radii of curvature. Spheres and tori are worst on the equator, where both the quads and the radii are largest.
+		inline float TessellationError(Primitive primitive, int segments, int rings) {
+			const double segmentStep = 2.0 * HALF_TURN / segments;
+			switch (primitive) {
+			case Primitive::Sphere: {
+				const double ringStep = HALF_TURN / rings;
+				return (float)((segmentStep * segmentStep + ringStep * ringStep) / 8.0);
+			}
+			case Primitive::Torus: {
+				const double ringStep = 2.0 * HALF_TURN / rings;
+				const double outerRadius = TORUS_MAJOR_RADIUS + TORUS_MINOR_RADIUS;
+				return (float)((segmentStep * segmentStep * outerRadius + ringStep * ringStep * TORUS_MINOR_RADIUS) / 8.0);
+			}
+			case Primitive::Plane:
+				break;
+			}
+			return 0.0f;
+		}
+
+		struct GridTables {
+			std::vector<float> segmentCos, segmentSin;
+			std::vector<float> ringCos, ringSin;
+		};
+
+		inline void GenerateVertexRows(Primitive primitive, int segments, int rings, const GridTables& tables, int rowBegin,
+			int rowEnd, Vertex* vertices) {
+			for (int y = rowBegin; y < rowEnd; y++) {
+				Vertex* row = vertices + y * (segments + 1);
+				const float v = (float)y / rings;
+				const float ringCos = tables.ringCos[y];
+				const float ringSin = tables.ringSin[y];
+
+				for (int x = 0; x <= segments; x++) {
+					const float u = (float)x / segments;
+					const float segmentCos = tables.segmentCos[x];
+					const float segmentSin = tables.segmentSin[x];
+
+					Vector3 position = Vector3(0, 0, 0);
+					Vector3 normal = Vector3(0, 1, 0);
+					switch (primitive) {
+					case Primitive::Sphere:
+						normal = Vector3(ringSin * segmentCos, ringCos, ringSin * segmentSin);
+						position = normal;
+						break;
+					case Primitive::Torus: {
+						// The tube is walked top to bottom on its outside, matching the sphere's winding
+						normal = Vector3(ringCos * segmentCos, -ringSin, ringCos * segmentSin);
+						float distance = TORUS_MAJOR_RADIUS + TORUS_MINOR_RADIUS * ringCos;
+						position = Vector3(distance * segmentCos, -TORUS_MINOR_RADIUS * ringSin, distance * segmentSin);
+						break;
+					}
+					case Primitive::Plane:
+						position = Vector3(0.5f - u, 0, v - 0.5f);
+						break;
+					}
+
+					Vertex vert = { position, u, v, normal };
+					row[x] = vert;
+				}
+			}
+		}
+
+		inline void GenerateIndexRows(Primitive primitive, int segments, int rings, int rowBegin, int rowEnd, int* indices) {
+			const bool poles = CollapsesToPoles(primitive);
+			for (int y = rowBegin; y < rowEnd; y++) {
+				int index = IndexRowStart(primitive, segments, y);
+				for (int x = 0; x < segments; x++) {
+
+					/*
+						I0---I1
+						|  / |
+						| /  |
+						I2---I3
+
+						I0 = (y, x)      I1 = (y, x + 1)
+						I2 = (y + 1, x)  I3 = (y + 1, x + 1)
+					*/
+
+					int i0 = y * (segments + 1) + x;
+					int i1 = i0 + 1;
+					int i2 = i0 + (segments + 1);
+					int i3 = i2 + 1;
+
+					// I0 and I1 are the same point on the top pole
+					if (!poles || y != 0) {
+						indices[index++] = i0;
+						indices[index++] = i2;
+						indices[index++] = i1;
+					}
+
+					// I2 and I3 are the same point on the bottom pole
+					if (!poles || y != rings - 1) {
+						indices[index++] = i1;
+						indices[index++] = i2;
+						indices[index++] = i3;
+					}
+				}
+			}
+		}
+
+		struct LevelJob {
+			Primitive primitive;
+			int segments;
+			int rings;
+			GridTables tables;
+			MeshData* out;
+		};
+
+		// Builds the angle tables of one level and sizes its output
+		inline void PrepareLevel(LevelJob* level) {
+			const Primitive primitive = level->primitive;
+			const int segments = level->segments;
+			const int rings = level->rings;
+			GridTables& tables = level->tables;
+			BuildRotationTable(segments, 2.0 * HALF_TURN / segments, &tables.segmentCos, &tables.segmentSin);
+			double ringStep = primitive == Primitive::Sphere ? HALF_TURN / rings : 2.0 * HALF_TURN / rings;
+			BuildRotationTable(rings, ringStep, &tables.ringCos, &tables.ringSin);
+
+			// Make the seam and the poles bit exact so the mesh stays watertight
+			tables.segmentCos[segments] = tables.segmentCos[0];
+			tables.segmentSin[segments] = tables.segmentSin[0];
+			if (primitive == Primitive::Sphere) {
+				tables.ringCos[rings] = -1.0f;
+				tables.ringSin[rings] = 0.0f;
+			}
+			else {
+				tables.ringCos[rings] = tables.ringCos[0];
+				tables.ringSin[rings] = tables.ringSin[0];
+			}
+
+			level->out->geometricError = TessellationError(primitive, segments, rings);
+			level->out->vertices.resize(VertexCount(segments, rings));
+			level->out->indices.resize(IndexCount(primitive, segments, rings));
+		}
+
+		// Generates every level at once. The quad rows of all levels are cut into blocks that threadCount workers (0 picks
+		// the hardware thread count) pull from a shared counter; every block writes disjoint vertex and index ranges, so
+		// the output does not depend on the thread count.
+		inline void GenerateLevels(std::vector<LevelJob>* levels, int threadCount) {
+			struct RowBlock {
+				int level;
+				int rowBegin;
+				int rowEnd;
+			};
+
+			std::vector<RowBlock> blocks;
+			int totalVertices = 0;
+			for (int l = 0; l < (int)levels->size(); l++) {
+				LevelJob& level = (*levels)[l];
+				PrepareLevel(&level);
+				totalVertices += VertexCount(level.segments, level.rings);
+
+				const int rowsPerBlock = std::max(1, VERTICES_PER_BLOCK / (level.segments + 1));
+				for (int row = 0; row < level.rings; row += rowsPerBlock) {
+					blocks.push_back({ l, row, std::min(level.rings, row + rowsPerBlock) });
+				}
+			}
+
+			if (threadCount <= 0) {
+				threadCount = (int)std::max(1u, std::thread::hardware_concurrency());
+			}
+			threadCount = std::min(threadCount, std::max(1, totalVertices / MIN_VERTICES_PER_THREAD));
+			threadCount = std::min(threadCount, std::max(1, (int)blocks.size()));
+
+			// The block that ends a level also writes that level's final vertex row
+			std::atomic<size_t> nextBlock(0);
+			auto work = [&]() {
+				for (size_t b = nextBlock.fetch_add(1); b < blocks.size(); b = nextBlock.fetch_add(1)) {
+					const RowBlock& block = blocks[b];
+					LevelJob& level = (*levels)[block.level];
+					const int vertexRowEnd = block.rowEnd == level.rings ? level.rings + 1 : block.rowEnd;
+					GenerateVertexRows(level.primitive, level.segments, level.rings, level.tables, block.rowBegin,
+						vertexRowEnd, level.out->vertices.data());
+					GenerateIndexRows(level.primitive, level.segments, level.rings, block.rowBegin, block.rowEnd,
+						level.out->indices.data());
+				}
+			};
+
+			std::vector<std::thread> workers;
+			for (int t = 1; t < threadCount; t++) {
+				workers.emplace_back(work);
+			}
+			work();
+			for (std::thread& worker : workers) {
+				worker.join();
+			}
+		}
+
+		// Generates one primitive on up to threadCount workers (0 picks the hardware thread count)
+		inline void GenerateMesh(Primitive primitive, int segments, int rings, MeshData* out, int threadCount = 0) {
+			std::vector<LevelJob> levels(1);
+			levels[0] = { primitive, segments, rings, {}, out };
+			GenerateLevels(&levels, threadCount);
+		}
+
+		// One mesh per level with minSegments, 2 * minSegments, ... up to maxSegments. Spheres use half as many rings as
+		// segments, the other primitives the same number.
+		inline void GenerateLodChain(Primitive primitive, int minSegments, int maxSegments, std::vector<MeshData>* out,
+			int threadCount = 0) {
+			std::vector<LevelJob> levels;
+			for (int segments = minSegments; segments <= maxSegments; segments *= 2) {
+				int rings = primitive == Primitive::Sphere ? std::max(2, segments / 2) : segments;
+				levels.push_back({ primitive, segments, rings, {}, nullptr });
+			}
+
+			// All levels are generated together, so the small ones keep workers busy instead of running one after another.
+			// Levels already in out keep their allocations when the chain is regenerated.
+			out->resize(levels.size());
+			for (size_t l = 0; l < levels.size(); l++) {
+				levels[l].out = &(*out)[l];
+			}
+			GenerateLevels(&levels, threadCount);
+		}
+	}
+}
@@ -0,0 +1,290 @@
+#pragma once
+#include "rce_lod.h"
+#include "rce_mapped_file.h"
+#include "rce_meshlet.h"
+#include "rce_vertex.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+
+namespace RCE {
+	namespace MeshCache {
+		// Binary mesh container that is loaded by mapping it, every section is used in place.
+		//
+		// File layout: Header, then the sections listed in Header::sections, each aligned to SECTION_ALIGNMENT. Header's
+		// checksum covers everything after the header. All data is little endian in the layout of this header's structs,
+		// the file is a cache and not an interchange format.
+		constexpr uint32_t MAGIC = 'R' | ('C' << 8) | ('E' << 16) | ('M' << 24);
+		constexpr uint32_t VERSION = 1;
+		constexpr uint64_t SECTION_ALIGNMENT = 16;
+
+		enum VertexFormat : uint32_t {
+			VERTEX_FORMAT_FULL,   // VertexFormat::Vertex
+			VERTEX_FORMAT_PACKED, // VertexFormat::PackedVertex
+		};
+
+		enum Section {
+			SECTION_VERTICES,
+			SECTION_INDICES,
+			SECTION_LODS,
+			SECTION_MESHLETS,
+			SECTION_MESHLET_BOUNDS,
+			SECTION_MESHLET_VERTICES,
+			SECTION_MESHLET_TRIANGLES,
+			SECTION_COUNT,
+		};
+
+		struct SectionEntry {
+			uint64_t offset;
+			uint64_t size;
+		};
+
+		// One level of detail. Indices are relative to baseVertex, so one 16-bit index buffer can hold every level.
+		// Meshlets of the level are [meshletOffset, meshletOffset + meshletCount); their triangleOffset is relative to
+		// startIndex / 3 and their vertexOffset points into the shared meshlet vertex section. Meshlet triangles are in
+		// index buffer order, so local triangle t of a level starts at byte startIndex + 3 * t of that section.
+		struct LodEntry {
+			int32_t baseVertex;
+			int32_t startIndex;
+			int32_t indexCount;
+			float geometricError;
+			int32_t meshletOffset;
+			int32_t meshletCount;
+		};
+
+		struct Header {
+			uint32_t magic;
+			uint32_t version;
+			uint64_t sourceKey; // whatever identifies the inputs, a different key means the file is stale
+			uint64_t checksum;
+			uint32_t vertexFormat;
+			uint32_t vertexStride;
+			uint32_t indexStride; // 2 or 4
+			float boundsCenter[3];
+			float boundsRadius;
+			uint32_t reserved[3];
+			SectionEntry sections[SECTION_COUNT];
+		};
+
+		static_assert(sizeof(Meshlet::Meshlet) == 16, "Meshlet is stored as is");
+		static_assert(sizeof(Meshlet::MeshletBounds) == 32, "MeshletBounds is stored as is");
+		static_assert(sizeof(Header) % SECTION_ALIGNMENT == 0, "The first section starts right after the header");
+
+		// Mesh data wherever it lives, in a mapped cache file or in MeshArrays
+		struct MeshView {
+			const void* vertices;
+			size_t vertexCount;
+			uint32_t vertexFormat;
+			uint32_t vertexStride;
+			const void* indices;
+			size_t indexCount;
+			uint32_t indexStride;
+			const LodEntry* lods;
+			size_t lodCount;
+			const Meshlet::Meshlet* meshlets;
+			const Meshlet::MeshletBounds* meshletBounds;
+			size_t meshletCount;
+			const int* meshletVertices;
+			size_t meshletVertexCount;
+			const uint8_t* meshletTriangles;
+			size_t meshletTriangleBytes;
+			Lod::Bounds bounds;
+		};
+
+		// Owning storage for a mesh built at runtime
+		struct MeshArrays {
+			std::vector<uint8_t> vertices;
+			uint32_t vertexFormat;
+			uint32_t vertexStride;
+			std::vector<uint8_t> indices;
+			uint32_t indexStride;
+			std::vector<LodEntry> lods;
+			std::vector<Meshlet::Meshlet> meshlets;
+			std::vector<Meshlet::MeshletBounds> meshletBounds;
+			std::vector<int> meshletVertices;
+			std::vector<uint8_t> meshletTriangles;
+			Lod::Bounds bounds;
+		};
+
+		inline MeshView ViewOf(const MeshArrays& arrays) {
+			MeshView view = {};
+			view.vertices = arrays.vertices.data();
+			view.vertexFormat = arrays.vertexFormat;
+			view.vertexStride = arrays.vertexStride;
+			view.vertexCount = arrays.vertexStride ? arrays.vertices.size() / arrays.vertexStride : 0;
+			view.indices = arrays.indices.data();
+			view.indexStride = arrays.indexStride;
+			view.indexCount = arrays.indexStride ? arrays.indices.size() / arrays.indexStride : 0;
+			view.lods = arrays.lods.data();
+			view.lodCount = arrays.lods.size();
+			view.meshlets = arrays.meshlets.data();
+			view.meshletBounds = arrays.meshletBounds.data();
+			view.meshletCount = arrays.meshlets.size();
+			view.meshletVertices = arrays.meshletVertices.data();
+			view.meshletVertexCount = arrays.meshletVertices.size();
+			view.meshletTriangles = arrays.meshletTriangles.data();
+			view.meshletTriangleBytes = arrays.meshletTriangles.size();
+			view.bounds = arrays.bounds;
+			return view;
+		}
+
+		inline uint64_t AlignSection(uint64_t offset) {
+			return (offset + SECTION_ALIGNMENT - 1) & ~(SECTION_ALIGNMENT - 1);
+		}
+
+		inline bool WriteMeshCache(const char* path, const MeshView& mesh, uint64_t sourceKey) {
+			const void* sectionData[SECTION_COUNT] = {
+				mesh.vertices, mesh.indices, mesh.lods, mesh.meshlets, mesh.meshletBounds, mesh.meshletVertices,
+				mesh.meshletTriangles,
+			};
+			const uint64_t sectionSize[SECTION_COUNT] = {
+				(uint64_t)mesh.vertexCount * mesh.vertexStride,
+				(uint64_t)mesh.indexCount * mesh.indexStride,
+				(uint64_t)mesh.lodCount * sizeof(LodEntry),
+				(uint64_t)mesh.meshletCount * sizeof(Meshlet::Meshlet),
+				(uint64_t)mesh.meshletCount * sizeof(Meshlet::MeshletBounds),
+				(uint64_t)mesh.meshletVertexCount * sizeof(int),
+				(uint64_t)mesh.meshletTriangleBytes,
+			};
+
+			Header header = {};
+			header.magic = MAGIC;
+			header.version = VERSION;
+			header.sourceKey = sourceKey;
+			header.vertexFormat = mesh.vertexFormat;
+			header.vertexStride = mesh.vertexStride;
+			header.indexStride = mesh.indexStride;
+			header.boundsCenter[0] = mesh.bounds.center.x;
+			header.boundsCenter[1] = mesh.bounds.center.y;
+			header.boundsCenter[2] = mesh.bounds.center.z;
+			header.boundsRadius = mesh.bounds.radius;
+
+			uint64_t offset = sizeof(Header);
+			for (int i = 0; i < SECTION_COUNT; i++) {
+				offset = AlignSection(offset);
+				header.sections[i].offset = offset;
+				header.sections[i].size = sectionSize[i];
+				offset += sectionSize[i];
+			}
+
+			// Assembled in memory first so the checksum can go into the header
+			std::vector<uint8_t> file(offset, 0);
+			for (int i = 0; i < SECTION_COUNT; i++) {
+				if (sectionSize[i] > 0) {
+					memcpy(file.data() + header.sections[i].offset, sectionData[i], sectionSize[i]);
+				}
+			}
+			header.checksum = File::Checksum64(file.data() + sizeof(Header), file.size() - sizeof(Header));
+			memcpy(file.data(), &header, sizeof(Header));
+
+			FILE* out = fopen(path, "wb");
+			if (out == nullptr) {
+				return false;
+			}
+			bool written = fwrite(file.data(), 1, file.size(), out) == file.size();
+			written = fclose(out) == 0 && written;
+			if (!written) {
+				remove(path);
+			}
+			return written;
+		}
+
+		using File::LoadResult;
+		using File::LoadResultName;
+
+		// Points out into the mapped file, so it stays valid until the file is closed. Every range is checked against the
+		// file size and the LOD and meshlet tables against the sections they index, a corrupted file fails to load instead
+		// of reading out of bounds. verifyChecksum reads the whole file once, which is the page-in the mapping defers.
+		inline LoadResult LoadMeshCache(const File::MappedFile& file, uint64_t sourceKey, MeshView* out,
+			bool verifyChecksum = true) {
+			if (file.data == nullptr || file.size < sizeof(Header)) {
+				return LoadResult::Invalid;
+			}
+			Header header;
+			memcpy(&header, file.data, sizeof(Header));
+			if (header.magic != MAGIC) {
+				return LoadResult::Invalid;
+			}
+			if (header.version != VERSION) {
+				return LoadResult::WrongVersion;
+			}
+			if (header.sourceKey != sourceKey) {
+				return LoadResult::Stale;
+			}
+
+			const uint64_t elementSize[SECTION_COUNT] = {
+				header.vertexStride, header.indexStride, sizeof(LodEntry), sizeof(Meshlet::Meshlet),
+				sizeof(Meshlet::MeshletBounds), sizeof(int), 3,
+			};
+			uint32_t expectedStride = header.vertexFormat == VERTEX_FORMAT_PACKED ? sizeof(RCE::VertexFormat::PackedVertex)
+				: sizeof(RCE::VertexFormat::Vertex);
+			if (header.vertexFormat > VERTEX_FORMAT_PACKED || header.vertexStride != expectedStride ||
+				(header.indexStride != 2 && header.indexStride != 4)) {
+				return LoadResult::Invalid;
+			}
+			for (int i = 0; i < SECTION_COUNT; i++) {
+				const SectionEntry& section = header.sections[i];
+				if (section.offset < sizeof(Header) || section.offset % SECTION_ALIGNMENT != 0 || section.offset > file.size ||
+					section.size > file.size - section.offset || section.size % elementSize[i] != 0) {
+					return LoadResult::Invalid;
+				}
+			}
+
+			if (verifyChecksum &&
+				File::Checksum64(file.data + sizeof(Header), file.size - sizeof(Header)) != header.checksum) {
+				return LoadResult::ChecksumMismatch;
+			}
+
+			MeshView view = {};
+			auto section = [&](Section s) { return (const void*)(file.data + header.sections[s].offset); };
+			auto count = [&](Section s) { return (size_t)(header.sections[s].size / elementSize[s]); };
+			view.vertices = section(SECTION_VERTICES);
+			view.vertexCount = count(SECTION_VERTICES);
+			view.vertexFormat = header.vertexFormat;
+			view.vertexStride = header.vertexStride;
+			view.indices = section(SECTION_INDICES);
+			view.indexCount = count(SECTION_INDICES);
+			view.indexStride = header.indexStride;
+			view.lods = (const LodEntry*)section(SECTION_LODS);
+			view.lodCount = count(SECTION_LODS);
+			view.meshlets = (const Meshlet::Meshlet*)section(SECTION_MESHLETS);
+			view.meshletBounds = (const Meshlet::MeshletBounds*)section(SECTION_MESHLET_BOUNDS);
+			view.meshletCount = count(SECTION_MESHLETS);
+			view.meshletVertices = (const int*)section(SECTION_MESHLET_VERTICES);
+			view.meshletVertexCount = count(SECTION_MESHLET_VERTICES);
+			view.meshletTriangles = (const uint8_t*)section(SECTION_MESHLET_TRIANGLES);
+			view.meshletTriangleBytes = (size_t)header.sections[SECTION_MESHLET_TRIANGLES].size;
+			view.bounds.center = SBL::Math::Vector3(header.boundsCenter[0], header.boundsCenter[1], header.boundsCenter[2]);
+			view.bounds.radius = header.boundsRadius;
+
+			if (view.meshletCount != count(SECTION_MESHLET_BOUNDS) || view.lodCount == 0) {
+				return LoadResult::Invalid;
+			}
+			for (size_t i = 0; i < view.lodCount; i++) {
+				const LodEntry& lod = view.lods[i];
+				if (lod.baseVertex < 0 || (size_t)lod.baseVertex > view.vertexCount || lod.startIndex < 0 ||
+					lod.indexCount < 0 || (size_t)lod.startIndex + lod.indexCount > view.indexCount ||
+					lod.meshletOffset < 0 || lod.meshletCount < 0 ||
+					(size_t)lod.meshletOffset + lod.meshletCount > view.meshletCount) {
+					return LoadResult::Invalid;
+				}
+				for (int m = lod.meshletOffset; m < lod.meshletOffset + lod.meshletCount; m++) {
+					// Widened before adding, two int32 fields from the file can overflow int
+					const Meshlet::Meshlet& meshlet = view.meshlets[m];
+					const int64_t triangleEnd = ((int64_t)meshlet.triangleOffset + (int64_t)meshlet.triangleCount) * 3;
+					if (meshlet.vertexOffset < 0 || meshlet.vertexCount < 0 ||
+						(size_t)meshlet.vertexOffset + meshlet.vertexCount > view.meshletVertexCount ||
+						meshlet.triangleOffset < 0 || meshlet.triangleCount < 0 || triangleEnd > lod.indexCount ||
+						(uint64_t)lod.startIndex + (uint64_t)triangleEnd > view.meshletTriangleBytes) {
+						return LoadResult::Invalid;
+					}
+				}
+			}
+
+			*out = view;
+			return LoadResult::Ok;
+		}
+	}
+}
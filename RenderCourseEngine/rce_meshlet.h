@@ -0,0 +1,194 @@
+#pragma once
+#include <SBLMath/Matrix44.hpp>
+#include <SBLMath/Vector3.hpp>
+
+#include "rce_camera.h"
+#include "rce_vertex.h"
+
+#include <math.h>
+#include <stdint.h>
+#include <vector>
+
+namespace RCE {
+	namespace Meshlet {
+		using namespace SBL::Math;
+		using RCE::VertexFormat::Vertex;
+
+		// Limits recommended for mesh shaders, 124 triangles keeps the local index data of a meshlet within 372 bytes
+		constexpr int MAX_VERTICES = 64;
+		constexpr int MAX_TRIANGLES = 124;
+
+		// Meshlets are cut from the index buffer in order, so the triangles of meshlet m are the index buffer range
+		// [3 * triangleOffset, 3 * (triangleOffset + triangleCount)). The same offset addresses its local triangles.
+		struct Meshlet {
+			int vertexOffset;
+			int vertexCount;
+			int triangleOffset;
+			int triangleCount;
+		};
+
+		// Bounding sphere and normal cone. Every triangle of the meshlet faces away from any camera position p with
+		// DotProduct(center - p, coneAxis) >= coneCutoff * Length(center - p) + radius.
+		struct MeshletBounds {
+			Vector3 center;
+			float radius;
+			Vector3 coneAxis;
+			float coneCutoff; // 1 when the normals spread too far for the cone to reject anything
+		};
+
+		struct MeshletData {
+			std::vector<Meshlet> meshlets;
+			std::vector<MeshletBounds> bounds;
+			std::vector<int> vertices;       // meshlet vertex -> mesh vertex
+			std::vector<uint8_t> triangles;  // three meshlet vertices per triangle
+		};
+
+		inline MeshletBounds ComputeBounds(const Vertex* vertices, const int* meshletVertices, const Meshlet& meshlet,
+			const int* indices) {
+			MeshletBounds bounds = {};
+
+			// Center of the axis aligned box, then the farthest vertex from it
+			Vector3 boxMin = vertices[meshletVertices[0]].position;
+			Vector3 boxMax = boxMin;
+			for (int i = 1; i < meshlet.vertexCount; i++) {
+				Vector3 p = vertices[meshletVertices[i]].position;
+				boxMin = Vector3(fminf(boxMin.x, p.x), fminf(boxMin.y, p.y), fminf(boxMin.z, p.z));
+				boxMax = Vector3(fmaxf(boxMax.x, p.x), fmaxf(boxMax.y, p.y), fmaxf(boxMax.z, p.z));
+			}
+			bounds.center = (boxMin + boxMax) * 0.5f;
+			for (int i = 0; i < meshlet.vertexCount; i++) {
+				bounds.radius = fmaxf(bounds.radius, Length(vertices[meshletVertices[i]].position - bounds.center));
+			}
+
+			// Cone axis is the average face normal, the cutoff comes from the normal furthest away from it
+			const int* tri = indices + meshlet.triangleOffset * 3;
+			std::vector<Vector3> normals;
+			normals.reserve(meshlet.triangleCount);
+			Vector3 normalSum = Vector3(0, 0, 0);
+			for (int t = 0; t < meshlet.triangleCount; t++) {
+				Vector3 p0 = vertices[tri[t * 3 + 0]].position;
+				Vector3 p1 = vertices[tri[t * 3 + 1]].position;
+				Vector3 p2 = vertices[tri[t * 3 + 2]].position;
+				// Front faces are counterclockwise on screen, in the left handed world that puts the outward normal here
+				Vector3 normal = CrossProduct(p2 - p0, p1 - p0);
+				float length = Length(normal);
+				if (length > 0.0f) {
+					normals.push_back(normal / length);
+					normalSum += normal / length;
+				}
+			}
+
+			bounds.coneCutoff = 1.0f;
+			float axisLength = Length(normalSum);
+			if (axisLength == 0.0f) {
+				return bounds;
+			}
+			bounds.coneAxis = normalSum / axisLength;
+
+			float minDot = 1.0f;
+			for (const Vector3& normal : normals) {
+				minDot = fminf(minDot, DotProduct(normal, bounds.coneAxis));
+			}
+			// Cones wider than ~84 degrees would only reject from a sliver of directions
+			if (minDot > 0.1f) {
+				bounds.coneCutoff = sqrtf(1.0f - minDot * minDot);
+			}
+			return bounds;
+		}
+
+		// Cuts an index buffer into meshlets, starting a new one whenever the next triangle would exceed maxVertices or
+		// maxTriangles. Run it on a vertex cache optimized index buffer so consecutive triangles share vertices.
+		inline void BuildMeshlets(const Vertex* vertices, int vertexCount, const int* indices, size_t indexCount,
+			MeshletData* out, int maxVertices = MAX_VERTICES, int maxTriangles = MAX_TRIANGLES) {
+			out->meshlets.clear();
+			out->bounds.clear();
+			out->vertices.clear();
+			out->triangles.clear();
+			out->triangles.reserve(indexCount);
+
+			// Local index of each mesh vertex in the meshlet being built, valid when its stamp is the current meshlet
+			std::vector<int> localIndex(vertexCount);
+			std::vector<int> stamp(vertexCount, -1);
+
+			Meshlet current = {};
+			const int triangleCount = (int)(indexCount / 3);
+			for (int t = 0; t < triangleCount; t++) {
+				const int* tri = indices + t * 3;
+				const int stampId = (int)out->meshlets.size();
+				int newVertices = 0;
+				for (int k = 0; k < 3; k++) {
+					bool repeated = (k > 0 && tri[k] == tri[0]) || (k > 1 && tri[k] == tri[1]);
+					if (stamp[tri[k]] != stampId && !repeated) {
+						newVertices++;
+					}
+				}
+
+				if (current.vertexCount + newVertices > maxVertices || current.triangleCount == maxTriangles) {
+					out->meshlets.push_back(current);
+					current.vertexOffset += current.vertexCount;
+					current.triangleOffset += current.triangleCount;
+					current.vertexCount = 0;
+					current.triangleCount = 0;
+				}
+
+				const int currentId = (int)out->meshlets.size();
+				for (int k = 0; k < 3; k++) {
+					int v = tri[k];
+					if (stamp[v] != currentId) {
+						stamp[v] = currentId;
+						localIndex[v] = current.vertexCount++;
+						out->vertices.push_back(v);
+					}
+					out->triangles.push_back((uint8_t)localIndex[v]);
+				}
+				current.triangleCount++;
+			}
+			if (current.triangleCount > 0) {
+				out->meshlets.push_back(current);
+			}
+
+			out->bounds.resize(out->meshlets.size());
+			for (size_t m = 0; m < out->meshlets.size(); m++) {
+				const Meshlet& meshlet = out->meshlets[m];
+				out->bounds[m] = ComputeBounds(vertices, out->vertices.data() + meshlet.vertexOffset, meshlet, indices);
+			}
+		}
+
+		// Bounds of an object space meshlet placed with objectToWorld, which may only rotate, translate and scale by
+		// uniformScale
+		inline MeshletBounds TransformBounds(const MeshletBounds& bounds, const Matrix44& objectToWorld, float uniformScale) {
+			MeshletBounds world = bounds;
+			world.center = objectToWorld * bounds.center;
+			world.radius = bounds.radius * uniformScale;
+			Vector4 axis = objectToWorld * Vector4(bounds.coneAxis.x, bounds.coneAxis.y, bounds.coneAxis.z, 0);
+			world.coneAxis = Vector3(axis.x, axis.y, axis.z) / uniformScale;
+			return world;
+		}
+
+		inline bool IsBackFacing(const MeshletBounds& bounds, Vector3 camPosition) {
+			Vector3 toCenter = bounds.center - camPosition;
+			return DotProduct(toCenter, bounds.coneAxis) >= bounds.coneCutoff * Length(toCenter) + bounds.radius;
+		}
+
+		// Writes the indices of the meshlets that may be visible from the camera to visible, in order
+		inline void CullMeshlets(const MeshletBounds* meshletBounds, size_t meshletCount, const Matrix44& objectToWorld,
+			float uniformScale, Vector3 camPosition, const Camera::Frustum& frustum, std::vector<int>* visible) {
+			visible->clear();
+			for (size_t m = 0; m < meshletCount; m++) {
+				MeshletBounds bounds = TransformBounds(meshletBounds[m], objectToWorld, uniformScale);
+				if (IsBackFacing(bounds, camPosition)) {
+					continue;
+				}
+				if (!Camera::SphereInFrustum(frustum, bounds.center, bounds.radius)) {
+					continue;
+				}
+				visible->push_back((int)m);
+			}
+		}
+
+		inline void CullMeshlets(const MeshletData& data, const Matrix44& objectToWorld, float uniformScale,
+			Vector3 camPosition, const Camera::Frustum& frustum, std::vector<int>* visible) {
+			CullMeshlets(data.bounds.data(), data.bounds.size(), objectToWorld, uniformScale, camPosition, frustum, visible);
+		}
+	}
+}
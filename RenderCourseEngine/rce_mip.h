@@ -0,0 +1,303 @@
+#pragma once
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define RCE_MIP_SSE2 1
+#include <emmintrin.h>
+#else
+#define RCE_MIP_SSE2 0
+#endif
+
+namespace RCE {
+	namespace Mip {
+		enum class Filter {
+			Box,    // average of the source pixels under the destination pixel
+			Kaiser, // Kaiser windowed sinc, sharper than the box without its aliasing
+		};
+
+		enum class ColorSpace {
+			Linear, // data textures, filtered as stored
+			SRGB,   // color textures, filtered in linear light and stored back as sRGB
+		};
+
+		// Same window as NVIDIA Texture Tools' Kaiser filter
+		constexpr float KAISER_WIDTH = 3.0f;
+		constexpr float KAISER_ALPHA = 4.0f;
+
+		struct Settings {
+			Filter filter;
+			ColorSpace colorSpace;
+			bool wrapX; // sample across the left and right edge instead of clamping
+			bool wrapY;
+		};
+
+		struct MipLevel {
+			int width;
+			int height;
+			size_t offset; // in bytes, into MipChain::pixels
+		};
+
+		// Every level of an RGBA8 image, largest first, rows tightly packed
+		struct MipChain {
+			std::vector<uint8_t> pixels;
+			std::vector<MipLevel> levels;
+		};
+
+		inline int MipLevelCount(int width, int height) {
+			int count = 1;
+			while (width > 1 || height > 1) {
+				width = width > 1 ? width / 2 : 1;
+				height = height > 1 ? height / 2 : 1;
+				count++;
+			}
+			return count;
+		}
+
+		inline float SrgbToLinear(float value) {
+			return value <= 0.04045f ? value / 12.92f : powf((value + 0.055f) / 1.055f, 2.4f);
+		}
+
+		inline float LinearToSrgb(float value) {
+			return value <= 0.0031308f ? value * 12.92f : 1.055f * powf(value, 1.0f / 2.4f) - 0.055f;
+		}
+
+		// 8-bit to float is exact. Float to sRGB indexes 16 bits of linear precision, which is fine enough to land on the
+		// nearest 8-bit code everywhere except a handful of values right on a rounding boundary.
+		constexpr int SRGB_ENCODE_BITS = 16;
+
+		struct ConversionTables {
+			float decode[2][256]; // indexed by ColorSpace
+			uint8_t srgbEncode[1 << SRGB_ENCODE_BITS];
+		};
+
+		inline const ConversionTables& GetConversionTables() {
+			static const ConversionTables* tables = [] {
+				ConversionTables* t = new ConversionTables;
+				for (int i = 0; i < 256; i++) {
+					t->decode[(int)ColorSpace::Linear][i] = i / 255.0f;
+					t->decode[(int)ColorSpace::SRGB][i] = SrgbToLinear(i / 255.0f);
+				}
+				const int last = (1 << SRGB_ENCODE_BITS) - 1;
+				for (int i = 0; i <= last; i++) {
+					t->srgbEncode[i] = (uint8_t)(LinearToSrgb((float)i / last) * 255.0f + 0.5f);
+				}
+				return t;
+			}();
+			return *tables;
+		}
+
+		inline double BesselI0(double x) {
+			// Power series, converges quickly for the arguments a Kaiser window uses
+			double sum = 1.0;
+			double term = 1.0;
+			for (int k = 1; k < 32; k++) {
+				term *= (x / (2.0 * k)) * (x / (2.0 * k));
+				sum += term;
+				if (term < sum * 1e-12) {
+					break;
+				}
+			}
+			return sum;
+		}
+
+		inline float FilterSupport(Filter filter) {
+			return filter == Filter::Box ? 0.5f : KAISER_WIDTH;
+		}
+
+		// x is the distance in destination pixels
+		inline float FilterWeight(Filter filter, float x) {
+			x = fabsf(x);
+			if (filter == Filter::Box) {
+				return x < 0.5f ? 1.0f : 0.0f;
+			}
+			if (x >= KAISER_WIDTH) {
+				return 0.0f;
+			}
+			const double pi = 3.14159265358979323846;
+			double sinc = x < 1e-6f ? 1.0 : sin(pi * x) / (pi * x);
+			double t = x / KAISER_WIDTH;
+			return (float)(sinc * BesselI0(KAISER_ALPHA * sqrt(1.0 - t * t)) / BesselI0(KAISER_ALPHA));
+		}
+
+		// Taps for resampling one axis from sourceSize to destSize pixels, taps per destination pixel
+		struct AxisWeights {
+			int taps;
+			std::vector<int> source;
+			std::vector<float> weights;
+		};
+
+		inline void BuildAxisWeights(int sourceSize, int destSize, Filter filter, bool wrap, AxisWeights* out) {
+			const float scale = (float)sourceSize / destSize;
+			const float support = FilterSupport(filter) * scale;
+			// Source pixels whose centers fall strictly inside (center - support, center + support)
+			out->taps = (int)ceilf(2.0f * support);
+			out->source.resize((size_t)destSize * out->taps);
+			out->weights.resize((size_t)destSize * out->taps);
+
+			for (int i = 0; i < destSize; i++) {
+				const float center = (i + 0.5f) * scale;
+				const int first = (int)floorf(center - support + 0.5f);
+				float sum = 0.0f;
+				for (int t = 0; t < out->taps; t++) {
+					int s = first + t;
+					float weight = FilterWeight(filter, (s + 0.5f - center) / scale);
+					if (wrap) {
+						s = ((s % sourceSize) + sourceSize) % sourceSize;
+					}
+					else {
+						s = s < 0 ? 0 : (s >= sourceSize ? sourceSize - 1 : s);
+					}
+					out->source[(size_t)i * out->taps + t] = s;
+					out->weights[(size_t)i * out->taps + t] = weight;
+					sum += weight;
+				}
+				for (int t = 0; t < out->taps; t++) {
+					out->weights[(size_t)i * out->taps + t] /= sum;
+				}
+			}
+		}
+
+		// Separable resample of a float RGBA image. The vertical pass runs first: it streams whole rows, which is cheaper
+		// per tap than the horizontal pass's gathers, so it is the one that gets to work on the full size image. scratch
+		// holds the vertically filtered image.
+		inline void Resample(const float* source, int sourceWidth, int sourceHeight, float* dest, int destWidth, int destHeight,
+			const Settings& settings, std::vector<float>* scratch) {
+			AxisWeights columns, rows;
+			BuildAxisWeights(sourceWidth, destWidth, settings.filter, settings.wrapX, &columns);
+			BuildAxisWeights(sourceHeight, destHeight, settings.filter, settings.wrapY, &rows);
+
+			const size_t rowFloats = (size_t)sourceWidth * 4;
+			scratch->resize(rowFloats * destHeight);
+			for (int y = 0; y < destHeight; y++) {
+				float* shortRow = scratch->data() + y * rowFloats;
+				memset(shortRow, 0, rowFloats * sizeof(float));
+				for (int t = 0; t < rows.taps; t++) {
+					const float weight = rows.weights[(size_t)y * rows.taps + t];
+					if (weight == 0.0f) {
+						continue;
+					}
+					const float* sourceRow = source + rows.source[(size_t)y * rows.taps + t] * rowFloats;
+					size_t i = 0;
+#if RCE_MIP_SSE2
+					const __m128 w = _mm_set1_ps(weight);
+					for (; i < rowFloats; i += 4) {
+						_mm_storeu_ps(shortRow + i, _mm_add_ps(_mm_loadu_ps(shortRow + i), _mm_mul_ps(w, _mm_loadu_ps(sourceRow + i))));
+					}
+#endif
+					for (; i < rowFloats; i++) {
+						shortRow[i] += weight * sourceRow[i];
+					}
+				}
+
+				float* destRow = dest + (size_t)y * destWidth * 4;
+				for (int x = 0; x < destWidth; x++) {
+					const int* taps = columns.source.data() + (size_t)x * columns.taps;
+					const float* weights = columns.weights.data() + (size_t)x * columns.taps;
+#if RCE_MIP_SSE2
+					__m128 sum = _mm_setzero_ps();
+					for (int t = 0; t < columns.taps; t++) {
+						sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(weights[t]), _mm_loadu_ps(shortRow + taps[t] * 4)));
+					}
+					_mm_storeu_ps(destRow + x * 4, sum);
+#else
+					float sum[4] = {};
+					for (int t = 0; t < columns.taps; t++) {
+						for (int c = 0; c < 4; c++) {
+							sum[c] += weights[t] * shortRow[taps[t] * 4 + c];
+						}
+					}
+					memcpy(destRow + x * 4, sum, sizeof(sum));
+#endif
+				}
+			}
+		}
+
+		inline void DecodePixels(const uint8_t* rgba, size_t pixelCount, ColorSpace colorSpace, float* out) {
+			const ConversionTables& tables = GetConversionTables();
+			const float* color = tables.decode[(int)colorSpace];
+			const float* alpha = tables.decode[(int)ColorSpace::Linear];
+			for (size_t i = 0; i < pixelCount; i++) {
+				out[i * 4 + 0] = color[rgba[i * 4 + 0]];
+				out[i * 4 + 1] = color[rgba[i * 4 + 1]];
+				out[i * 4 + 2] = color[rgba[i * 4 + 2]];
+				out[i * 4 + 3] = alpha[rgba[i * 4 + 3]];
+			}
+		}
+
+		// Clamps to [0, 1], which also removes the Kaiser filter's over and undershoot
+		inline void EncodePixels(const float* pixels, size_t pixelCount, ColorSpace colorSpace, uint8_t* out) {
+			const uint8_t* srgbEncode = GetConversionTables().srgbEncode;
+			const float srgbScale = (float)((1 << SRGB_ENCODE_BITS) - 1);
+			const bool srgb = colorSpace == ColorSpace::SRGB;
+			size_t i = 0;
+#if RCE_MIP_SSE2
+			const __m128 zero = _mm_setzero_ps();
+			const __m128 one = _mm_set1_ps(1.0f);
+			const __m128 scale = srgb ? _mm_setr_ps(srgbScale, srgbScale, srgbScale, 255.0f) : _mm_set1_ps(255.0f);
+			for (; i < pixelCount; i++) {
+				__m128 clamped = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(pixels + i * 4), zero), one);
+				__m128i scaled = _mm_cvtps_epi32(_mm_mul_ps(clamped, scale));
+				if (srgb) {
+					int32_t lanes[4];
+					_mm_storeu_si128((__m128i*)lanes, scaled);
+					out[i * 4 + 0] = srgbEncode[lanes[0]];
+					out[i * 4 + 1] = srgbEncode[lanes[1]];
+					out[i * 4 + 2] = srgbEncode[lanes[2]];
+					out[i * 4 + 3] = (uint8_t)lanes[3];
+				}
+				else {
+					__m128i words = _mm_packs_epi32(scaled, scaled);
+					int32_t packed = _mm_cvtsi128_si32(_mm_packus_epi16(words, words));
+					memcpy(out + i * 4, &packed, 4);
+				}
+			}
+#endif
+			for (; i < pixelCount; i++) {
+				for (int c = 0; c < 4; c++) {
+					float value = pixels[i * 4 + c];
+					value = value < 0.0f ? 0.0f : (value > 1.0f ? 1.0f : value);
+					if (srgb && c < 3) {
+						out[i * 4 + c] = srgbEncode[(int)(value * srgbScale + 0.5f)];
+					}
+					else {
+						out[i * 4 + c] = (uint8_t)(value * 255.0f + 0.5f);
+					}
+				}
+			}
+		}
+
+		// Builds the full chain down to 1x1 from an RGBA8 image. Level 0 is the source as is, every further level is
+		// filtered from the one above it. Alpha is always treated as linear and is not premultiplied.
+		inline void GenerateMips(const uint8_t* rgba, int width, int height, const Settings& settings, MipChain* out) {
+			const int levelCount = MipLevelCount(width, height);
+			out->levels.resize(levelCount);
+			size_t totalBytes = 0;
+			for (int level = 0, w = width, h = height; level < levelCount; level++) {
+				out->levels[level] = { w, h, totalBytes };
+				totalBytes += (size_t)w * h * 4;
+				w = w > 1 ? w / 2 : 1;
+				h = h > 1 ? h / 2 : 1;
+			}
+			out->pixels.resize(totalBytes);
+			memcpy(out->pixels.data(), rgba, (size_t)width * height * 4);
+
+			std::vector<float> current((size_t)width * height * 4);
+			std::vector<float> next;
+			std::vector<float> scratch;
+			DecodePixels(rgba, (size_t)width * height, settings.colorSpace, current.data());
+
+			for (int level = 1; level < levelCount; level++) {
+				const MipLevel& above = out->levels[level - 1];
+				const MipLevel& mip = out->levels[level];
+				next.resize((size_t)mip.width * mip.height * 4);
+				Resample(current.data(), above.width, above.height, next.data(), mip.width, mip.height, settings, &scratch);
+				EncodePixels(next.data(), (size_t)mip.width * mip.height, settings.colorSpace, out->pixels.data() + mip.offset);
+				current.swap(next);
+			}
+		}
+	}
+}
@@ -0,0 +1,71 @@
+#pragma once
+#include "rce_upload_ring.h"
+#include "rce_upload_scheduler.h"
+
+#include <algorithm>
+#include <functional>
+#include <stdint.h>
+
+namespace RCE {
+	namespace Upload {
+		// The heaps and resource states creating a static buffer goes through, stand-ins for D3D12_HEAP_TYPE and
+		// D3D12_RESOURCE_STATES
+		enum class BufferHeap {
+			Default, // GPU memory, filled by a copy
+			Upload,  // CPU-visible, written through a mapping and read across the bus
+		};
+
+		enum class BufferState {
+			Common,
+			CopyDest,
+			GenericRead,
+		};
+
+		// Staging alignment of buffer copies
+		constexpr uint64_t STATIC_BUFFER_ALIGNMENT = 16;
+
+		// The device and copy queue calls CreateStaticBuffer records with. main.cpp forwards them to D3D12, the tests record
+		// them. Buffers are opaque, whatever createBuffer returns is passed back.
+		struct StaticBufferDevice {
+			std::function<void*(BufferHeap heap, uint64_t size, BufferState initialState)> createBuffer;
+			// Maps an upload heap buffer, copies data into it and unmaps it
+			std::function<void(void* buffer, const void* data, uint64_t size)> writeBuffer;
+			// Copies data into the staging memory the ring hands out offsets of
+			std::function<void(uint64_t stagingOffset, const void* data, uint64_t size)> writeStaging;
+			// Records a copy from the staging memory, opening a copy batch on scheduler if none is open
+			std::function<void(void* buffer, uint64_t stagingOffset, uint64_t size)> copyFromStaging;
+			std::function<void(void* buffer, BufferState before, BufferState after)> barrier;
+		};
+
+		// Creates a buffer the GPU only reads, for vertex and index data, and returns it.
+		//
+		// In the default heap the data is staged in ring and copied in the open copy batch; readyFenceValue is raised to
+		// the copy fence value it is in place at, and the staging memory retires with that batch. The buffer is created
+		// in the common state and the copy promotes it to COPY_DEST. The barrier after the copy takes it back to COMMON,
+		// the only read state a copy queue can leave it in. From there the direct queue promotes it to whatever read
+		// state a draw needs, no barrier is needed for buffers.
+		//
+		// Returns nullptr without creating anything when ring has no room for size bytes until more submissions retire.
+		//
+		// In the upload heap the buffer is created readable and written through its mapping right away.
+		inline void* CreateStaticBuffer(const StaticBufferDevice& device, BufferHeap heap, const void* data, uint64_t size,
+			UploadRing* ring, UploadScheduler* scheduler, uint64_t* readyFenceValue) {
+			if (heap == BufferHeap::Upload) {
+				void* buffer = device.createBuffer(heap, size, BufferState::GenericRead);
+				device.writeBuffer(buffer, data, size);
+				return buffer;
+			}
+
+			const uint64_t stagingOffset = Allocate(ring, size, STATIC_BUFFER_ALIGNMENT);
+			if (stagingOffset == INVALID_OFFSET) {
+				return nullptr;
+			}
+			void* buffer = device.createBuffer(heap, size, BufferState::Common);
+			device.writeStaging(stagingOffset, data, size);
+			device.copyFromStaging(buffer, stagingOffset, size);
+			device.barrier(buffer, BufferState::CopyDest, BufferState::Common);
+			*readyFenceValue = std::max(*readyFenceValue, RecordCopy(scheduler, size));
+			return buffer;
+		}
+	}
+}
@@ -0,0 +1,240 @@
+#pragma once
+#include "rce_block_compress.h"
+#include "rce_mapped_file.h"
+#include "rce_mip.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+
+namespace RCE {
+	namespace TextureCache {
+		// Cooked texture container: every mip level already filtered, compressed and laid out the way it is copied to the
+		// GPU, so loading is a mapping and one memcpy into the upload buffer.
+		//
+		// File layout: Header, the LevelEntry table, then the level data at Header::dataOffset. Levels start on
+		// LEVEL_ALIGNMENT and their rows are ROW_PITCH_ALIGNMENT apart, the same as D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT
+		// and D3D12_TEXTURE_DATA_PITCH_ALIGNMENT, which makes the data section identical to what GetCopyableFootprints
+		// asks for. Header's checksum covers everything after the header.
+		constexpr uint32_t MAGIC = 'R' | ('C' << 8) | ('E' << 16) | ('T' << 24);
+		constexpr uint32_t VERSION = 1;
+		constexpr uint64_t LEVEL_ALIGNMENT = 512;
+		constexpr uint64_t ROW_PITCH_ALIGNMENT = 256;
+
+		using File::LoadResult;
+		using File::LoadResultName;
+
+		enum PixelFormat : uint32_t {
+			PIXEL_FORMAT_RGBA8,
+			PIXEL_FORMAT_BC1,
+			PIXEL_FORMAT_BC3,
+			PIXEL_FORMAT_BC4,
+			PIXEL_FORMAT_BC5,
+			PIXEL_FORMAT_BC7,
+			PIXEL_FORMAT_COUNT,
+		};
+
+		inline PixelFormat PixelFormatOf(BlockCompress::BlockFormat format) {
+			return (PixelFormat)(PIXEL_FORMAT_BC1 + (int)format);
+		}
+
+		// Rows are rows of 4x4 blocks for the compressed formats
+		inline uint32_t RowBytes(uint32_t pixelFormat, int width) {
+			if (pixelFormat == PIXEL_FORMAT_RGBA8) {
+				return (uint32_t)width * 4;
+			}
+			return (uint32_t)BlockCompress::RowPitch((BlockCompress::BlockFormat)(pixelFormat - PIXEL_FORMAT_BC1), width);
+		}
+
+		inline uint32_t RowCount(uint32_t pixelFormat, int height) {
+			return pixelFormat == PIXEL_FORMAT_RGBA8 ? (uint32_t)height : (uint32_t)BlockCompress::BlocksAcross(height);
+		}
+
+		// offset is relative to the data section, size runs to the end of the last row without its padding
+		struct LevelEntry {
+			uint32_t width;
+			uint32_t height;
+			uint32_t rowCount;
+			uint32_t rowBytes;
+			uint32_t rowPitch;
+			uint32_t reserved;
+			uint64_t offset;
+			uint64_t size;
+		};
+
+		struct Header {
+			uint32_t magic;
+			uint32_t version;
+			uint64_t sourceKey; // whatever identifies the inputs, a different key means the file is stale
+			uint64_t checksum;
+			uint32_t pixelFormat;
+			uint32_t width;
+			uint32_t height;
+			uint32_t levelCount;
+			uint64_t dataOffset;
+			uint64_t dataSize;
+		};
+
+		static_assert(sizeof(LevelEntry) == 40, "LevelEntry is stored as is");
+		static_assert(sizeof(Header) == 56, "Header is stored as is");
+
+		// Texture data wherever it lives, in a mapped cache file or in TextureArrays
+		struct TextureView {
+			uint32_t pixelFormat;
+			int width;
+			int height;
+			const LevelEntry* levels;
+			size_t levelCount;
+			const uint8_t* data;
+			size_t dataSize;
+		};
+
+		// Owning storage for a texture cooked at runtime
+		struct TextureArrays {
+			uint32_t pixelFormat;
+			int width;
+			int height;
+			std::vector<LevelEntry> levels;
+			std::vector<uint8_t> data;
+		};
+
+		inline uint64_t Align(uint64_t offset, uint64_t alignment) {
+			return (offset + alignment - 1) & ~(alignment - 1);
+		}
+
+		// Copies tightly packed levels, as GenerateMips and CompressMips store them, into the padded cache layout
+		inline void PackLevels(uint32_t pixelFormat, const Mip::MipLevel* levels, size_t levelCount, const uint8_t* source,
+			TextureArrays* out) {
+			out->pixelFormat = pixelFormat;
+			out->width = levels[0].width;
+			out->height = levels[0].height;
+			out->levels.resize(levelCount);
+			uint64_t offset = 0;
+			for (size_t i = 0; i < levelCount; i++) {
+				LevelEntry& level = out->levels[i];
+				level = {};
+				level.width = (uint32_t)levels[i].width;
+				level.height = (uint32_t)levels[i].height;
+				level.rowCount = RowCount(pixelFormat, levels[i].height);
+				level.rowBytes = RowBytes(pixelFormat, levels[i].width);
+				level.rowPitch = (uint32_t)Align(level.rowBytes, ROW_PITCH_ALIGNMENT);
+				level.offset = Align(offset, LEVEL_ALIGNMENT);
+				level.size = (uint64_t)level.rowPitch * (level.rowCount - 1) + level.rowBytes;
+				offset = level.offset + level.size;
+			}
+
+			out->data.assign(offset, 0);
+			for (size_t i = 0; i < levelCount; i++) {
+				const LevelEntry& level = out->levels[i];
+				for (uint32_t row = 0; row < level.rowCount; row++) {
+					memcpy(out->data.data() + level.offset + (uint64_t)row * level.rowPitch,
+						source + levels[i].offset + (size_t)row * level.rowBytes, level.rowBytes);
+				}
+			}
+		}
+
+		inline TextureView ViewOf(const TextureArrays& arrays) {
+			TextureView view = {};
+			view.pixelFormat = arrays.pixelFormat;
+			view.width = arrays.width;
+			view.height = arrays.height;
+			view.levels = arrays.levels.data();
+			view.levelCount = arrays.levels.size();
+			view.data = arrays.data.data();
+			view.dataSize = arrays.data.size();
+			return view;
+		}
+
+		inline bool WriteTextureCache(const char* path, const TextureView& texture, uint64_t sourceKey) {
+			Header header = {};
+			header.magic = MAGIC;
+			header.version = VERSION;
+			header.sourceKey = sourceKey;
+			header.pixelFormat = texture.pixelFormat;
+			header.width = (uint32_t)texture.width;
+			header.height = (uint32_t)texture.height;
+			header.levelCount = (uint32_t)texture.levelCount;
+			const uint64_t tableSize = texture.levelCount * sizeof(LevelEntry);
+			header.dataOffset = Align(sizeof(Header) + tableSize, LEVEL_ALIGNMENT);
+			header.dataSize = texture.dataSize;
+
+			// Assembled in memory first so the checksum can go into the header
+			std::vector<uint8_t> file(header.dataOffset + header.dataSize, 0);
+			memcpy(file.data() + sizeof(Header), texture.levels, tableSize);
+			memcpy(file.data() + header.dataOffset, texture.data, texture.dataSize);
+			header.checksum = File::Checksum64(file.data() + sizeof(Header), file.size() - sizeof(Header));
+			memcpy(file.data(), &header, sizeof(Header));
+
+			FILE* out = fopen(path, "wb");
+			if (out == nullptr) {
+				return false;
+			}
+			bool written = fwrite(file.data(), 1, file.size(), out) == file.size();
+			written = fclose(out) == 0 && written;
+			if (!written) {
+				remove(path);
+			}
+			return written;
+		}
+
+		// Points out into the mapped file, so it stays valid until the file is closed. The level table is checked against
+		// the format, the mip chain of the header's size and the data section, a corrupted file fails to load instead of
+		// reading out of bounds or describing levels the GPU texture doesn't have.
+		inline LoadResult LoadTextureCache(const File::MappedFile& file, uint64_t sourceKey, TextureView* out,
+			bool verifyChecksum = true) {
+			if (file.data == nullptr || file.size < sizeof(Header)) {
+				return LoadResult::Invalid;
+			}
+			Header header;
+			memcpy(&header, file.data, sizeof(Header));
+			if (header.magic != MAGIC) {
+				return LoadResult::Invalid;
+			}
+			if (header.version != VERSION) {
+				return LoadResult::WrongVersion;
+			}
+			if (header.sourceKey != sourceKey) {
+				return LoadResult::Stale;
+			}
+			if (header.pixelFormat >= PIXEL_FORMAT_COUNT || header.width == 0 || header.height == 0 ||
+				header.width > INT32_MAX || header.height > INT32_MAX || header.levelCount == 0 ||
+				header.levelCount > (uint32_t)Mip::MipLevelCount((int)header.width, (int)header.height) ||
+				header.dataOffset % LEVEL_ALIGNMENT != 0 ||
+				header.dataOffset < sizeof(Header) + header.levelCount * sizeof(LevelEntry) || header.dataOffset > file.size ||
+				header.dataSize > file.size - header.dataOffset) {
+				return LoadResult::Invalid;
+			}
+
+			// Level i is the header's size halved i times, as GenerateMips builds it
+			const LevelEntry* levels = (const LevelEntry*)(file.data + sizeof(Header));
+			for (uint32_t i = 0; i < header.levelCount; i++) {
+				const LevelEntry& level = levels[i];
+				const uint32_t width = header.width >> i > 1 ? header.width >> i : 1;
+				const uint32_t height = header.height >> i > 1 ? header.height >> i : 1;
+				if (level.width != width || level.height != height ||
+					level.rowCount != RowCount(header.pixelFormat, level.height) ||
+					level.rowBytes != RowBytes(header.pixelFormat, level.width) || level.rowPitch < level.rowBytes ||
+					level.size != (uint64_t)level.rowPitch * (level.rowCount - 1) + level.rowBytes ||
+					level.offset > header.dataSize || level.size > header.dataSize - level.offset) {
+					return LoadResult::Invalid;
+				}
+			}
+			if (verifyChecksum &&
+				File::Checksum64(file.data + sizeof(Header), file.size - sizeof(Header)) != header.checksum) {
+				return LoadResult::ChecksumMismatch;
+			}
+
+			TextureView view = {};
+			view.pixelFormat = header.pixelFormat;
+			view.width = (int)header.width;
+			view.height = (int)header.height;
+			view.levels = levels;
+			view.levelCount = header.levelCount;
+			view.data = file.data + header.dataOffset;
+			view.dataSize = (size_t)header.dataSize;
+			*out = view;
+			return LoadResult::Ok;
+		}
+	}
+}
@@ -0,0 +1,112 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define RCE_UPLOAD_SSE2 1
+#include <emmintrin.h>
+#else
+#define RCE_UPLOAD_SSE2 0
+#endif
+
+namespace RCE {
+	namespace Upload {
+		// Copies into write-combined memory, such as a mapped D3D12_HEAP_TYPE_UPLOAD buffer, with non-temporal stores. They
+		// fill whole write-combining lines without reading the destination and keep the copied data out of the cache,
+		// where it would only evict the data the CPU is still working on. Never read back from dest.
+		//
+		// The stores are weakly ordered, call StreamFence after the last copy and before the GPU is told to read.
+		inline void StreamCopyUnfenced(void* dest, const void* source, size_t size) {
+			uint8_t* d = (uint8_t*)dest;
+			const uint8_t* s = (const uint8_t*)source;
+#if RCE_UPLOAD_SSE2
+			// Streaming stores need 16-byte aligned destinations, the head before that is copied normally
+			size_t head = (16 - ((uintptr_t)d & 15)) & 15;
+			if (head > size) {
+				head = size;
+			}
+			memcpy(d, s, head);
+			d += head;
+			s += head;
+			size -= head;
+
+			// 64 bytes per iteration, one write-combining buffer
+			for (; size >= 64; size -= 64, d += 64, s += 64) {
+				__m128i a = _mm_loadu_si128((const __m128i*)s);
+				__m128i b = _mm_loadu_si128((const __m128i*)(s + 16));
+				__m128i c = _mm_loadu_si128((const __m128i*)(s + 32));
+				__m128i e = _mm_loadu_si128((const __m128i*)(s + 48));
+				_mm_stream_si128((__m128i*)d, a);
+				_mm_stream_si128((__m128i*)(d + 16), b);
+				_mm_stream_si128((__m128i*)(d + 32), c);
+				_mm_stream_si128((__m128i*)(d + 48), e);
+			}
+			for (; size >= 16; size -= 16, d += 16, s += 16) {
+				_mm_stream_si128((__m128i*)d, _mm_loadu_si128((const __m128i*)s));
+			}
+			memcpy(d, s, size);
+#else
+			memcpy(d, s, size);
+#endif
+		}
+
+		inline void StreamFence() {
+#if RCE_UPLOAD_SSE2
+			_mm_sfence();
+#endif
+		}
+
+		inline void StreamCopy(void* dest, const void* source, size_t size) {
+			StreamCopyUnfenced(dest, source, size);
+			StreamFence();
+		}
+
+		// One subresource footprint: depth slices of rowCount rows, rowBytes each. The destination rows are destRowPitch
+		// apart and the slices destRowPitch * rowCount apart, the way D3D12_PLACED_SUBRESOURCE_FOOTPRINT lays them out;
+		// the source uses its own pitches.
+		struct SubresourceCopy {
+			uint64_t destOffset;
+			uint64_t destRowPitch;
+			const uint8_t* source;
+			uint64_t sourceRowPitch;
+			uint64_t sourceSlicePitch;
+			uint64_t rowBytes;
+			uint32_t rowCount;
+			uint32_t depth;
+		};
+
+		// Whole slices collapse into one copy when neither side pads its rows. Does not fence, see StreamCopyUnfenced.
+		inline void CopySubresource(uint8_t* dest, const SubresourceCopy& copy, bool streaming = true) {
+			auto copyBytes = [streaming](uint8_t* d, const uint8_t* s, size_t size) {
+				if (streaming) {
+					StreamCopyUnfenced(d, s, size);
+				}
+				else {
+					memcpy(d, s, size);
+				}
+			};
+
+			const uint64_t destSlicePitch = copy.destRowPitch * copy.rowCount;
+			const bool packed = copy.destRowPitch == copy.rowBytes && copy.sourceRowPitch == copy.rowBytes;
+			for (uint32_t z = 0; z < copy.depth; z++) {
+				uint8_t* destSlice = dest + copy.destOffset + z * destSlicePitch;
+				const uint8_t* sourceSlice = copy.source + z * copy.sourceSlicePitch;
+				if (packed) {
+					copyBytes(destSlice, sourceSlice, (size_t)(copy.rowBytes * copy.rowCount));
+					continue;
+				}
+				for (uint32_t row = 0; row < copy.rowCount; row++) {
+					copyBytes(destSlice + row * copy.destRowPitch, sourceSlice + row * copy.sourceRowPitch, (size_t)copy.rowBytes);
+				}
+			}
+		}
+
+		inline void CopySubresources(uint8_t* dest, const SubresourceCopy* copies, size_t count, bool streaming = true) {
+			for (size_t i = 0; i < count; i++) {
+				CopySubresource(dest, copies[i], streaming);
+			}
+			StreamFence();
+		}
+	}
+}
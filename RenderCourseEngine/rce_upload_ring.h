@@ -0,0 +1,87 @@
+#pragma once
+#include <deque>
+#include <mutex>
+#include <stdint.h>
+
+namespace RCE {
+	namespace Upload {
+		constexpr uint64_t INVALID_OFFSET = ~0ull;
+
+		// Linear allocator over one ring buffer, for staging memory the GPU reads once. Allocations are carved from head in
+		// order; each submission that used them is closed with FinishSubmission, and its memory is handed back by Retire
+		// once the GPU has passed the submission's fence value. Head and tail count bytes since creation, so their
+		// difference is the memory in use whether or not head has wrapped.
+		//
+		// Only offsets are handed out, the ring does not own the memory it manages. All functions lock, so any thread can
+		// allocate while another retires.
+		struct UploadRing {
+			uint64_t capacity;
+			uint64_t head;
+			uint64_t tail;
+
+			// Where head stood at the end of every submission that has not been retired yet, oldest first
+			struct Submission {
+				uint64_t fenceValue;
+				uint64_t head;
+			};
+			std::deque<Submission> submissions;
+			std::mutex mutex;
+		};
+
+		inline void InitUploadRing(UploadRing* ring, uint64_t capacity) {
+			std::lock_guard<std::mutex> lock(ring->mutex);
+			ring->capacity = capacity;
+			ring->head = 0;
+			ring->tail = 0;
+			ring->submissions.clear();
+		}
+
+		// Returns the offset of size bytes aligned to alignment (a power of two), or INVALID_OFFSET when that much is not
+		// free until more submissions retire. An allocation never wraps: if it does not fit before the end of the buffer
+		// the rest of the buffer is skipped and it starts over at offset 0.
+		inline uint64_t Allocate(UploadRing* ring, uint64_t size, uint64_t alignment) {
+			std::lock_guard<std::mutex> lock(ring->mutex);
+			// An empty ring starts over at offset 0, so nothing has to be skipped
+			if (ring->head == ring->tail && ring->head % ring->capacity != 0) {
+				ring->head += ring->capacity - ring->head % ring->capacity;
+				ring->tail = ring->head;
+			}
+			uint64_t offset = (ring->head % ring->capacity + alignment - 1) & ~(alignment - 1);
+			uint64_t skipped = offset - ring->head % ring->capacity;
+			if (offset + size > ring->capacity) {
+				skipped = ring->capacity - ring->head % ring->capacity;
+				offset = 0;
+			}
+			if (ring->head + skipped + size - ring->tail > ring->capacity) {
+				return INVALID_OFFSET;
+			}
+			ring->head += skipped + size;
+			return offset;
+		}
+
+		// Everything allocated since the previous call belongs to the submission that signals fenceValue. Fence values
+		// have to increase from one call to the next.
+		inline void FinishSubmission(UploadRing* ring, uint64_t fenceValue) {
+			std::lock_guard<std::mutex> lock(ring->mutex);
+			uint64_t lastHead = ring->submissions.empty() ? ring->tail : ring->submissions.back().head;
+			if (lastHead == ring->head) {
+				return;
+			}
+			ring->submissions.push_back({ fenceValue, ring->head });
+		}
+
+		// Frees the memory of every submission whose fence value the GPU has reached
+		inline void Retire(UploadRing* ring, uint64_t completedFenceValue) {
+			std::lock_guard<std::mutex> lock(ring->mutex);
+			while (!ring->submissions.empty() && ring->submissions.front().fenceValue <= completedFenceValue) {
+				ring->tail = ring->submissions.front().head;
+				ring->submissions.pop_front();
+			}
+		}
+
+		inline uint64_t BytesInUse(UploadRing* ring) {
+			std::lock_guard<std::mutex> lock(ring->mutex);
+			return ring->head - ring->tail;
+		}
+	}
+}
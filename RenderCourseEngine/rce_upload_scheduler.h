@@ -0,0 +1,94 @@
+#pragma once
+#include <assert.h>
+#include <stdint.h>
+#include <vector>
+
+namespace RCE {
+	namespace Upload {
+		// Bookkeeping for a copy queue that uploads in batches: which command allocator a batch records into, when it is
+		// worth submitting, and which fence value marks a copy as done. Knows nothing about the queue itself, the caller
+		// does the recording, submitting and signalling the values it hands out.
+		//
+		// Fence values start at 1 and go up by one per batch. A batch records into allocator (batch - 1) % allocatorCount,
+		// so an allocator can be reset once the batch that used it last has completed. The queue that consumes the uploads
+		// waits on the copy fence, WaitNeeded keeps it from waiting on the same value twice. Not thread safe.
+		struct UploadScheduler {
+			uint64_t batchBytes; // a batch is submitted once it holds this much, even if more copies are coming
+			std::vector<uint64_t> allocatorFence; // the fence value each allocator was last submitted with, 0 if never
+
+			int allocator; // of the open batch, -1 while none is open
+			uint64_t recordedBytes;
+			int recordedCount;
+
+			uint64_t lastSubmitted;
+			uint64_t lastWaited;
+			uint64_t totalBytes;
+		};
+
+		inline void InitUploadScheduler(UploadScheduler* scheduler, int allocatorCount, uint64_t batchBytes) {
+			scheduler->batchBytes = batchBytes;
+			scheduler->allocatorFence.assign(allocatorCount, 0);
+			scheduler->allocator = -1;
+			scheduler->recordedBytes = 0;
+			scheduler->recordedCount = 0;
+			scheduler->lastSubmitted = 0;
+			scheduler->lastWaited = 0;
+			scheduler->totalBytes = 0;
+		}
+
+		inline bool BatchOpen(const UploadScheduler* scheduler) {
+			return scheduler->allocator >= 0;
+		}
+
+		// Opens the next batch and returns the allocator to record it into. The allocator may only be reset once the copy
+		// fence has reached *waitFenceValue.
+		inline int BeginBatch(UploadScheduler* scheduler, uint64_t* waitFenceValue) {
+			assert(!BatchOpen(scheduler));
+			scheduler->allocator = (int)(scheduler->lastSubmitted % scheduler->allocatorFence.size());
+			scheduler->recordedBytes = 0;
+			scheduler->recordedCount = 0;
+			*waitFenceValue = scheduler->allocatorFence[scheduler->allocator];
+			return scheduler->allocator;
+		}
+
+		// True when the allocator the next batch records into is free, the copy fence having reached completedFenceValue.
+		// BeginBatch hands it out either way, callers that must not wait for the GPU check this first.
+		inline bool NextBatchReady(const UploadScheduler* scheduler, uint64_t completedFenceValue) {
+			return scheduler->allocatorFence[scheduler->lastSubmitted % scheduler->allocatorFence.size()] <= completedFenceValue;
+		}
+
+		// Adds a copy to the open batch and returns the fence value the copy is done at
+		inline uint64_t RecordCopy(UploadScheduler* scheduler, uint64_t bytes) {
+			assert(BatchOpen(scheduler));
+			scheduler->recordedBytes += bytes;
+			scheduler->recordedCount++;
+			scheduler->totalBytes += bytes;
+			return scheduler->lastSubmitted + 1;
+		}
+
+		// flush submits whatever is recorded, otherwise a batch waits until it holds batchBytes
+		inline bool ShouldSubmit(const UploadScheduler* scheduler, bool flush) {
+			return BatchOpen(scheduler) && scheduler->recordedCount > 0 &&
+				(flush || scheduler->recordedBytes >= scheduler->batchBytes);
+		}
+
+		// Closes the open batch and returns the fence value to signal after submitting it
+		inline uint64_t EndBatch(UploadScheduler* scheduler) {
+			assert(BatchOpen(scheduler));
+			scheduler->lastSubmitted++;
+			scheduler->allocatorFence[scheduler->allocator] = scheduler->lastSubmitted;
+			scheduler->allocator = -1;
+			return scheduler->lastSubmitted;
+		}
+
+		// True when the consuming queue has not waited for fenceValue or a later value yet; it is counted as waited for
+		inline bool WaitNeeded(UploadScheduler* scheduler, uint64_t fenceValue) {
+			if (fenceValue <= scheduler->lastWaited) {
+				return false;
+			}
+			assert(fenceValue <= scheduler->lastSubmitted);
+			scheduler->lastWaited = fenceValue;
+			return true;
+		}
+	}
+}
@@ -0,0 +1,343 @@
+#pragma once
+#include <SBLMath/Vector3.hpp>
+
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define RCE_VERTEX_SSE2 1
+#include <emmintrin.h>
+#else
+#define RCE_VERTEX_SSE2 0
+#endif
+
+namespace RCE {
+	namespace VertexFormat {
+		using namespace SBL::Math;
+
+		struct Vertex {
+			Vector3 position;	// position
+			float u, v; // texcoord
+			Vector3 normals; // normals
+		};
+
+		// 16 byte vertex, half the size of Vertex. Matches the PACKED_VERTEX input layout in SimpleShader.vs:
+		//   position: R16G16B16A16_FLOAT, w is always 1
+		//   uv:       R16G16_UNORM, so texcoords must stay inside [0, 1]
+		//   normal:   R16G16_SNORM, octahedral encoded
+		struct PackedVertex {
+			uint16_t position[4];
+			uint16_t uv[2];
+			int16_t normal[2];
+		};
+		static_assert(sizeof(PackedVertex) == 16, "PackedVertex must stay 16 bytes");
+
+		// Round-to-nearest-even float to half conversion. Values too large for a half become infinity.
+		inline uint16_t FloatToHalf(float value) {
+			uint32_t bits;
+			memcpy(&bits, &value, sizeof(bits));
+			uint32_t sign = (bits >> 16) & 0x8000u;
+			uint32_t absBits = bits & 0x7fffffffu;
+
+			if (absBits >= 0x7f800000u) { // inf or NaN
+				return (uint16_t)(sign | 0x7c00u | (absBits > 0x7f800000u ? 0x200u : 0u));
+			}
+			if (absBits >= 0x477ff000u) { // rounds past the largest half
+				return (uint16_t)(sign | 0x7c00u);
+			}
+			if (absBits < 0x38800000u) { // half denormal or zero
+				float absValue;
+				memcpy(&absValue, &absBits, sizeof(absValue));
+				// Adding 0.5 pushes the denormal bits to the bottom of the mantissa and lets the FPU round
+				float shifted = absValue + 0.5f;
+				uint32_t shiftedBits;
+				memcpy(&shiftedBits, &shifted, sizeof(shiftedBits));
+				return (uint16_t)(sign | (shiftedBits - 0x3f000000u));
+			}
+			uint32_t mantissaOdd = (absBits >> 13) & 1u;
+			absBits += 0xc8000fffu + mantissaOdd; // rebias exponent by -112 and round
+			return (uint16_t)(sign | (absBits >> 13));
+		}
+
+		inline float HalfToFloat(uint16_t half) {
+			uint32_t sign = (uint32_t)(half & 0x8000u) << 16;
+			uint32_t exponent = (half >> 10) & 0x1fu;
+			uint32_t mantissa = half & 0x3ffu;
+			uint32_t bits;
+			if (exponent == 0x1f) {
+				bits = sign | 0x7f800000u | (mantissa << 13);
+			}
+			else if (exponent == 0) {
+				float value = mantissa * (1.0f / 16777216.0f); // 2^-24
+				memcpy(&bits, &value, sizeof(bits));
+				bits |= sign;
+			}
+			else {
+				bits = sign | ((exponent + 112) << 23) | (mantissa << 13);
+			}
+			float result;
+			memcpy(&result, &bits, sizeof(result));
+			return result;
+		}
+
+		inline int16_t FloatToSnorm16(float value) {
+			value = value < -1.0f ? -1.0f : (value > 1.0f ? 1.0f : value);
+			return (int16_t)(value * 32767.0f + (value < 0.0f ? -0.5f : 0.5f));
+		}
+
+		inline uint16_t FloatToUnorm16(float value) {
+			value = value < 0.0f ? 0.0f : (value > 1.0f ? 1.0f : value);
+			return (uint16_t)(value * 65535.0f + 0.5f);
+		}
+
+		// Projects a unit normal onto the octahedron |x| + |y| + |z| = 1 and folds the lower half over the upper one.
+		inline void OctahedralEncode(const Vector3& normal, float& outX, float& outY) {
+			float invL1 = 1.0f / (fabsf(normal.x) + fabsf(normal.y) + fabsf(normal.z));
+			float x = normal.x * invL1;
+			float y = normal.y * invL1;
+			if (normal.z < 0.0f) {
+				float foldedX = (1.0f - fabsf(y)) * (x >= 0.0f ? 1.0f : -1.0f);
+				float foldedY = (1.0f - fabsf(x)) * (y >= 0.0f ? 1.0f : -1.0f);
+				x = foldedX;
+				y = foldedY;
+			}
+			outX = x;
+			outY = y;
+		}
+
+		inline Vector3 OctahedralDecode(float x, float y) {
+			Vector3 normal = Vector3(x, y, 1.0f - fabsf(x) - fabsf(y));
+			float t = normal.z < 0.0f ? -normal.z : 0.0f;
+			normal.x += normal.x >= 0.0f ? -t : t;
+			normal.y += normal.y >= 0.0f ? -t : t;
+			return Normalized(normal);
+		}
+
+		inline PackedVertex EncodeVertex(const Vertex& vertex) {
+			PackedVertex packed;
+			packed.position[0] = FloatToHalf(vertex.position.x);
+			packed.position[1] = FloatToHalf(vertex.position.y);
+			packed.position[2] = FloatToHalf(vertex.position.z);
+			packed.position[3] = FloatToHalf(1.0f);
+			packed.uv[0] = FloatToUnorm16(vertex.u);
+			packed.uv[1] = FloatToUnorm16(vertex.v);
+			float octX, octY;
+			OctahedralEncode(vertex.normals, octX, octY);
+			packed.normal[0] = FloatToSnorm16(octX);
+			packed.normal[1] = FloatToSnorm16(octY);
+			return packed;
+		}
+
+		inline Vertex DecodeVertex(const PackedVertex& packed) {
+			Vertex vertex;
+			vertex.position = Vector3(HalfToFloat(packed.position[0]), HalfToFloat(packed.position[1]), HalfToFloat(packed.position[2]));
+			vertex.u = packed.uv[0] / 65535.0f;
+			vertex.v = packed.uv[1] / 65535.0f;
+			float octX = packed.normal[0] < -32767 ? -1.0f : packed.normal[0] / 32767.0f;
+			float octY = packed.normal[1] < -32767 ? -1.0f : packed.normal[1] / 32767.0f;
+			vertex.normals = OctahedralDecode(octX, octY);
+			return vertex;
+		}
+
+#if RCE_VERTEX_SSE2
+		// Four-wide FloatToHalf, bit-exact with the scalar version.
+		inline __m128i FloatToHalf4(__m128 value) {
+			const __m128i signMask = _mm_set1_epi32((int)0x80000000u);
+			__m128i bits = _mm_castps_si128(value);
+			__m128i sign = _mm_srli_epi32(_mm_and_si128(bits, signMask), 16);
+			__m128i absBits = _mm_andnot_si128(signMask, bits);
+
+			__m128i mantissaOdd = _mm_and_si128(_mm_srli_epi32(absBits, 13), _mm_set1_epi32(1));
+			__m128i rounded = _mm_add_epi32(_mm_add_epi32(absBits, _mm_set1_epi32((int)0xc8000fffu)), mantissaOdd);
+			__m128i half = _mm_srli_epi32(rounded, 13);
+
+			__m128i tooSmall = _mm_cmplt_epi32(absBits, _mm_set1_epi32(0x38800000));
+			__m128i tooLarge = _mm_cmpgt_epi32(absBits, _mm_set1_epi32(0x477fefff));
+			__m128i isNaN = _mm_cmpgt_epi32(absBits, _mm_set1_epi32(0x7f800000));
+			__m128 denormalShifted = _mm_add_ps(_mm_castsi128_ps(absBits), _mm_set1_ps(0.5f));
+			__m128i denormal = _mm_sub_epi32(_mm_castps_si128(denormalShifted), _mm_set1_epi32(0x3f000000));
+			half = _mm_or_si128(_mm_andnot_si128(tooSmall, half), _mm_and_si128(tooSmall, denormal));
+			half = _mm_or_si128(_mm_andnot_si128(tooLarge, half), _mm_and_si128(tooLarge, _mm_set1_epi32(0x7c00)));
+			half = _mm_or_si128(half, _mm_and_si128(isNaN, _mm_set1_epi32(0x200)));
+			return _mm_or_si128(half, sign);
+		}
+
+		inline __m128 Clamp4(__m128 value, float minValue, float maxValue) {
+			return _mm_min_ps(_mm_max_ps(value, _mm_set1_ps(minValue)), _mm_set1_ps(maxValue));
+		}
+
+		// Round-half-away-from-zero to match the scalar FloatToSnorm16 / FloatToUnorm16
+		inline __m128i RoundScaled4(__m128 value, float scale) {
+			__m128 scaled = _mm_mul_ps(value, _mm_set1_ps(scale));
+			__m128 half = _mm_or_ps(_mm_set1_ps(0.5f), _mm_and_ps(scaled, _mm_set1_ps(-0.0f)));
+			return _mm_cvttps_epi32(_mm_add_ps(scaled, half));
+		}
+
+		// Low 16 bits of lo and hi combined into one 32-bit word per lane
+		inline __m128i Pack16Pairs(__m128i lo, __m128i hi) {
+			return _mm_or_si128(_mm_and_si128(lo, _mm_set1_epi32(0xffff)), _mm_slli_epi32(hi, 16));
+		}
+
+		// Four-wide HalfToFloat on halves in the low 16 bits of each lane, bit-exact with the scalar version
+		inline __m128 HalfToFloat4(__m128i half) {
+			__m128i sign = _mm_slli_epi32(_mm_and_si128(half, _mm_set1_epi32(0x8000)), 16);
+			__m128i exponent = _mm_and_si128(_mm_srli_epi32(half, 10), _mm_set1_epi32(0x1f));
+			__m128i mantissa = _mm_slli_epi32(_mm_and_si128(half, _mm_set1_epi32(0x3ff)), 13);
+
+			__m128i normal = _mm_or_si128(_mm_slli_epi32(_mm_add_epi32(exponent, _mm_set1_epi32(112)), 23), mantissa);
+			__m128i infOrNaN = _mm_or_si128(_mm_set1_epi32(0x7f800000), mantissa);
+			__m128i denormal = _mm_castps_si128(_mm_mul_ps(_mm_cvtepi32_ps(_mm_srli_epi32(mantissa, 13)),
+				_mm_set1_ps(1.0f / 16777216.0f)));
+
+			__m128i isInfOrNaN = _mm_cmpeq_epi32(exponent, _mm_set1_epi32(0x1f));
+			__m128i isDenormal = _mm_cmpeq_epi32(exponent, _mm_setzero_si128());
+			__m128i bits = _mm_or_si128(_mm_andnot_si128(isInfOrNaN, normal), _mm_and_si128(isInfOrNaN, infOrNaN));
+			bits = _mm_or_si128(_mm_andnot_si128(isDenormal, bits), _mm_and_si128(isDenormal, denormal));
+			return _mm_castsi128_ps(_mm_or_si128(bits, sign));
+		}
+#endif
+
+		// Encodes count vertices. The SSE2 path works on four vertices at a time in component registers and writes
+		// the same bits as EncodeVertex.
+		inline void EncodeVertices(const Vertex* vertices, size_t count, PackedVertex* out) {
+			size_t i = 0;
+#if RCE_VERTEX_SSE2
+			const __m128 signBit = _mm_set1_ps(-0.0f);
+			const __m128 one = _mm_set1_ps(1.0f);
+			const __m128i positionW = _mm_set1_epi32(0x3c00 << 16); // half 1.0 in the upper 16 bits
+			for (; i + 4 <= count; i += 4) {
+				const Vertex* v = vertices + i;
+				__m128 px = _mm_setr_ps(v[0].position.x, v[1].position.x, v[2].position.x, v[3].position.x);
+				__m128 py = _mm_setr_ps(v[0].position.y, v[1].position.y, v[2].position.y, v[3].position.y);
+				__m128 pz = _mm_setr_ps(v[0].position.z, v[1].position.z, v[2].position.z, v[3].position.z);
+				__m128 tu = _mm_setr_ps(v[0].u, v[1].u, v[2].u, v[3].u);
+				__m128 tv = _mm_setr_ps(v[0].v, v[1].v, v[2].v, v[3].v);
+				__m128 nx = _mm_setr_ps(v[0].normals.x, v[1].normals.x, v[2].normals.x, v[3].normals.x);
+				__m128 ny = _mm_setr_ps(v[0].normals.y, v[1].normals.y, v[2].normals.y, v[3].normals.y);
+				__m128 nz = _mm_setr_ps(v[0].normals.z, v[1].normals.z, v[2].normals.z, v[3].normals.z);
+
+				// Octahedral encode, see OctahedralEncode
+				__m128 absX = _mm_andnot_ps(signBit, nx);
+				__m128 absY = _mm_andnot_ps(signBit, ny);
+				__m128 absZ = _mm_andnot_ps(signBit, nz);
+				__m128 invL1 = _mm_div_ps(one, _mm_add_ps(_mm_add_ps(absX, absY), absZ));
+				__m128 ox = _mm_mul_ps(nx, invL1);
+				__m128 oy = _mm_mul_ps(ny, invL1);
+				__m128 signX = _mm_or_ps(one, _mm_and_ps(signBit, ox));
+				__m128 signY = _mm_or_ps(one, _mm_and_ps(signBit, oy));
+				__m128 foldedX = _mm_mul_ps(_mm_sub_ps(one, _mm_andnot_ps(signBit, oy)), signX);
+				__m128 foldedY = _mm_mul_ps(_mm_sub_ps(one, _mm_andnot_ps(signBit, ox)), signY);
+				__m128 lowerHalf = _mm_cmplt_ps(nz, _mm_setzero_ps());
+				ox = _mm_or_ps(_mm_and_ps(lowerHalf, foldedX), _mm_andnot_ps(lowerHalf, ox));
+				oy = _mm_or_ps(_mm_and_ps(lowerHalf, foldedY), _mm_andnot_ps(lowerHalf, oy));
+
+				// One 32-bit word per lane and attribute pair, then a 4x4 transpose gives whole vertices
+				__m128 words[4] = {
+					_mm_castsi128_ps(Pack16Pairs(FloatToHalf4(px), FloatToHalf4(py))),
+					_mm_castsi128_ps(_mm_or_si128(FloatToHalf4(pz), positionW)),
+					_mm_castsi128_ps(Pack16Pairs(RoundScaled4(Clamp4(tu, 0.0f, 1.0f), 65535.0f),
+												 RoundScaled4(Clamp4(tv, 0.0f, 1.0f), 65535.0f))),
+					_mm_castsi128_ps(Pack16Pairs(RoundScaled4(Clamp4(ox, -1.0f, 1.0f), 32767.0f),
+												 RoundScaled4(Clamp4(oy, -1.0f, 1.0f), 32767.0f))),
+				};
+				_MM_TRANSPOSE4_PS(words[0], words[1], words[2], words[3]);
+				for (int j = 0; j < 4; j++) {
+					_mm_storeu_ps((float*)(out + i + j), words[j]);
+				}
+			}
+#endif
+			for (; i < count; i++) {
+				out[i] = EncodeVertex(vertices[i]);
+			}
+		}
+
+		// Decodes count vertices. The SSE2 path works on four vertices at a time like EncodeVertices and produces the same
+		// bits as DecodeVertex, unless SBL_MATH_FAST_MATH makes DecodeVertex normalize with the approximate inverse square
+		// root; the SSE2 path always normalizes precisely.
+		inline void DecodeVertices(const PackedVertex* packed, size_t count, Vertex* out) {
+			size_t i = 0;
+#if RCE_VERTEX_SSE2
+			static_assert(sizeof(Vertex) == 32, "DecodeVertices writes Vertex as eight floats");
+			const __m128 signBit = _mm_set1_ps(-0.0f);
+			const __m128 one = _mm_set1_ps(1.0f);
+			const __m128i low16 = _mm_set1_epi32(0xffff);
+			for (; i + 4 <= count; i += 4) {
+				// A 4x4 transpose gives one register per pair of 16-bit attributes, see EncodeVertices
+				__m128 words[4];
+				for (int j = 0; j < 4; j++) {
+					words[j] = _mm_loadu_ps((const float*)(packed + i + j));
+				}
+				_MM_TRANSPOSE4_PS(words[0], words[1], words[2], words[3]);
+				__m128i xy = _mm_castps_si128(words[0]);
+				__m128i zw = _mm_castps_si128(words[1]);
+				__m128i uv = _mm_castps_si128(words[2]);
+				__m128i oct = _mm_castps_si128(words[3]);
+
+				__m128 px = HalfToFloat4(_mm_and_si128(xy, low16));
+				__m128 py = HalfToFloat4(_mm_srli_epi32(xy, 16));
+				__m128 pz = HalfToFloat4(_mm_and_si128(zw, low16));
+				__m128 tu = _mm_div_ps(_mm_cvtepi32_ps(_mm_and_si128(uv, low16)), _mm_set1_ps(65535.0f));
+				__m128 tv = _mm_div_ps(_mm_cvtepi32_ps(_mm_srli_epi32(uv, 16)), _mm_set1_ps(65535.0f));
+				// -32768 clamps to -1 like the scalar path
+				__m128 ox = _mm_max_ps(_mm_div_ps(_mm_cvtepi32_ps(_mm_srai_epi32(_mm_slli_epi32(oct, 16), 16)),
+					_mm_set1_ps(32767.0f)), _mm_set1_ps(-1.0f));
+				__m128 oy = _mm_max_ps(_mm_div_ps(_mm_cvtepi32_ps(_mm_srai_epi32(oct, 16)), _mm_set1_ps(32767.0f)),
+					_mm_set1_ps(-1.0f));
+
+				// Octahedral decode, see OctahedralDecode
+				__m128 nz = _mm_sub_ps(_mm_sub_ps(one, _mm_andnot_ps(signBit, ox)), _mm_andnot_ps(signBit, oy));
+				__m128 t = _mm_max_ps(_mm_xor_ps(nz, signBit), _mm_setzero_ps());
+				__m128 negT = _mm_xor_ps(t, signBit);
+				__m128 xPositive = _mm_cmpge_ps(ox, _mm_setzero_ps());
+				__m128 yPositive = _mm_cmpge_ps(oy, _mm_setzero_ps());
+				__m128 nx = _mm_add_ps(ox, _mm_or_ps(_mm_and_ps(xPositive, negT), _mm_andnot_ps(xPositive, t)));
+				__m128 ny = _mm_add_ps(oy, _mm_or_ps(_mm_and_ps(yPositive, negT), _mm_andnot_ps(yPositive, t)));
+				__m128 length = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(nx, nx), _mm_mul_ps(ny, ny)), _mm_mul_ps(nz, nz)));
+				nx = _mm_div_ps(nx, length);
+				ny = _mm_div_ps(ny, length);
+				nz = _mm_div_ps(nz, length);
+
+				// Vertex is position, u, v, normal: two transposes give its first and second 16 bytes
+				_MM_TRANSPOSE4_PS(px, py, pz, tu);
+				_MM_TRANSPOSE4_PS(tv, nx, ny, nz);
+				float* dest = (float*)(out + i);
+				_mm_storeu_ps(dest + 0, px);
+				_mm_storeu_ps(dest + 4, tv);
+				_mm_storeu_ps(dest + 8, py);
+				_mm_storeu_ps(dest + 12, nx);
+				_mm_storeu_ps(dest + 16, pz);
+				_mm_storeu_ps(dest + 20, ny);
+				_mm_storeu_ps(dest + 24, tu);
+				_mm_storeu_ps(dest + 28, nz);
+			}
+#endif
+			for (; i < count; i++) {
+				out[i] = DecodeVertex(packed[i]);
+			}
+		}
+
+		inline bool FitsSixteenBitIndices(size_t vertexCount) {
+			return vertexCount <= 0x10000;
+		}
+
+		// Narrows indices that are known to be below 65536
+		inline void PackIndices16(const int* indices, size_t count, uint16_t* out) {
+			size_t i = 0;
+#if RCE_VERTEX_SSE2
+			// packs_epi32 saturates to signed 16 bits, so bias into that range and undo the bias afterwards
+			const __m128i bias = _mm_set1_epi32(0x8000);
+			const __m128i unbias = _mm_set1_epi16((short)0x8000);
+			for (; i + 8 <= count; i += 8) {
+				__m128i lo = _mm_sub_epi32(_mm_loadu_si128((const __m128i*)(indices + i)), bias);
+				__m128i hi = _mm_sub_epi32(_mm_loadu_si128((const __m128i*)(indices + i + 4)), bias);
+				_mm_storeu_si128((__m128i*)(out + i), _mm_xor_si128(_mm_packs_epi32(lo, hi), unbias));
+			}
+#endif
+			for (; i < count; i++) {
+				out[i] = (uint16_t)indices[i];
+			}
+		}
+	}
+}
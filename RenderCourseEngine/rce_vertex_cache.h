@@ -0,0 +1,170 @@
+#pragma once
+#include <math.h>
+#include <stddef.h>
+#include <vector>
+
+namespace RCE {
+	namespace VertexCache {
+		// Size of the FIFO used when reporting ACMR. Close to the post-transform cache of current desktop GPUs.
+		constexpr int ACMR_CACHE_SIZE = 16;
+
+		// Average cache miss ratio: vertices transformed per triangle with a FIFO post-transform cache.
+		// 3.0 means every vertex is shaded again, a regular grid can get close to 0.5.
+		inline float ComputeACMR(const int* indices, size_t indexCount, int vertexCount, int cacheSize = ACMR_CACHE_SIZE) {
+			if (indexCount < 3) {
+				return 0.0f;
+			}
+
+			// A vertex is in the cache if it was inserted less than cacheSize misses ago
+			std::vector<int> insertedAt(vertexCount, -cacheSize - 1);
+			int misses = 0;
+			for (size_t i = 0; i < indexCount; i++) {
+				int vert = indices[i];
+				if (misses - insertedAt[vert] > cacheSize) {
+					insertedAt[vert] = misses;
+					misses++;
+				}
+			}
+			return (float)misses / (float)(indexCount / 3);
+		}
+
+		// Tom Forsyth's "Linear-Speed Vertex Cache Optimisation". Greedily emits the triangle with the best score, where
+		// vertices score higher when they are recently used (simulated LRU cache) and when few of their triangles are left.
+		namespace Forsyth {
+			constexpr int CACHE_SIZE = 32;
+			constexpr float CACHE_DECAY_POWER = 1.5f;
+			constexpr float LAST_TRIANGLE_SCORE = 0.75f;
+			constexpr float VALENCE_BOOST_SCALE = 2.0f;
+			constexpr float VALENCE_BOOST_POWER = 0.5f;
+
+			inline float VertexScore(int cachePosition, int remainingTriangles) {
+				if (remainingTriangles == 0) {
+					return -1.0f;
+				}
+
+				float score = 0.0f;
+				if (cachePosition >= 0) {
+					if (cachePosition < 3) {
+						// The triangle just emitted, deliberately not the highest so strips don't double back
+						score = LAST_TRIANGLE_SCORE;
+					}
+					else {
+						float scaler = 1.0f - (cachePosition - 3) / (float)(CACHE_SIZE - 3);
+						score = powf(scaler, CACHE_DECAY_POWER);
+					}
+				}
+				return score + VALENCE_BOOST_SCALE * powf((float)remainingTriangles, -VALENCE_BOOST_POWER);
+			}
+		}
+
+		// Reorders the triangles of a triangle list for the post-transform cache. indices and out may not overlap.
+		inline void OptimizeVertexCache(const int* indices, size_t indexCount, int vertexCount, int* out) {
+			using namespace Forsyth;
+			const int triangleCount = (int)(indexCount / 3);
+
+			// Per vertex list of the triangles that still need to be emitted
+			std::vector<int> triangleOffset(vertexCount + 1, 0);
+			std::vector<int> remaining(vertexCount, 0);
+			for (size_t i = 0; i < indexCount; i++) {
+				remaining[indices[i]]++;
+			}
+			for (int v = 0; v < vertexCount; v++) {
+				triangleOffset[v + 1] = triangleOffset[v] + remaining[v];
+			}
+			std::vector<int> vertexTriangles(indexCount);
+			{
+				std::vector<int> fill(triangleOffset.begin(), triangleOffset.end() - 1);
+				for (int t = 0; t < triangleCount; t++) {
+					for (int k = 0; k < 3; k++) {
+						vertexTriangles[fill[indices[t * 3 + k]]++] = t;
+					}
+				}
+			}
+
+			std::vector<int> cachePosition(vertexCount, -1);
+			std::vector<float> vertexScore(vertexCount);
+			for (int v = 0; v < vertexCount; v++) {
+				vertexScore[v] = VertexScore(-1, remaining[v]);
+			}
+
+			std::vector<float> triangleScore(triangleCount);
+			std::vector<bool> emitted(triangleCount, false);
+			for (int t = 0; t < triangleCount; t++) {
+				triangleScore[t] = vertexScore[indices[t * 3]] + vertexScore[indices[t * 3 + 1]] + vertexScore[indices[t * 3 + 2]];
+			}
+
+			// The LRU cache can temporarily grow by the three vertices of the emitted triangle
+			int cache[CACHE_SIZE + 3];
+			int cacheCount = 0;
+
+			int bestTriangle = -1;
+			int scanCursor = 0;
+			for (int emittedCount = 0; emittedCount < triangleCount; emittedCount++) {
+				if (bestTriangle < 0) {
+					// Dead end, continue with the next triangle in input order
+					while (emitted[scanCursor]) {
+						scanCursor++;
+					}
+					bestTriangle = scanCursor;
+				}
+
+				const int* tri = indices + bestTriangle * 3;
+				out[emittedCount * 3 + 0] = tri[0];
+				out[emittedCount * 3 + 1] = tri[1];
+				out[emittedCount * 3 + 2] = tri[2];
+				emitted[bestTriangle] = true;
+
+				int newCache[CACHE_SIZE + 3];
+				int newCount = 0;
+				for (int k = 0; k < 3; k++) {
+					int v = tri[k];
+					// Remove the triangle from the vertex's remaining list
+					int begin = triangleOffset[v];
+					int end = begin + remaining[v];
+					for (int j = begin; j < end; j++) {
+						if (vertexTriangles[j] == bestTriangle) {
+							vertexTriangles[j] = vertexTriangles[end - 1];
+							break;
+						}
+					}
+					remaining[v]--;
+					newCache[newCount++] = v;
+				}
+				for (int c = 0; c < cacheCount; c++) {
+					int v = cache[c];
+					if (v != tri[0] && v != tri[1] && v != tri[2]) {
+						newCache[newCount++] = v;
+					}
+				}
+
+				// Rescore the cached vertices, anything past CACHE_SIZE falls out
+				for (int c = 0; c < newCount; c++) {
+					int v = newCache[c];
+					cachePosition[v] = c < CACHE_SIZE ? c : -1;
+					vertexScore[v] = VertexScore(cachePosition[v], remaining[v]);
+				}
+
+				bestTriangle = -1;
+				float bestScore = -1.0f;
+				for (int c = 0; c < newCount; c++) {
+					int v = newCache[c];
+					int begin = triangleOffset[v];
+					for (int j = begin; j < begin + remaining[v]; j++) {
+						int t = vertexTriangles[j];
+						const int* other = indices + t * 3;
+						triangleScore[t] = vertexScore[other[0]] + vertexScore[other[1]] + vertexScore[other[2]];
+						if (triangleScore[t] > bestScore) {
+							bestScore = triangleScore[t];
+							bestTriangle = t;
+						}
+					}
+				}
+
+				cacheCount = newCount < CACHE_SIZE ? newCount : CACHE_SIZE;
+				for (int c = 0; c < cacheCount; c++) {
+					cache[c] = newCache[c];
+				}
+			}
+		}
+	}
+}